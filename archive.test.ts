@@ -0,0 +1,184 @@
+import {
+	assertEquals,
+	assertInstanceOf,
+	assertStrictEquals,
+	assertThrows,
+} from '@std/assert';
+import {
+	archive,
+	type ArchiveClass,
+	KeyedUnarchiver,
+	unarchive,
+	type UnarchiveClass,
+} from './archive.ts';
+import { PLArray } from './array.ts';
+import { PLBoolean } from './boolean.ts';
+import { PLDate } from './date.ts';
+import { decode } from './decode/mod.ts';
+import { PLDictionary } from './dictionary.ts';
+import { encode } from './encode/mod.ts';
+import { FORMAT_BINARY_V1_0, FORMAT_XML_V1_0 } from './format.ts';
+import { PLInteger } from './integer.ts';
+import { PLNull } from './null.ts';
+import { equal } from './pri/hash.ts';
+import { PLReal } from './real.ts';
+import { PLSet } from './set.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+import { PLUID } from './uid.ts';
+
+const str = (s: string) => new PLString(s);
+
+Deno.test('archive: round trip', () => {
+	const shared = str('shared');
+	const root = new PLDictionary<PLType, PLType>([
+		[str('list'), new PLArray<PLType>([shared, shared, new PLInteger(1)])],
+		[str('set'), new PLSet([str('a')])],
+		[str('date'), new PLDate(1)],
+		[str('bool'), new PLBoolean(true)],
+		[str('real'), new PLReal(1.5)],
+		[str('null'), new PLNull()],
+	]);
+	const archived = archive({ root });
+	const objects = archived.find((_, k) => k.value === '$objects') as PLArray;
+	assertEquals(objects.get(0)?.valueOf(), '$null');
+	for (const format of [FORMAT_BINARY_V1_0, FORMAT_XML_V1_0]) {
+		const { plist } = decode(encode(archived, { format }));
+		const r = unarchive(plist) as PLDictionary;
+		assertInstanceOf(r, PLDictionary);
+		assertEquals(equal(r, root, new WeakMap()), true, format);
+		const list = r.find((_, k) => `${k}` === 'list') as PLArray;
+		assertStrictEquals(list.get(0), list.get(1));
+	}
+});
+
+Deno.test('archive: cycles', () => {
+	const a = new PLArray<PLType>();
+	const b = new PLArray<PLType>([a]);
+	a.push(b, a);
+	const r = unarchive(archive({ root: a })) as PLArray;
+	const x = r.get(0) as PLArray;
+	assertStrictEquals(x.get(0), r);
+	assertStrictEquals(r.get(1), r);
+});
+
+Deno.test('archive: deep', () => {
+	let root = new PLArray<PLType>();
+	for (let i = 0; i < 100000; i++) {
+		root = new PLArray<PLType>([root]);
+	}
+	let r = unarchive(archive({ root })) as PLArray;
+	let depth = 0;
+	for (; r.length; depth++) {
+		r = r.get(0) as PLArray;
+	}
+	assertEquals(depth, 100000);
+});
+
+Deno.test('archive: wide', () => {
+	const item = str('a');
+	const root = new PLArray<PLType>(new Array(300000).fill(item));
+	const r = unarchive(archive({ root })) as PLArray;
+	assertEquals(r.length, 300000);
+	assertEquals(r.get(299999)?.valueOf(), 'a');
+});
+
+Deno.test('archive: classes', () => {
+	class Point {
+		public x: number;
+		public y: number;
+		public next?: Point;
+
+		constructor(x: number, y: number, next?: Point) {
+			this.x = x;
+			this.y = y;
+			this.next = next;
+		}
+	}
+	const point: ArchiveClass<Point> = {
+		classes: ['Point', 'NSObject'],
+		is: (v) => v instanceof Point,
+		encode: (v, ref) => [
+			['x', new PLReal(v.x)],
+			['y', new PLReal(v.y)],
+			['next', ref(v.next)],
+		],
+	};
+	const unpoint: UnarchiveClass<Point> = {
+		create: (f) => new Point(Number(f.get('x')), Number(f.get('y'))),
+		init(v, f, resolve) {
+			v.next = (resolve(f.get('next')) ?? undefined) as Point | undefined;
+		},
+	};
+	const a = new Point(1, 2);
+	const b = new Point(3, 4, a);
+	a.next = b;
+	const archived = archive({ root: a }, { classes: [point] });
+	const r = unarchive(archived, { classes: { Point: unpoint } }) as Point;
+	assertInstanceOf(r, Point);
+	assertEquals([r.x, r.y, r.next!.x, r.next!.y], [1, 2, 3, 4]);
+	assertStrictEquals(r.next!.next, r);
+
+	const u = unarchive(archived) as PLDictionary;
+	assertEquals(
+		[...u.toValueMap().keys()].sort(),
+		['$class', 'next', 'x', 'y'],
+	);
+	assertEquals(`${u.toValueMap().get('$class')}`, 'Point');
+
+	const sub = archive({ root: a }, {
+		classes: [{ ...point, classes: ['SubPoint', 'Point', 'NSObject'] }],
+	});
+	const s = unarchive(sub, { classes: { Point: unpoint } });
+	assertInstanceOf(s, Point);
+});
+
+Deno.test('archive: CF$UID', () => {
+	const archived = archive({ root: new PLArray([str('a')]) });
+	const text = new TextDecoder().decode(
+		encode(archived, { format: FORMAT_XML_V1_0 }),
+	);
+	assertEquals(text.includes('CF$UID'), true);
+
+	const { plist } = decode(
+		new TextEncoder().encode(`{
+			$top = { root = { CF$UID = 1; }; };
+			$objects = (
+				$null,
+				{
+					NS.objects = ({ CF$UID = 3; }, { CF$UID = 0; });
+					$class = { CF$UID = 2; };
+				},
+				{ $classname = NSArray; },
+				a
+			);
+		}`),
+	);
+	const u = new KeyedUnarchiver(plist);
+	assertEquals(u.size, 4);
+	assertEquals(u.keys(), ['root']);
+	assertEquals(u.decode('none'), undefined);
+	assertEquals(u.resolve(0), null);
+	assertEquals(u.resolve(new PLUID(3n)), str('a'));
+	const r = u.decode() as PLArray;
+	assertEquals(r.length, 2);
+	assertEquals(`${r.get(0)}`, 'a');
+	assertInstanceOf(r.get(1), PLNull);
+});
+
+Deno.test('archive: invalid', () => {
+	assertThrows(() => new KeyedUnarchiver(str('')), TypeError, 'Invalid');
+	const u = new KeyedUnarchiver(archive({ root: str('a') }));
+	assertThrows(
+		() => u.resolve(9),
+		TypeError,
+		'Invalid archive reference: 9',
+	);
+	for (const root of [new PLUID(1n), 'x', 5]) {
+		assertThrows(
+			() => archive({ root }),
+			TypeError,
+			'Invalid archive value',
+		);
+	}
+});
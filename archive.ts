@@ -0,0 +1,623 @@
+/**
+ * @module
+ *
+ * Keyed archive resolving and archiving.
+ */
+
+import { PLArray, PLTYPE_ARRAY } from './array.ts';
+import { PLTYPE_BOOLEAN } from './boolean.ts';
+import { type PLData, PLTYPE_DATA } from './data.ts';
+import { PLDate } from './date.ts';
+import { PLDictionary, PLTYPE_DICTIONARY } from './dictionary.ts';
+import { PLInteger, PLTYPE_INTEGER } from './integer.ts';
+import { PLNull } from './null.ts';
+import { arrays } from './pri/array.ts';
+import { PLReal, PLTYPE_REAL } from './real.ts';
+import { PLSet } from './set.ts';
+import { PLString, PLTYPE_STRING } from './string.ts';
+import type { PLType } from './type.ts';
+import { PLTYPE_UID, PLUID } from './uid.ts';
+
+/**
+ * Archive object fields, by key.
+ */
+export type ArchiveFields = ReadonlyMap<string, PLType>;
+
+/**
+ * Resolve references in field value, including arrays of references.
+ * Other values are returned unchanged.
+ *
+ * @param value Field value.
+ * @returns Resolved value, null for nil.
+ */
+export type ArchiveResolve = (value: PLType | undefined) => unknown;
+
+/**
+ * Unarchiving class, created before initialized so cycles resolve.
+ *
+ * @template T Value type.
+ */
+export interface UnarchiveClass<T = unknown> {
+	/**
+	 * Create value, without resolving references that may cycle.
+	 *
+	 * @param fields Object fields.
+	 * @param resolve Resolve references.
+	 * @returns Value.
+	 */
+	create(fields: ArchiveFields, resolve: ArchiveResolve): T;
+
+	/**
+	 * Initialize created value, resolving references.
+	 * Referenced values are created, but may not yet be initialized.
+	 *
+	 * @param value Created value.
+	 * @param fields Object fields.
+	 * @param resolve Resolve references.
+	 */
+	init?(value: T, fields: ArchiveFields, resolve: ArchiveResolve): void;
+}
+
+/**
+ * Archiving class.
+ *
+ * @template T Value type.
+ */
+export interface ArchiveClass<T = unknown> {
+	/**
+	 * Class names, most derived first.
+	 */
+	readonly classes: readonly string[];
+
+	/**
+	 * Check if value is archived as this class.
+	 *
+	 * @param value Value.
+	 * @returns Is this class.
+	 */
+	is(value: unknown): value is T;
+
+	/**
+	 * Encode value fields.
+	 *
+	 * @param value Value.
+	 * @param ref Get reference to value, archiving it once.
+	 * @returns Object fields.
+	 */
+	encode(
+		value: T,
+		ref: (value: unknown) => PLUID,
+	): Iterable<readonly [string, PLType]>;
+}
+
+/**
+ * Keyed unarchiver options.
+ */
+export interface KeyedUnarchiverOptions {
+	/**
+	 * Unarchiving classes by class name, before the defaults.
+	 * An object uses the first class found in its class chain.
+	 */
+	classes?: { readonly [className: string]: UnarchiveClass };
+}
+
+/**
+ * Keyed archive options.
+ */
+export interface KeyedArchiveOptions {
+	/**
+	 * Archiving classes, checked before the defaults.
+	 */
+	classes?: readonly ArchiveClass[];
+}
+
+/**
+ * Unarchiver state.
+ */
+interface State {
+	/**
+	 * Archived objects.
+	 */
+	o: PLType[];
+
+	/**
+	 * Resolved values.
+	 */
+	m: unknown[];
+
+	/**
+	 * Resolved flags.
+	 */
+	f: Uint8Array;
+
+	/**
+	 * Top references.
+	 */
+	t: ArchiveFields;
+
+	/**
+	 * Unarchiving classes.
+	 */
+	c: { readonly [className: string]: UnarchiveClass };
+
+	/**
+	 * Pending initializations.
+	 */
+	q: (() => void)[] | null;
+
+	/**
+	 * Resolve function.
+	 */
+	r: ArchiveResolve;
+}
+
+const states = new WeakMap<KeyedUnarchiver, State>();
+
+/**
+ * Archiver name.
+ */
+const ARCHIVER = 'NSKeyedArchiver';
+
+/**
+ * Archive version.
+ */
+const VERSION = 100000;
+
+/**
+ * Get string keyed fields of dictionary.
+ *
+ * @param d Dictionary.
+ * @returns Fields.
+ */
+const fields = (d: PLDictionary): ArchiveFields =>
+	d.toValueMap() as Map<string, PLType>;
+
+/**
+ * Get reference index, from UID or CF$UID dictionary.
+ * OpenStep has only strings, so CF$UID may be a decimal string.
+ *
+ * @param v Plist object.
+ * @returns Index or -1.
+ */
+function index(v: PLType): number {
+	switch (v[Symbol.toStringTag]) {
+		case PLTYPE_UID: {
+			return Number((v as PLUID).value);
+		}
+		case PLTYPE_DICTIONARY: {
+			if ((v as PLDictionary).size === 1) {
+				const [[k, x]] = v as PLDictionary;
+				if (
+					k[Symbol.toStringTag] === PLTYPE_STRING &&
+					(k as PLString).value === 'CF$UID'
+				) {
+					switch (x[Symbol.toStringTag]) {
+						case PLTYPE_INTEGER: {
+							return Number((x as PLInteger).value);
+						}
+						case PLTYPE_STRING: {
+							if (/^\d+$/.test((x as PLString).value)) {
+								return +(x as PLString).value;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	return -1;
+}
+
+/**
+ * Find unarchiving class for class dictionary.
+ *
+ * @param c Unarchiving classes.
+ * @param v Class dictionary.
+ * @returns Unarchiving class.
+ */
+function lookup(
+	c: { readonly [className: string]: UnarchiveClass },
+	v: PLType | undefined,
+): UnarchiveClass {
+	const f = v && PLDictionary.is(v) ? fields(v) : null;
+	const a = f?.get('$classes');
+	for (
+		const n of PLArray.is(a) ? arrays.get(a)! : [f?.get('$classname')]
+	) {
+		if (n && Object.hasOwn(c, `${n}`)) {
+			return c[`${n}`];
+		}
+	}
+	return unarchiveObject;
+}
+
+/**
+ * Resolved value in a plist collection, nil as PLNull.
+ *
+ * @param v Value.
+ * @returns Plist object.
+ */
+const item = (v: unknown): PLType => (v ?? new PLNull()) as PLType;
+
+/**
+ * Resolve array of references.
+ *
+ * @param resolve Resolve references.
+ * @param v Field value.
+ * @returns Resolved values.
+ */
+const items = (resolve: ArchiveResolve, v: PLType | undefined): PLType[] =>
+	v?.[Symbol.toStringTag] === PLTYPE_ARRAY
+		? (resolve(v) as PLArray).toArray()
+		: [];
+
+/**
+ * Array unarchiving.
+ */
+const unarchiveArray: UnarchiveClass<PLArray> = {
+	create: () => new PLArray(),
+	init(value, f, resolve): void {
+		for (const v of items(resolve, f.get('NS.objects'))) {
+			value.push(v);
+		}
+	},
+};
+
+/**
+ * Set unarchiving.
+ */
+const unarchiveSet: UnarchiveClass<PLSet> = {
+	create: () => new PLSet(),
+	init(value, f, resolve): void {
+		for (const v of items(resolve, f.get('NS.objects'))) {
+			value.add(v);
+		}
+	},
+};
+
+/**
+ * Dictionary unarchiving.
+ */
+const unarchiveDictionary: UnarchiveClass<PLDictionary> = {
+	create: () => new PLDictionary(),
+	init(value, f, resolve): void {
+		const k = items(resolve, f.get('NS.keys'));
+		const v = items(resolve, f.get('NS.objects'));
+		for (let i = 0, l = Math.min(k.length, v.length); i < l; i++) {
+			value.set(k[i], v[i]);
+		}
+	},
+};
+
+/**
+ * Value unarchiving, for wrapped primitives.
+ *
+ * @param key Value key.
+ * @returns Unarchiving class.
+ */
+const unarchiveValue = (key: string): UnarchiveClass => ({
+	create: (f, resolve) => resolve(f.get(key)) ?? null,
+});
+
+/**
+ * Default unarchiving classes.
+ */
+const UNARCHIVE: { readonly [className: string]: UnarchiveClass } = {
+	NSArray: unarchiveArray,
+	NSMutableArray: unarchiveArray,
+	NSSet: unarchiveSet,
+	NSMutableSet: unarchiveSet,
+	NSDictionary: unarchiveDictionary,
+	NSMutableDictionary: unarchiveDictionary,
+	NSString: unarchiveValue('NS.string'),
+	NSMutableString: unarchiveValue('NS.string'),
+	NSData: unarchiveValue('NS.data'),
+	NSMutableData: unarchiveValue('NS.data'),
+	NSDate: {
+		create: (f) => {
+			const t = f.get('NS.time');
+			return new PLDate(t ? Number(t.valueOf()) : 0);
+		},
+	},
+};
+
+/**
+ * Object unarchiving, for unknown classes.
+ * Resolves into a dictionary, with $class as the class name.
+ */
+const unarchiveObject: UnarchiveClass<PLDictionary> = {
+	create: () => new PLDictionary(),
+	init(value, f, resolve): void {
+		for (const [k, v] of f) {
+			const r = resolve(v);
+			if (k === '$class') {
+				const c = PLDictionary.is(r) && fields(r).get('$classname');
+				if (c) {
+					value.set(new PLString(k), c);
+				}
+			} else if (r !== null) {
+				value.set(new PLString(k), r as PLType);
+			}
+		}
+	},
+};
+
+/**
+ * Keyed archive unarchiver, resolving objects lazily and once each.
+ * Resolving is iterative, so deep graphs do not exhaust the stack.
+ * References may be UIDs, or CF$UID dictionaries as decoded from OpenStep.
+ */
+export class KeyedUnarchiver {
+	/**
+	 * Create keyed unarchiver.
+	 *
+	 * @param archive Keyed archive plist.
+	 * @param options Unarchiver options.
+	 */
+	constructor(
+		archive: PLType,
+		options: Readonly<KeyedUnarchiverOptions> = {},
+	) {
+		const a = PLDictionary.is(archive) ? fields(archive) : null;
+		const o = a?.get('$objects');
+		const t = a?.get('$top');
+		if (!PLArray.is(o) || !PLDictionary.is(t)) {
+			throw new TypeError('Invalid archive');
+		}
+		const objects = arrays.get(o)!;
+		const s: State = {
+			o: objects,
+			m: [],
+			f: new Uint8Array(objects.length),
+			t: fields(t),
+			c: { ...UNARCHIVE, ...options.classes },
+			q: null,
+			r: (v) => {
+				if (!v) {
+					return v;
+				}
+				const i = index(v);
+				if (i >= 0) {
+					return this.resolve(i);
+				}
+				if (v[Symbol.toStringTag] === PLTYPE_ARRAY) {
+					return new PLArray(
+						arrays.get(v as PLArray)!.map((v) => item(s.r(v))),
+					);
+				}
+				return v;
+			},
+		};
+		states.set(this, s);
+	}
+
+	/**
+	 * Get number of archived objects.
+	 *
+	 * @returns Object count.
+	 */
+	public get size(): number {
+		return states.get(this)!.o.length;
+	}
+
+	/**
+	 * Get top keys.
+	 *
+	 * @returns Top keys.
+	 */
+	public keys(): string[] {
+		return [...states.get(this)!.t.keys()];
+	}
+
+	/**
+	 * Decode top value.
+	 *
+	 * @param key Top key.
+	 * @returns Resolved value, null for nil, undefined if no key.
+	 */
+	public decode(key = 'root'): unknown {
+		const s = states.get(this)!;
+		const v = s.t.get(key);
+		return v ? s.r(v) : undefined;
+	}
+
+	/**
+	 * Resolve object by index, once.
+	 *
+	 * @param ref Object index or reference.
+	 * @returns Resolved value, null for nil.
+	 */
+	public resolve(ref: number | PLUID): unknown {
+		const s = states.get(this)!;
+		const { o, m, f } = s;
+		const i = typeof ref === 'number' ? ref : Number(ref.value);
+		if (f[i]) {
+			return m[i];
+		}
+		const v = o[i];
+		if (!v) {
+			throw new TypeError(`Invalid archive reference: ${i}`);
+		}
+		let r: unknown = v;
+		if (v[Symbol.toStringTag] === PLTYPE_DICTIONARY) {
+			const d = fields(v as PLDictionary);
+			const x = d.get('$class');
+			const c = x ? index(x) : -1;
+			if (c >= 0) {
+				const u = lookup(s.c, o[c]);
+				r = u.create(d, s.r);
+				f[i] = 1;
+				m[i] = r;
+				if (u.init) {
+					const q = s.q;
+					const init = () => u.init!(r, d, s.r);
+					if (q) {
+						q.push(init);
+					} else {
+						const q = s.q = [init];
+						try {
+							for (let j = 0; j < q.length; j++) {
+								q[j]();
+							}
+						} finally {
+							s.q = null;
+						}
+					}
+				}
+				return r;
+			}
+		} else if (
+			!i &&
+			v[Symbol.toStringTag] === PLTYPE_STRING &&
+			(v as PLString).value === '$null'
+		) {
+			r = null;
+		}
+		f[i] = 1;
+		return m[i] = r;
+	}
+}
+
+/**
+ * Unarchive root value of keyed archive.
+ *
+ * @param archive Keyed archive plist.
+ * @param options Unarchiver options.
+ * @returns Resolved value.
+ */
+export function unarchive(
+	archive: PLType,
+	options?: Readonly<KeyedUnarchiverOptions>,
+): unknown {
+	return new KeyedUnarchiver(archive, options).decode();
+}
+
+/**
+ * Default archiving classes.
+ */
+const ARCHIVE: readonly ArchiveClass[] = [
+	{
+		classes: ['NSMutableArray', 'NSArray', 'NSObject'],
+		is: PLArray.is,
+		encode: (v: PLArray, ref) => [
+			['NS.objects', new PLArray(v.toArray().map(ref))],
+		],
+	} as ArchiveClass<PLArray>,
+	{
+		classes: ['NSMutableDictionary', 'NSDictionary', 'NSObject'],
+		is: PLDictionary.is,
+		encode: (v: PLDictionary, ref) => {
+			const k: PLUID[] = [];
+			const o: PLUID[] = [];
+			for (const [x, y] of v) {
+				k.push(ref(x));
+				o.push(ref(y));
+			}
+			return [
+				['NS.keys', new PLArray(k)],
+				['NS.objects', new PLArray(o)],
+			];
+		},
+	} as ArchiveClass<PLDictionary>,
+	{
+		classes: ['NSMutableSet', 'NSSet', 'NSObject'],
+		is: PLSet.is,
+		encode: (v: PLSet, ref) => [
+			['NS.objects', new PLArray([...v].map(ref))],
+		],
+	} as ArchiveClass<PLSet>,
+	{
+		classes: ['NSDate', 'NSObject'],
+		is: PLDate.is,
+		encode: (v: PLDate) => [['NS.time', new PLReal(v.time)]],
+	} as ArchiveClass<PLDate>,
+];
+
+/**
+ * Create keyed archive, archiving each object once, cycles included.
+ * PLString, PLInteger, PLReal, PLBoolean, and PLData are archived directly,
+ * null, undefined, and PLNull as nil.
+ *
+ * @param top Top values by key, usually only root.
+ * @param options Archive options.
+ * @returns Keyed archive plist.
+ */
+export function archive(
+	top: { readonly [key: string]: unknown },
+	options: Readonly<KeyedArchiveOptions> = {},
+): PLDictionary<PLString, PLType> {
+	const classes = [...options.classes ?? [], ...ARCHIVE];
+	const o: PLType[] = [new PLString('$null')];
+	const m = new Map<unknown, number>();
+	const n = new Map<string, number>();
+	const q: (() => void)[] = [];
+	const ref = (v: unknown): PLUID => {
+		let i = m.get(v);
+		if (i === undefined) {
+			if (v === null || v === undefined || PLNull.is(v)) {
+				return new PLUID(0n);
+			}
+			const c = classes.find((c) => c.is(v));
+			m.set(v, i = o.length);
+			if (c) {
+				const d = new PLDictionary<PLString, PLType>();
+				o.push(d);
+				q.push(() => {
+					for (const [k, x] of c.encode(v, ref)) {
+						d.set(new PLString(k), x);
+					}
+					const k = c.classes.join();
+					let j = n.get(k);
+					if (j === undefined) {
+						n.set(k, j = o.length);
+						o.push(
+							new PLDictionary<PLString, PLType>([
+								[
+									new PLString('$classes'),
+									new PLArray(
+										c.classes.map((s) => new PLString(s)),
+									),
+								],
+								[
+									new PLString('$classname'),
+									new PLString(c.classes[0]),
+								],
+							]),
+						);
+					}
+					d.set(new PLString('$class'), new PLUID(BigInt(j)));
+				});
+			} else {
+				switch ((v as PLType | null)?.[Symbol.toStringTag]) {
+					case PLTYPE_STRING:
+					case PLTYPE_INTEGER:
+					case PLTYPE_REAL:
+					case PLTYPE_BOOLEAN:
+					case PLTYPE_DATA: {
+						o.push(v as PLString | PLInteger | PLReal | PLData);
+						break;
+					}
+					default: {
+						m.delete(v);
+						throw new TypeError('Invalid archive value');
+					}
+				}
+			}
+		}
+		return new PLUID(BigInt(i));
+	};
+	const t = new PLDictionary<PLString, PLType>();
+	for (const k of Object.keys(top)) {
+		t.set(new PLString(k), ref(top[k]));
+		for (let i = 0; i < q.length; i++) {
+			q[i]();
+		}
+		q.length = 0;
+	}
+	return new PLDictionary<PLString, PLType>([
+		[new PLString('$version'), new PLInteger(VERSION)],
+		[new PLString('$archiver'), new PLString(ARCHIVER)],
+		[new PLString('$top'), t],
+		[new PLString('$objects'), new PLArray(o)],
+	]);
+}
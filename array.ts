@@ -4,10 +4,10 @@
  * Property list array.
  */
 
+import { arrays } from './pri/array.ts';
+import { mutable } from './pri/mutate.ts';
 import type { PLType } from './type.ts';
 
-const arrays = new WeakMap<PLArray, Array<PLType>>();
-
 /**
  * PLArray type.
  */
@@ -61,6 +61,7 @@ export class PLArray<T extends PLType = PLType> {
 	 * @param value Value to set.
 	 */
 	public set(index: number, value: T): void {
+		mutable(this);
 		(arrays.get(this) as T[])[(+index || 0) - (index % 1 || 0)] = value;
 	}
 
@@ -81,6 +82,7 @@ export class PLArray<T extends PLType = PLType> {
 	 * @returns New length.
 	 */
 	public push(...values: T[]): number {
+		mutable(this);
 		return (arrays.get(this) as T[]).push(...values);
 	}
 
@@ -90,6 +92,7 @@ export class PLArray<T extends PLType = PLType> {
 	 * @returns Popped value or undefined.
 	 */
 	public pop(): T | undefined {
+		mutable(this);
 		return (arrays.get(this) as T[]).pop();
 	}
 
@@ -100,6 +103,7 @@ export class PLArray<T extends PLType = PLType> {
 	 * @returns New length.
 	 */
 	public unshift(...values: T[]): number {
+		mutable(this);
 		return (arrays.get(this) as T[]).unshift(...values);
 	}
 
@@ -109,6 +113,7 @@ export class PLArray<T extends PLType = PLType> {
 	 * @returns Shifted value or undefined.
 	 */
 	public shift(): T | undefined {
+		mutable(this);
 		return (arrays.get(this) as T[]).shift();
 	}
 
@@ -132,6 +137,7 @@ export class PLArray<T extends PLType = PLType> {
 	 * @returns Removed values.
 	 */
 	public splice(start: number, deleteCount = 0, ...items: T[]): T[] {
+		mutable(this);
 		return (arrays.get(this) as T[]).splice(start, deleteCount, ...items);
 	}
 
@@ -139,6 +145,7 @@ export class PLArray<T extends PLType = PLType> {
 	 * Reverse array.
 	 */
 	public reverse(): void {
+		mutable(this);
 		(arrays.get(this) as T[]).reverse();
 	}
 
@@ -244,6 +251,7 @@ export class PLArray<T extends PLType = PLType> {
 	 * @param end End index.
 	 */
 	public fill(value: T, start?: number, end?: number): void {
+		mutable(this);
 		(arrays.get(this) as T[]).fill(value, start, end);
 	}
 
@@ -255,6 +263,7 @@ export class PLArray<T extends PLType = PLType> {
 	 * @param end End index.
 	 */
 	public copyWithin(target: number, start: number, end?: number): void {
+		mutable(this);
 		(arrays.get(this) as T[]).copyWithin(target, start, end);
 	}
 
@@ -262,6 +271,7 @@ export class PLArray<T extends PLType = PLType> {
 	 * Clear array.
 	 */
 	public clear(): void {
+		mutable(this);
 		(arrays.get(this) as T[]).length = 0;
 	}
 
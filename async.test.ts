@@ -0,0 +1,200 @@
+import {
+	assertEquals,
+	assertGreater,
+	assertRejects,
+	assertStrictEquals,
+} from '@std/assert';
+import { PLArray } from './array.ts';
+import { decodeAsync } from './decode/mod.ts';
+import { PLDictionary } from './dictionary.ts';
+import { encode, encodeAsync } from './encode/mod.ts';
+import {
+	type Format,
+	FORMAT_BINARY_V1_0,
+	FORMAT_OPENSTEP,
+	FORMAT_XML_V1_0,
+} from './format.ts';
+import { PLInteger } from './integer.ts';
+import { equal } from './pri/hash.ts';
+import { parents } from './pri/mutate.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+
+const FORMATS: Format[] = [
+	FORMAT_BINARY_V1_0,
+	FORMAT_XML_V1_0,
+	FORMAT_OPENSTEP,
+];
+
+function tree(n: number): PLType {
+	return new PLArray(
+		Array.from({ length: n }, (_, i) =>
+			new PLDictionary<PLType, PLType>([
+				[new PLString('name'), new PLString(`item ${i}`)],
+				[new PLString('list'), new PLArray([new PLString(`${i}`)])],
+			])),
+	);
+}
+
+Deno.test('async: round trip', async () => {
+	const plist = tree(1000);
+	for (const format of FORMATS) {
+		let calls = 0;
+		// deno-lint-ignore no-await-in-loop
+		const encoded = await encodeAsync(plist, {
+			format,
+			step: 64,
+			progress() {
+				calls++;
+			},
+		});
+		assertEquals(encoded, encode(plist, { format }), format);
+		assertGreater(calls, 0, format);
+
+		let last = 0;
+		// deno-lint-ignore no-await-in-loop
+		const decoded = await decodeAsync(encoded, {
+			step: 64,
+			slice: 0,
+			progress(processed) {
+				assertGreater(processed, last, format);
+				last = processed;
+			},
+		});
+		assertEquals(decoded.format, format);
+		assertEquals(equal(decoded.plist, plist, new WeakMap()), true, format);
+		assertGreater(last, 0, format);
+	}
+});
+
+Deno.test('async: fallback', async () => {
+	const { format, plist } = await decodeAsync(
+		new TextEncoder().encode('{a = 1;}'),
+	);
+	assertEquals(format, FORMAT_OPENSTEP);
+	assertEquals(
+		equal(
+			plist,
+			new PLDictionary([[new PLString('a'), new PLString('1')]]),
+			new WeakMap(),
+		),
+		true,
+	);
+	await assertRejects(
+		() => decodeAsync(new TextEncoder().encode('<plist>')),
+		SyntaxError,
+	);
+});
+
+Deno.test('async: yields', async () => {
+	const plist = tree(10000);
+	for (const format of FORMATS) {
+		let ticks = 0;
+		const timer = setInterval(() => ticks++, 0);
+		try {
+			// deno-lint-ignore no-await-in-loop
+			const encoded = await encodeAsync(plist, { format, slice: 0 });
+			ticks = 0;
+			// deno-lint-ignore no-await-in-loop
+			await decodeAsync(encoded, { step: 16, slice: 0 });
+			assertGreater(ticks, 0, format);
+		} finally {
+			clearInterval(timer);
+		}
+	}
+});
+
+Deno.test('async: abort', async () => {
+	const plist = tree(1000);
+	const reason = new Error('Abort');
+	const signal = AbortSignal.abort(reason);
+	for (const format of FORMATS) {
+		const encoded = encode(plist, { format });
+		// deno-lint-ignore no-await-in-loop
+		await assertRejects(() => encodeAsync(plist, { format, signal }));
+		// deno-lint-ignore no-await-in-loop
+		await assertRejects(() => decodeAsync(encoded, { signal }));
+
+		const c = new AbortController();
+		let err;
+		try {
+			// deno-lint-ignore no-await-in-loop
+			await decodeAsync(encoded, {
+				step: 16,
+				progress() {
+					c.abort(reason);
+				},
+				signal: c.signal,
+			});
+		} catch (e) {
+			err = e;
+		}
+		assertStrictEquals(err, reason, format);
+	}
+});
+
+Deno.test('async: changed while encoding', async () => {
+	const changes: [number, (s: PLString[], p: PLArray<PLString>) => void][] = [
+		[250, (s) => s[s.length - 1].value = 'longer value'],
+		[250, (s) => s[s.length - 1].value = 'same'],
+		[10, (s, p) => p.set(0, new PLString(s[0].value))],
+		[250, (s, p) => p.push(new PLString(s[0].value))],
+	];
+	for (const format of FORMATS) {
+		for (const [call, change] of changes) {
+			const strings = Array.from(
+				{ length: 20000 },
+				(_, i) => new PLString(`${i}`),
+			);
+			const plist = new PLArray(strings);
+			let calls = 0;
+			// deno-lint-ignore no-await-in-loop
+			await assertRejects(
+				() =>
+					encodeAsync(plist, {
+						format,
+						step: 100,
+						progress() {
+							if (++calls === call) {
+								change(strings, plist);
+							}
+						},
+					}),
+				TypeError,
+				'Plist changed while encoding',
+			);
+			assertEquals(calls, call, format);
+			// deno-lint-ignore no-await-in-loop
+			const encoded = await encodeAsync(plist, { format, step: 100 });
+			assertEquals(encoded, encode(plist, { format }), format);
+			assertEquals(parents.has(plist), false, format);
+			assertEquals(parents.has(strings[1]), false, format);
+		}
+	}
+});
+
+Deno.test('async: options', async () => {
+	const plist = new PLInteger(1);
+	const format = FORMAT_BINARY_V1_0;
+	for (const step of [0, -1, NaN]) {
+		// deno-lint-ignore no-await-in-loop
+		await assertRejects(
+			() => encodeAsync(plist, { format, step }),
+			RangeError,
+			'Invalid step',
+		);
+	}
+	for (const slice of [-1, NaN]) {
+		// deno-lint-ignore no-await-in-loop
+		await assertRejects(
+			() => encodeAsync(plist, { format, slice }),
+			RangeError,
+			'Invalid slice',
+		);
+	}
+	await assertRejects(
+		() => encodeAsync(plist, { format: 'x' as Format }),
+		RangeError,
+		'Invalid format',
+	);
+});
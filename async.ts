@@ -0,0 +1,37 @@
+/**
+ * @module
+ *
+ * Async options.
+ */
+
+/**
+ * Async options, for decoding and encoding without blocking the event loop.
+ * Plists must not be modified while encoding, between yields, as encoders
+ * size then write them, and throw a TypeError if any object changed.
+ */
+export interface AsyncOptions {
+	/**
+	 * Optional signal to abort with.
+	 */
+	signal?: AbortSignal;
+
+	/**
+	 * Optional progress callback, called every step.
+	 * Passed bytes decoded for XML and OpenStep, objects processed otherwise.
+	 */
+	progress?: (processed: number) => void;
+
+	/**
+	 * Objects to process between checking the time, signal, and progress.
+	 *
+	 * @default 1024
+	 */
+	step?: number;
+
+	/**
+	 * Milliseconds to work before yielding to the event loop.
+	 *
+	 * @default 10
+	 */
+	slice?: number;
+}
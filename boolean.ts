@@ -4,6 +4,7 @@
  * Property list boolean.
  */
 
+import { mutable } from './pri/mutate.ts';
 import type { PLType } from './type.ts';
 
 const values = new WeakMap<PLBoolean, boolean>();
@@ -48,6 +49,7 @@ export class PLBoolean {
 	 * @param value Boolean value.
 	 */
 	public set value(value: boolean) {
+		mutable(this);
 		values.set(this, !!value);
 	}
 
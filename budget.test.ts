@@ -0,0 +1,180 @@
+import {
+	assertEquals,
+	assertNotInstanceOf,
+	assertThrows,
+} from '@std/assert';
+import { PLArray } from './array.ts';
+import { BudgetError } from './budget.ts';
+import { decode, decodeAsync, validate } from './decode/mod.ts';
+import { decodeBinary } from './decode/binary.ts';
+import { decodeOpenStep } from './decode/openstep.ts';
+import { decodeXml } from './decode/xml.ts';
+import { PLDictionary } from './dictionary.ts';
+import { encode } from './encode/mod.ts';
+import {
+	type Format,
+	FORMAT_BINARY_V1_0,
+	FORMAT_OPENSTEP,
+	FORMAT_XML_V1_0,
+} from './format.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+
+const FORMATS: Format[] = [
+	FORMAT_BINARY_V1_0,
+	FORMAT_XML_V1_0,
+	FORMAT_OPENSTEP,
+];
+
+const str = (s: string) => new PLString(s);
+
+function tree(): PLType {
+	return new PLDictionary<PLType, PLType>([
+		[str('a'), new PLArray([str('one'), str('two'), str('three')])],
+		[str('b'), new PLDictionary([[str('c'), new PLArray([str('d')])]])],
+	]);
+}
+
+Deno.test('budget: limits', () => {
+	const plist = tree();
+	const budgets = {
+		maxDepth: 3,
+		maxObjects: 11,
+		maxBytes: 15,
+		maxLength: 3,
+	};
+	for (const format of FORMATS) {
+		const encoded = encode(plist, { format });
+		assertEquals(decode(encoded, budgets).format, format);
+		assertEquals(validate(encoded, budgets), {
+			format,
+			objects: 11,
+			depth: 3,
+		});
+		for (const [k, v] of Object.entries(budgets)) {
+			assertThrows(
+				() => decode(encoded, { [k]: v - 1 }),
+				BudgetError,
+				`Exceeded ${k} `,
+				`${format}: ${k}`,
+			);
+			assertThrows(
+				() => validate(encoded, { [k]: v - 1 }),
+				BudgetError,
+				`Exceeded ${k} `,
+				`${format}: ${k}`,
+			);
+		}
+	}
+});
+
+Deno.test('budget: location', () => {
+	const plist = new PLArray([new PLArray([new PLArray()])]);
+	assertThrows(
+		() => decodeBinary(encode(plist, { format: FORMAT_BINARY_V1_0 }), {
+			maxDepth: 2,
+		}),
+		BudgetError,
+		'Exceeded maxDepth at 0xC',
+	);
+	assertThrows(
+		() => decodeXml(encode(plist, { format: FORMAT_XML_V1_0 }), {
+			maxDepth: 2,
+		}),
+		BudgetError,
+		'Exceeded maxDepth on line 6',
+	);
+	assertThrows(
+		() => decodeOpenStep(encode(plist, { format: FORMAT_OPENSTEP }), {
+			maxDepth: 2,
+		}),
+		BudgetError,
+		'Exceeded maxDepth on line 3',
+	);
+});
+
+Deno.test('budget: shared', () => {
+	const s = str('x'.repeat(1000));
+	const encoded = encode(new PLArray(Array(100).fill(s)), {
+		format: FORMAT_BINARY_V1_0,
+	});
+	const { plist } = decode(encoded, { maxBytes: 1000, maxObjects: 2 });
+	assertEquals((plist as PLArray).length, 100);
+});
+
+Deno.test('budget: strings', () => {
+	const encoded = new TextEncoder().encode('a = "bc"; d;');
+	assertEquals(validate(encoded, { maxObjects: 4, maxBytes: 4 }).depth, 1);
+	assertThrows(
+		() => decode(encoded, { maxObjects: 3 }),
+		BudgetError,
+		'Exceeded maxObjects on line 1',
+	);
+	assertThrows(
+		() => decode(encoded, { maxBytes: 3 }),
+		BudgetError,
+		'Exceeded maxBytes on line 1',
+	);
+	assertThrows(
+		() => decode(encoded, { maxLength: 1 }),
+		BudgetError,
+		'Exceeded maxLength on line 1',
+	);
+	assertThrows(
+		() => decodeOpenStep(new Uint8Array(), { maxDepth: 0 }),
+		BudgetError,
+		'Exceeded maxDepth on line 1',
+	);
+});
+
+Deno.test('budget: per format', () => {
+	const encoded = encode(tree(), { format: FORMAT_XML_V1_0 });
+	assertEquals(
+		decode(encoded, { maxDepth: 1, xml: { maxDepth: 3 } }).format,
+		FORMAT_XML_V1_0,
+	);
+	assertThrows(
+		() => decode(encoded, { maxDepth: 3, xml: { maxDepth: 2 } }),
+		BudgetError,
+		'Exceeded maxDepth',
+	);
+});
+
+Deno.test('budget: options', () => {
+	const encoded = encode(tree(), { format: FORMAT_BINARY_V1_0 });
+	for (const k of ['maxDepth', 'maxObjects', 'maxBytes', 'maxLength']) {
+		for (const v of [-1, NaN]) {
+			assertThrows(
+				() => decodeBinary(encoded, { [k]: v }),
+				RangeError,
+				`Invalid ${k}`,
+			);
+		}
+	}
+});
+
+Deno.test('budget: not budget errors', async () => {
+	const encoded = encode(tree(), { format: FORMAT_BINARY_V1_0 });
+	assertNotInstanceOf(
+		assertThrows(() => decodeBinary(encoded, { maxDepth: -1 }), RangeError),
+		BudgetError,
+	);
+
+	// Only exceeding a budget skips the OpenStep fallback.
+	const openstep = encode(tree(), { format: FORMAT_OPENSTEP });
+	for (const f of [decode, validate]) {
+		assertEquals(
+			f(openstep, { xml: { maxDepth: -1 } }).format,
+			FORMAT_OPENSTEP,
+		);
+	}
+	assertEquals(
+		(await decodeAsync(openstep, { xml: { maxDepth: -1 } })).format,
+		FORMAT_OPENSTEP,
+	);
+	assertThrows(
+		() => decode(openstep, { xml: { maxDepth: -1 }, maxDepth: 2 }),
+		BudgetError,
+		'Exceeded maxDepth on line ',
+	);
+});
@@ -0,0 +1,56 @@
+/**
+ * @module
+ *
+ * Budget options.
+ */
+
+/**
+ * Budget exceeded error, a RangeError thrown at the offending location.
+ * Other RangeErrors, like invalid options, are not budget errors.
+ */
+export class BudgetError extends RangeError {
+	/**
+	 * Create budget exceeded error.
+	 *
+	 * @param message Error message.
+	 */
+	constructor(message: string) {
+		super(message);
+		this.name = 'BudgetError';
+	}
+}
+
+/**
+ * Budget options, for decoding untrusted input with bounded resources.
+ * Exceeding a budget throws a BudgetError at the offending location.
+ * Shared objects count once, as they are only decoded once.
+ */
+export interface BudgetOptions {
+	/**
+	 * Optional maximum depth of nested collections.
+	 *
+	 * @default Infinity
+	 */
+	maxDepth?: number;
+
+	/**
+	 * Optional maximum number of objects, counting keys.
+	 *
+	 * @default Infinity
+	 */
+	maxObjects?: number;
+
+	/**
+	 * Optional maximum total encoded bytes of strings and data.
+	 *
+	 * @default Infinity
+	 */
+	maxBytes?: number;
+
+	/**
+	 * Optional maximum number of entries in any one collection.
+	 *
+	 * @default Infinity
+	 */
+	maxLength?: number;
+}
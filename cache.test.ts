@@ -0,0 +1,166 @@
+import { assertEquals, assertStrictEquals, assertThrows } from '@std/assert';
+import { PLArray } from './array.ts';
+import { PlistCache } from './cache.ts';
+import { PLData } from './data.ts';
+import { PLDictionary } from './dictionary.ts';
+import { encode } from './encode/mod.ts';
+import {
+	type Format,
+	FORMAT_BINARY_V1_0,
+	FORMAT_OPENSTEP,
+	FORMAT_XML_V1_0,
+} from './format.ts';
+import { isFrozen } from './freeze.ts';
+import { equal } from './pri/hash.ts';
+import { retainedSize } from './retained.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+
+const FORMATS: Format[] = [
+	FORMAT_BINARY_V1_0,
+	FORMAT_XML_V1_0,
+	FORMAT_OPENSTEP,
+];
+
+function tree(name: string): PLType {
+	const shared = new PLString('shared');
+	return new PLDictionary<PLType, PLType>([
+		[new PLString('name'), new PLString(name)],
+		[new PLString('list'), new PLArray([shared, shared])],
+		[new PLString('data'), new PLData(new Uint8Array([1, 2, 3]).buffer)],
+	]);
+}
+
+Deno.test('PlistCache: hits', () => {
+	for (const format of FORMATS) {
+		const cache = new PlistCache();
+		const encoded = encode(tree('a'), { format });
+		const a = cache.decode(encoded);
+		const b = cache.decode(encoded.slice());
+		assertEquals(a.format, format);
+		assertEquals(b.format, format);
+		assertStrictEquals(a.plist, b.plist);
+		assertEquals(equal(a.plist, b.plist, new WeakMap()), true);
+		assertEquals(equal(a.plist, tree('a'), new WeakMap()), true);
+		assertEquals(cache.stats(), {
+			entries: 1,
+			bytes: encoded.length + retainedSize(a.plist),
+			hits: 1,
+			misses: 1,
+			hitRate: 0.5,
+		});
+	}
+});
+
+Deno.test('PlistCache: frozen', () => {
+	for (const format of FORMATS) {
+		const cache = new PlistCache();
+		const encoded = encode(tree('a'), { format });
+		const original = encoded.slice();
+		const a = cache.decode(encoded).plist as PLDictionary;
+		encoded.fill(0);
+		assertEquals(isFrozen(a), true, format);
+		assertThrows(() => a.set(new PLString('name'), new PLString('b')));
+		for (const [k, v] of a) {
+			if ((k as PLString).value === 'data') {
+				new Uint8Array((v as PLData).buffer).fill(0);
+			}
+		}
+		const b = cache.decode(original).plist;
+		assertStrictEquals(b, a, format);
+		assertEquals(equal(b, tree('a'), new WeakMap()), true, format);
+		assertEquals(cache.stats().hits, 1, format);
+	}
+	const cache = new PlistCache({ maxBytes: 0 });
+	const encoded = encode(tree('a'), { format: FORMAT_BINARY_V1_0 });
+	assertEquals(isFrozen(cache.decode(encoded).plist), false);
+});
+
+Deno.test('PlistCache: alignment', () => {
+	const cache = new PlistCache();
+	const encoded = encode(tree('a'), { format: FORMAT_XML_V1_0 });
+	for (let i = 0; i < 8; i++) {
+		const d = new Uint8Array(encoded.length + i);
+		d.set(encoded, i);
+		cache.decode(d.subarray(i));
+	}
+	assertEquals(cache.stats().hits, 7);
+});
+
+Deno.test('PlistCache: evict', () => {
+	const encoded = ['a', 'b', 'c'].map((s) =>
+		encode(tree(s), { format: FORMAT_BINARY_V1_0 })
+	);
+	const size = encoded[0].length +
+		retainedSize(new PlistCache().decode(encoded[0]).plist);
+	{
+		const cache = new PlistCache({ maxEntries: 2 });
+		cache.decode(encoded[0]);
+		cache.decode(encoded[1]);
+		cache.decode(encoded[0]);
+		cache.decode(encoded[2]);
+		assertEquals(cache.stats().entries, 2);
+		cache.decode(encoded[0]);
+		cache.decode(encoded[1]);
+		assertEquals(cache.stats().hits, 2);
+	}
+	{
+		const cache = new PlistCache({ maxBytes: size * 2 + 1 });
+		for (const e of [...encoded, ...encoded]) {
+			cache.decode(e);
+		}
+		assertEquals(cache.stats(), {
+			entries: 2,
+			bytes: size * 2,
+			hits: 0,
+			misses: 6,
+			hitRate: 0,
+		});
+		cache.clear();
+		assertEquals(cache.stats().entries, 0);
+		assertEquals(cache.stats().bytes, 0);
+	}
+	{
+		const cache = new PlistCache({ maxBytes: size - 1 });
+		cache.decode(encoded[0]);
+		assertEquals(isFrozen(cache.decode(encoded[0]).plist), true);
+		assertEquals(cache.stats().entries, 0);
+		assertEquals(cache.stats().bytes, 0);
+		assertEquals(cache.stats().misses, 2);
+	}
+});
+
+Deno.test('PlistCache: bytes lazy', () => {
+	const cache = new PlistCache({ decode: { xml: { lazy: true } } });
+	const encoded = encode(tree('a'), { format: FORMAT_XML_V1_0 });
+	const { plist } = cache.decode(encoded);
+
+	// Lazy data counts the encoded copy, only the buffer header is not.
+	assertEquals(cache.stats().bytes, retainedSize(plist) - 88);
+
+	// Lazy data references the private copy.
+	assertEquals(
+		retainedSize(plist, [encoded.buffer]),
+		retainedSize(plist),
+	);
+});
+
+Deno.test('PlistCache: errors', () => {
+	const cache = new PlistCache({ decode: { maxDepth: 0 } });
+	const encoded = encode(tree('a'), { format: FORMAT_XML_V1_0 });
+	for (let i = 0; i < 2; i++) {
+		assertThrows(() => cache.decode(encoded), RangeError);
+	}
+	assertEquals(cache.stats().entries, 0);
+	assertEquals(cache.stats().misses, 2);
+	assertThrows(
+		() => new PlistCache({ maxBytes: -1 }),
+		RangeError,
+		'Invalid maxBytes',
+	);
+	assertThrows(
+		() => new PlistCache({ maxEntries: NaN }),
+		RangeError,
+		'Invalid maxEntries',
+	);
+});
@@ -0,0 +1,281 @@
+/**
+ * @module
+ *
+ * Decoded property list cache.
+ */
+
+import {
+	decode,
+	type DecodeOptions,
+	type DecodeResult,
+} from './decode/mod.ts';
+import type { Format } from './format.ts';
+import { freeze } from './freeze.ts';
+import { bytes } from './pri/data.ts';
+import { digest } from './pri/hash.ts';
+import { retainedSize } from './retained.ts';
+import type { PLType } from './type.ts';
+
+/**
+ * Cache entry.
+ */
+interface Entry {
+	/**
+	 * Encoded copy.
+	 */
+	d: Uint8Array;
+
+	/**
+	 * Encoded format.
+	 */
+	f: Format;
+
+	/**
+	 * Decoded plist, frozen.
+	 */
+	p: PLType;
+
+	/**
+	 * Bytes retained, encoded copy and decoded plist.
+	 */
+	s: number;
+}
+
+/**
+ * Cache state.
+ */
+interface State {
+	/**
+	 * Entries by hash, least recently used first.
+	 */
+	m: Map<number, Entry>;
+
+	/**
+	 * Decoding options.
+	 */
+	o: DecodeOptions;
+
+	/**
+	 * Maximum bytes.
+	 */
+	b: number;
+
+	/**
+	 * Maximum entries.
+	 */
+	n: number;
+
+	/**
+	 * Bytes held.
+	 */
+	u: number;
+
+	/**
+	 * Hits.
+	 */
+	h: number;
+
+	/**
+	 * Misses.
+	 */
+	x: number;
+}
+
+const states = new WeakMap<PlistCache, State>();
+
+/**
+ * Check if bytes are the same, 4 at a time when aligned.
+ *
+ * @param a Bytes.
+ * @param b Bytes.
+ * @returns Is same.
+ */
+function same(a: Uint8Array, b: Uint8Array): boolean {
+	const l = a.length;
+	if (l !== b.length) {
+		return false;
+	}
+	let i = 0;
+	if (!((a.byteOffset | b.byteOffset) & 3)) {
+		const x = new Int32Array(a.buffer, a.byteOffset, l >> 2);
+		const y = new Int32Array(b.buffer, b.byteOffset, l >> 2);
+		for (let n = x.length; i < n; i++) {
+			if (x[i] !== y[i]) {
+				return false;
+			}
+		}
+		i <<= 2;
+	}
+	for (; i < l; i++) {
+		if (a[i] !== b[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Plist cache options.
+ */
+export interface PlistCacheOptions {
+	/**
+	 * Maximum total bytes retained by cached plists.
+	 * Each counts its encoded copy and the estimated retained size of the
+	 * decoded plist, see retainedSize.
+	 * Larger plists are decoded but not cached.
+	 *
+	 * @default 67108864
+	 */
+	maxBytes?: number;
+
+	/**
+	 * Maximum number of cached plists.
+	 *
+	 * @default Infinity
+	 */
+	maxEntries?: number;
+
+	/**
+	 * Decoding options.
+	 */
+	decode?: DecodeOptions;
+}
+
+/**
+ * Plist cache stats.
+ */
+export interface PlistCacheStats {
+	/**
+	 * Number of cached plists.
+	 */
+	entries: number;
+
+	/**
+	 * Total bytes retained by cached plists, encoded copies and estimated
+	 * retained size of decoded plists.
+	 */
+	bytes: number;
+
+	/**
+	 * Number of decodes returned from the cache.
+	 */
+	hits: number;
+
+	/**
+	 * Number of decodes not returned from the cache.
+	 */
+	misses: number;
+
+	/**
+	 * Hits over all decodes, or 0 if none.
+	 */
+	hitRate: number;
+}
+
+/**
+ * Cache of decoded plists, by encoded content, least recently used evicted.
+ * Hits cost one hash and one compare of the encoded data.
+ * Cached plists are frozen and shared, so callers cannot modify them.
+ */
+export class PlistCache {
+	/**
+	 * Create plist cache.
+	 *
+	 * @param options Cache options.
+	 */
+	constructor(options: Readonly<PlistCacheOptions> = {}) {
+		const {
+			maxBytes = 0x4000000,
+			maxEntries = Infinity,
+		} = options;
+		if (!(maxBytes >= 0)) {
+			throw new RangeError('Invalid maxBytes');
+		}
+		if (!(maxEntries >= 0)) {
+			throw new RangeError('Invalid maxEntries');
+		}
+		states.set(this, {
+			m: new Map(),
+			o: options.decode ?? {},
+			b: maxBytes,
+			n: maxEntries,
+			u: 0,
+			h: 0,
+			x: 0,
+		});
+	}
+
+	/**
+	 * Decode plist, from the cache if the same encoded data was cached.
+	 * Cached plists are frozen, plists encoded larger than maxBytes are not.
+	 * Plists that only exceed maxBytes once decoded are frozen but not cached.
+	 * Errors are not cached.
+	 *
+	 * @param encoded Encoded plist.
+	 * @returns Decoded plist and format.
+	 */
+	public decode(encoded: ArrayBufferView | ArrayBufferLike): DecodeResult {
+		const c = states.get(this)!;
+		const { m } = c;
+		let d = bytes(encoded);
+		const h = digest(d);
+		let e = m.get(h);
+		if (e && same(e.d, d)) {
+			c.h++;
+			m.delete(h);
+			m.set(h, e);
+			return { format: e.f, plist: e.p };
+		}
+		c.x++;
+		const l = d.length;
+		if (l > c.b || !c.n) {
+			return decode(d, c.o);
+		}
+
+		// Decode a private copy, that lazy data may reference.
+		const { format, plist } = decode(d = d.slice(), c.o);
+		freeze(plist);
+		if (e) {
+			m.delete(h);
+			c.u -= e.s;
+		}
+
+		// Lazy data may already count the copy.
+		const s = l + retainedSize(plist, [d.buffer]);
+		if (s > c.b) {
+			return { format, plist };
+		}
+		m.set(h, { d, f: format, p: plist, s });
+		for (c.u += s; c.u > c.b || m.size > c.n;) {
+			const [k, o] = m.entries().next().value!;
+			m.delete(k);
+			c.u -= o.s;
+		}
+		return { format, plist };
+	}
+
+	/**
+	 * Get cache stats.
+	 *
+	 * @returns Cache stats.
+	 */
+	public stats(): PlistCacheStats {
+		const { m, u, h, x } = states.get(this)!;
+		return {
+			entries: m.size,
+			bytes: u,
+			hits: h,
+			misses: x,
+			hitRate: h ? h / (h + x) : 0,
+		};
+	}
+
+	/**
+	 * Remove all cached plists, keeping stats.
+	 */
+	public clear(): void {
+		const c = states.get(this)!;
+		c.m.clear();
+		c.u = 0;
+	}
+}
@@ -0,0 +1,69 @@
+import { decodeCompressed, encodeCompressed } from './compress.ts';
+import { decode } from './decode/mod.ts';
+import { encode } from './encode/mod.ts';
+import { FORMAT_BINARY_V1_0 } from './format.ts';
+import { benchPlists } from './spec/bench.ts';
+
+const format = FORMAT_BINARY_V1_0;
+
+// Buffer everything, the compressed and decompressed data as chunks.
+async function buffered(
+	data: Uint8Array<ArrayBuffer>,
+	transform: CompressionStream | DecompressionStream,
+): Promise<Uint8Array> {
+	return new Uint8Array(
+		await new Response(new Blob([data]).stream().pipeThrough(transform))
+			.arrayBuffer(),
+	);
+}
+
+async function drain(stream: ReadableStream<Uint8Array>): Promise<void> {
+	for (const reader = stream.getReader(); !(await reader.read()).done;) {
+		// Consume chunk.
+	}
+}
+
+for (const [name, plist] of benchPlists()) {
+	let compressed: Promise<Uint8Array> | null = null;
+	const gzipped = (): Promise<Uint8Array> =>
+		compressed ??= buffered(
+			encode(plist, { format }),
+			new CompressionStream('gzip'),
+		);
+
+	Deno.bench(
+		`decodeCompressed: ${name}`,
+		{ group: `compressed: decode: ${name}`, baseline: true },
+		async () => {
+			await decodeCompressed(await gzipped());
+		},
+	);
+
+	Deno.bench(
+		`decompress then decode: ${name}`,
+		{ group: `compressed: decode: ${name}` },
+		async () => {
+			const d = await gzipped() as Uint8Array<ArrayBuffer>;
+			decode(await buffered(d, new DecompressionStream('gzip')));
+		},
+	);
+
+	Deno.bench(
+		`encodeCompressed: ${name}`,
+		{ group: `compressed: encode: ${name}`, baseline: true },
+		async () => {
+			await drain(encodeCompressed(plist, { format }));
+		},
+	);
+
+	Deno.bench(
+		`encode then compress: ${name}`,
+		{ group: `compressed: encode: ${name}` },
+		async () => {
+			await buffered(
+				encode(plist, { format }),
+				new CompressionStream('gzip'),
+			);
+		},
+	);
+}
@@ -0,0 +1,130 @@
+import { assertEquals, assertRejects, assertThrows } from '@std/assert';
+import { PLArray } from './array.ts';
+import { BudgetError } from './budget.ts';
+import {
+	decodeCompressed,
+	encodeCompressed,
+	type EncodeCompressedOptions,
+} from './compress.ts';
+import { PLDictionary } from './dictionary.ts';
+import { encode } from './encode/mod.ts';
+import { deepEqual } from './fingerprint.ts';
+import {
+	type Format,
+	FORMAT_BINARY_V1_0,
+	FORMAT_OPENSTEP,
+	FORMAT_XML_V1_0,
+} from './format.ts';
+import { PLInteger } from './integer.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+
+const FORMATS: Format[] = [
+	FORMAT_BINARY_V1_0,
+	FORMAT_XML_V1_0,
+	FORMAT_OPENSTEP,
+];
+
+function tree(n: number): PLType {
+	const list = new PLArray<PLType>();
+	for (let i = 0; i < n; i++) {
+		list.push(
+			new PLDictionary<PLType, PLType>([
+				[new PLString('name'), new PLString(`item ${i}`)],
+				[new PLString('index'), new PLString(`${i}`)],
+			]),
+		);
+	}
+	return list;
+}
+
+async function read(stream: ReadableStream<Uint8Array>): Promise<Uint8Array> {
+	return new Uint8Array(await new Response(stream).arrayBuffer());
+}
+
+Deno.test('encodeCompressed and decodeCompressed', async () => {
+	const plist = tree(1000);
+	for (const format of FORMATS) {
+		for (const compression of ['gzip', 'deflate', 'deflate-raw'] as const) {
+			const options = { format, compression, chunk: 1000 };
+			const compressed = await read(encodeCompressed(plist, options));
+			const encoded = encode(plist, { format });
+			assertEquals(compressed.length < encoded.length, true);
+			const inflated = await read(
+				new Blob([compressed]).stream().pipeThrough(
+					new DecompressionStream(compression),
+				),
+			);
+			assertEquals(inflated, encoded);
+			for (
+				const input of [compressed, new Blob([compressed]).stream()]
+			) {
+				const r = await decodeCompressed(input, { compression });
+				assertEquals(r.format, format);
+				assertEquals(
+					deepEqual(r.plist, plist, { ordered: true }),
+					true,
+				);
+			}
+		}
+	}
+});
+
+Deno.test('decodeCompressed: maxDecompressed', async () => {
+	const plist = tree(100);
+	const format = FORMAT_XML_V1_0;
+	const size = encode(plist, { format }).length;
+	const compressed = await read(encodeCompressed(plist, { format }));
+	await assertRejects(
+		() => decodeCompressed(compressed, { maxDecompressed: size - 1 }),
+		BudgetError,
+		'Exceeded maxDecompressed',
+	);
+	const r = await decodeCompressed(compressed, { maxDecompressed: size });
+	assertEquals(r.format, format);
+});
+
+Deno.test('decodeCompressed: gzip size', async () => {
+	const format = FORMAT_BINARY_V1_0;
+	const compressed = await read(
+		encodeCompressed(new PLInteger(42), { format }),
+	);
+	assertEquals((await decodeCompressed(compressed)).plist.valueOf(), 42n);
+	const large = new PLString('a'.repeat(0x100000));
+	const r = await decodeCompressed(
+		await read(encodeCompressed(large, { format })),
+	);
+	assertEquals(r.plist.valueOf(), large.value);
+	for (const size of [0, 1, 0xffffffff]) {
+		const d = compressed.slice();
+		new DataView(d.buffer).setUint32(d.length - 4, size, true);
+		await assertRejects(() => decodeCompressed(d));
+	}
+});
+
+Deno.test('decodeCompressed: signal', async () => {
+	const compressed = await read(
+		encodeCompressed(tree(10), { format: FORMAT_BINARY_V1_0 }),
+	);
+	const controller = new AbortController();
+	controller.abort();
+	await assertRejects(() =>
+		decodeCompressed(new Blob([compressed]).stream(), {
+			signal: controller.signal,
+		})
+	);
+});
+
+Deno.test('encodeCompressed: invalid chunk', () => {
+	for (const chunk of [0, -1, NaN]) {
+		assertThrows(
+			() =>
+				encodeCompressed(new PLString(), {
+					format: FORMAT_BINARY_V1_0,
+					chunk,
+				} as EncodeCompressedOptions),
+			RangeError,
+			'Invalid chunk',
+		);
+	}
+});
@@ -0,0 +1,185 @@
+/**
+ * @module
+ *
+ * Compressed property list streams.
+ */
+
+import type { AsyncOptions } from './async.ts';
+import { BudgetError } from './budget.ts';
+import {
+	decodeAsync,
+	type DecodeOptions,
+	type DecodeResult,
+} from './decode/mod.ts';
+import { encodeAsync, type EncodeOptions } from './encode/mod.ts';
+import { bytes } from './pri/data.ts';
+import type { PLType } from './type.ts';
+
+/**
+ * Compression options.
+ */
+export interface CompressOptions {
+	/**
+	 * Compression format.
+	 *
+	 * @default 'gzip'
+	 */
+	compression?: CompressionFormat;
+}
+
+/**
+ * Decompressing decode options.
+ */
+export interface DecodeCompressedOptions
+	extends DecodeOptions, AsyncOptions, CompressOptions {
+	/**
+	 * Optional maximum decompressed bytes, for untrusted input.
+	 *
+	 * @default Infinity
+	 */
+	maxDecompressed?: number;
+}
+
+/**
+ * Compressing encode options.
+ */
+export type EncodeCompressedOptions =
+	& EncodeOptions
+	& AsyncOptions
+	& CompressOptions
+	& {
+		/**
+		 * Bytes of the encoded plist to pass to the compressor at a time.
+		 *
+		 * @default 65536
+		 */
+		chunk?: number;
+	};
+
+/**
+ * Stream bytes as a single chunk, without copying.
+ *
+ * @param data Bytes.
+ * @returns Readable stream.
+ */
+function stream(data: Uint8Array): ReadableStream<Uint8Array> {
+	return new ReadableStream({
+		start(c): void {
+			c.enqueue(data);
+			c.close();
+		},
+	});
+}
+
+/**
+ * Decompress into one buffer, grown as needed.
+ *
+ * @param input Compressed stream.
+ * @param size Expected decompressed size, or 0 if unknown.
+ * @param options Decompressing options.
+ * @returns Decompressed bytes.
+ */
+async function inflate(
+	input: ReadableStream<Uint8Array>,
+	size: number,
+	{
+		compression = 'gzip',
+		maxDecompressed = Infinity,
+		signal,
+	}: Readonly<DecodeCompressedOptions>,
+): Promise<Uint8Array<ArrayBuffer>> {
+	const reader = input.pipeThrough(
+		new DecompressionStream(compression),
+		{ signal },
+	).getReader();
+	let r = new Uint8Array(Math.min(size || 0x10000, maxDecompressed));
+	let l = 0;
+	for (let c; !(c = await reader.read()).done;) {
+		const n = l + c.value.length;
+		if (n > maxDecompressed) {
+			await reader.cancel();
+			throw new BudgetError('Exceeded maxDecompressed');
+		}
+		if (n > r.length) {
+			const b = new Uint8Array(Math.max(n, r.length * 2));
+			b.set(r.subarray(0, l));
+			r = b;
+		}
+		r.set(c.value, l);
+		l = n;
+	}
+	return r.subarray(0, l);
+}
+
+/**
+ * Decode compressed plist, decompressing into one buffer without first
+ * holding the compressed and decompressed data as chunks.
+ * Compressed bytes in gzip format preallocate the decompressed size, up to a
+ * few times the compressed size.
+ *
+ * @param compressed Compressed plist, as bytes or a stream.
+ * @param options Decompressing, decoding, and async options.
+ * @returns Decoded plist and format.
+ */
+export async function decodeCompressed(
+	compressed:
+		| ReadableStream<Uint8Array>
+		| ArrayBufferView
+		| ArrayBufferLike,
+	options: Readonly<DecodeCompressedOptions> = {},
+): Promise<DecodeResult> {
+	let size = 0;
+	let input;
+	if (compressed instanceof ReadableStream) {
+		input = compressed;
+	} else {
+		const d = bytes(compressed);
+		const l = d.length;
+		// Gzip trailer has the decompressed size, modulo 2^32, but is untrusted
+		// until decompressed, so only preallocate a few times the input, and
+		// grow past that as decompressed.
+		if ((options.compression ?? 'gzip') === 'gzip' && l >= 18) {
+			size = Math.min(
+				new DataView(d.buffer, d.byteOffset).getUint32(l - 4, true),
+				l * 8,
+				0x1000000,
+			);
+		}
+		input = stream(d);
+	}
+	return await decodeAsync(await inflate(input, size, options), options);
+}
+
+/**
+ * Encode plist into a compressed stream, compressing the encoded plist a
+ * chunk at a time as the stream is read.
+ * The plist is encoded whole when first read, so the encoded plist is held
+ * until compressed, as much as encoding then compressing in memory.
+ * Only the compressed output is streamed, not held whole.
+ *
+ * @param plist Plist object.
+ * @param options Compressing, encoding, and async options.
+ * @returns Compressed stream.
+ */
+export function encodeCompressed(
+	plist: PLType,
+	options: Readonly<EncodeCompressedOptions>,
+): ReadableStream<Uint8Array> {
+	const { compression = 'gzip', chunk = 0x10000 } = options;
+	if (!(chunk >= 1)) {
+		throw new RangeError('Invalid chunk');
+	}
+	let encoded: Uint8Array<ArrayBuffer> | null = null;
+	let i = 0;
+	return new ReadableStream<Uint8Array<ArrayBuffer>>({
+		async pull(c): Promise<void> {
+			encoded ??= await encodeAsync(plist, options);
+			if (i < encoded.length) {
+				c.enqueue(encoded.subarray(i, i += chunk));
+			} else {
+				encoded = null;
+				c.close();
+			}
+		},
+	}, { highWaterMark: 0 }).pipeThrough(new CompressionStream(compression));
+}
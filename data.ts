@@ -4,12 +4,24 @@
  * Property list data.
  */
 
+import { buffers, dataBuffer, lazies } from './pri/data.ts';
+import { frozen } from './pri/mutate.ts';
 import type { PLType } from './type.ts';
 
-const buffers = new WeakMap<PLData, ArrayBufferLike>();
 const offsets = new WeakMap<PLData, number | undefined>();
 const lengths = new WeakMap<PLData, number | undefined>();
 
+/**
+ * Get buffer, copied if frozen.
+ *
+ * @param data Data.
+ * @returns Data buffer.
+ */
+function copy<T extends ArrayBufferLike>(data: PLData<T>): T {
+	const b = dataBuffer(data) as T;
+	return frozen.has(data) ? b.slice(0) as T : b;
+}
+
 /**
  * PLData type.
  */
@@ -46,12 +58,12 @@ export class PLData<T extends ArrayBufferLike = ArrayBufferLike> {
 	}
 
 	/**
-	 * Get buffer.
+	 * Get buffer, a copy on each access if frozen.
 	 *
 	 * @returns Data buffer.
 	 */
 	public get buffer(): T {
-		return buffers.get(this) as T;
+		return copy(this);
 	}
 
 	/**
@@ -60,6 +72,10 @@ export class PLData<T extends ArrayBufferLike = ArrayBufferLike> {
 	 * @returns Byte length.
 	 */
 	public get byteLength(): number {
+		const lazy = lazies.get(this);
+		if (lazy) {
+			return lazy.s;
+		}
 		const limit = Math.max(
 			buffers.get(this)!.byteLength - Math.max(offsets.get(this) || 0, 0),
 			0,
@@ -83,7 +99,7 @@ export class PLData<T extends ArrayBufferLike = ArrayBufferLike> {
 	 * @returns Buffer value.
 	 */
 	public valueOf(): T {
-		return buffers.get(this) as T;
+		return copy(this);
 	}
 
 	/**
@@ -94,7 +110,7 @@ export class PLData<T extends ArrayBufferLike = ArrayBufferLike> {
 	public toString(): string {
 		let r = '';
 		for (
-			let a = new Uint8Array(buffers.get(this)!), i = 0, l = a.length;
+			let a = new Uint8Array(dataBuffer(this)), i = 0, l = a.length;
 			l--;
 		) {
 			r += String.fromCharCode(a[i++]);
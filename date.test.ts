@@ -363,6 +363,49 @@ Deno.test('date to time', () => {
 	}
 });
 
+Deno.test('fields + times', () => {
+	const times = sampleISO.map(([, time]) => time);
+	const fields = PLDate.fields(times);
+	assertEquals(fields.length, times.length * 6);
+	for (const [i, time] of times.entries()) {
+		const tag = `${time}`;
+		const date = new PLDate(time);
+		const j = i * 6;
+		assertEquals(fields[j], date.year, tag);
+		assertEquals(fields[j + 1], date.month, tag);
+		assertEquals(fields[j + 2], date.day, tag);
+		assertEquals(fields[j + 3], date.hour, tag);
+		assertEquals(fields[j + 4], date.minute, tag);
+		assertEquals(fields[j + 5], date.second, tag);
+	}
+	const parsed = PLDate.times(fields.subarray(0, 40 * 6));
+	assertEquals(parsed.length, 40);
+	for (const [i, time] of parsed.entries()) {
+		assertAlmostEquals(time, times[i] || 0, 0.000001, `${times[i]}`);
+	}
+	const out = new Float64Array(3);
+	assertStrictEquals(PLDate.times(fields.subarray(0, 13), out), out);
+	assertEquals([...out], [times[0], times[1], 0]);
+});
+
+Deno.test('cached date', () => {
+	const date = new PLDate(99705600);
+	assertEquals(date.toISOString(), '2004-02-29T00:00:00.000Z');
+	date.day = 1;
+	assertEquals(date.toISOString(), '2004-02-01T00:00:00.000Z');
+	date.month = 12;
+	assertEquals(`${date}`, '2004-12-01T00:00:00.000Z');
+	date.year = 2005;
+	assertEquals(date.year, 2005);
+	date.hour = 2;
+	date.minute = 3;
+	date.second = 4;
+	assertEquals(date.day, 1);
+	date.time = 0;
+	assertEquals(date.toISOString(), '2001-01-01T00:00:00.000Z');
+	assertEquals(date.month, 1);
+});
+
 Deno.test('every day 1990', () => {
 	let i = 0;
 	const months = [31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31];
@@ -5,13 +5,13 @@
  */
 
 import {
-	getDay,
+	getFields,
 	getHour,
 	getISO,
 	getMinute,
-	getMonth,
 	getSecond,
-	getYear,
+	getTimes,
+	getYMD,
 	parseISO,
 	setDay,
 	setHour,
@@ -20,11 +20,39 @@ import {
 	setSecond,
 	setYear,
 } from './pri/date.ts';
+import { mutable } from './pri/mutate.ts';
 import type { PLType } from './type.ts';
 
 const times = new WeakMap<PLDate, number>();
+const dates = new WeakMap<PLDate, [number, number, number]>();
 const UNIX_EPOCH = -978307200;
 
+/**
+ * Get year, month, day, cached until time is set.
+ *
+ * @param date Date.
+ * @returns Year, month, day.
+ */
+function ymd(date: PLDate): [number, number, number] {
+	let r = dates.get(date);
+	if (!r) {
+		dates.set(date, r = getYMD(times.get(date)!));
+	}
+	return r;
+}
+
+/**
+ * Set date time, clearing cache.
+ *
+ * @param date Date.
+ * @param time Date time.
+ */
+function set(date: PLDate, time: number): void {
+	mutable(date);
+	times.set(date, time);
+	dates.delete(date);
+}
+
 /**
  * PLDate type.
  */
@@ -65,7 +93,7 @@ export class PLDate {
 	 * @param time Date time.
 	 */
 	public set time(time: number) {
-		times.set(this, +time);
+		set(this, +time);
 	}
 
 	/**
@@ -74,7 +102,7 @@ export class PLDate {
 	 * @returns Year.
 	 */
 	public get year(): number {
-		return getYear(times.get(this)!);
+		return ymd(this)[0];
 	}
 
 	/**
@@ -83,7 +111,7 @@ export class PLDate {
 	 * @param year Year.
 	 */
 	public set year(year: number) {
-		times.set(
+		set(
 			this,
 			setYear(times.get(this)!, (+year || 0) - (year % 1 || 0)),
 		);
@@ -95,7 +123,7 @@ export class PLDate {
 	 * @returns Month, 1 indexed.
 	 */
 	public get month(): number {
-		return getMonth(times.get(this)!);
+		return ymd(this)[1];
 	}
 
 	/**
@@ -104,7 +132,7 @@ export class PLDate {
 	 * @param month Month.
 	 */
 	public set month(month: number) {
-		times.set(
+		set(
 			this,
 			setMonth(times.get(this)!, (+month || 0) - (month % 1 || 0)),
 		);
@@ -116,7 +144,7 @@ export class PLDate {
 	 * @returns Day.
 	 */
 	public get day(): number {
-		return getDay(times.get(this)!);
+		return ymd(this)[2];
 	}
 
 	/**
@@ -125,7 +153,7 @@ export class PLDate {
 	 * @param day Day.
 	 */
 	public set day(day: number) {
-		times.set(
+		set(
 			this,
 			setDay(times.get(this)!, (+day || 0) - (day % 1 || 0)),
 		);
@@ -146,7 +174,7 @@ export class PLDate {
 	 * @param hour Hour.
 	 */
 	public set hour(hour: number) {
-		times.set(
+		set(
 			this,
 			setHour(times.get(this)!, (+hour || 0) - (hour % 1 || 0)),
 		);
@@ -167,7 +195,7 @@ export class PLDate {
 	 * @param minute Minute.
 	 */
 	public set minute(minute: number) {
-		times.set(
+		set(
 			this,
 			setMinute(times.get(this)!, (+minute || 0) - (minute % 1 || 0)),
 		);
@@ -188,7 +216,7 @@ export class PLDate {
 	 * @param second Second.
 	 */
 	public set second(second: number) {
-		times.set(
+		set(
 			this,
 			setSecond(times.get(this)!, +second || 0),
 		);
@@ -209,7 +237,7 @@ export class PLDate {
 	 * @returns ISO string.
 	 */
 	public toISOString(): string {
-		return getISO(times.get(this)!);
+		return getISO(times.get(this)!, ymd(this));
 	}
 
 	/**
@@ -227,7 +255,7 @@ export class PLDate {
 	 * @returns ISO string.
 	 */
 	public toString(): string {
-		return getISO(times.get(this)!);
+		return getISO(times.get(this)!, ymd(this));
 	}
 
 	/**
@@ -279,6 +307,36 @@ export class PLDate {
 		return parseISO(date);
 	}
 
+	/**
+	 * Break down date times into fields, 6 per date time.
+	 * Fields are year, month, day, hour, minute, second, like the getters.
+	 *
+	 * @param times Date times.
+	 * @param fields Optional fields to fill.
+	 * @returns Fields.
+	 */
+	public static fields(
+		times: ArrayLike<number>,
+		fields: Float64Array = new Float64Array(times.length * 6),
+	): Float64Array {
+		return getFields(times, fields);
+	}
+
+	/**
+	 * Create date times from fields, 6 per date time.
+	 * Fields are year, month, day, hour, minute, second, like ISO values.
+	 *
+	 * @param fields Fields.
+	 * @param times Optional date times to fill.
+	 * @returns Date times.
+	 */
+	public static times(
+		fields: ArrayLike<number>,
+		times: Float64Array = new Float64Array(fields.length / 6 | 0),
+	): Float64Array {
+		return getTimes(fields, times);
+	}
+
 	/**
 	 * Date time for the UNIX epoch.
 	 *
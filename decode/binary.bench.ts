@@ -0,0 +1,28 @@
+import { encodeBinary } from '../encode/binary.ts';
+import { benchFixtures, benchFuzzed, benchPlists } from '../spec/bench.ts';
+import { decodeBinary } from './binary.ts';
+
+const fixtures = benchFixtures('binary', decodeBinary);
+
+Deno.bench('decodeBinary: fixtures', { group: 'fixtures' }, () => {
+	for (const encoded of fixtures) {
+		decodeBinary(encoded);
+	}
+});
+
+for (const [name, plist] of benchPlists()) {
+	const encoded = encodeBinary(plist);
+	Deno.bench(`decodeBinary: ${name}`, { group: name }, () => {
+		decodeBinary(encoded);
+	});
+}
+
+for (const [name, encoded] of benchFuzzed('binary')) {
+	Deno.bench(`decodeBinary: fuzz ${name}`, { group: 'fuzz' }, () => {
+		try {
+			decodeBinary(encoded);
+		} catch {
+			// Invalid input, timed to the error.
+		}
+	});
+}
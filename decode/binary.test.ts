@@ -16,12 +16,17 @@ import { FORMAT_BINARY_V1_0 } from '../format.ts';
 import { PLInteger } from '../integer.ts';
 import { PLNull } from '../null.ts';
 import { binaryError } from '../pri/data.ts';
+import { compileQuery, query } from '../query.ts';
 import { PLReal } from '../real.ts';
 import { PLSet } from '../set.ts';
 import { PLString } from '../string.ts';
 import type { PLType } from '../type.ts';
 import { PLUID } from '../uid.ts';
-import { decodeBinary, type DecodeBinaryOptions } from './binary.ts';
+import {
+	decodeBinary,
+	type DecodeBinaryOptions,
+	validateBinary,
+} from './binary.ts';
 
 const CF_STYLE = {
 	int64: true,
@@ -506,6 +511,101 @@ Deno.test('OOB Data String Array Dictionary', () => {
 	}
 });
 
+Deno.test('Option: query', async () => {
+	const encoded = await fixturePlist('dict-nesting', 'binary');
+	const { plist } = decodeBinary(encoded);
+	for (
+		const path of [
+			'',
+			'*',
+			'**',
+			'A',
+			'A/*',
+			'*/*/*',
+			'**/ABA',
+			'B/BB/BBB',
+			'A/**',
+			'Missing/**',
+		]
+	) {
+		const found = decodeBinary(encoded, { query: path }).plist;
+		assertInstanceOf(found, PLArray, path);
+		const expected = query(plist, compileQuery(path));
+		assertEquals(found.length, expected.length, path);
+		for (let i = 0; i < expected.length; i++) {
+			assertEquals(found.get(i), expected[i], `${path}: ${i}`);
+		}
+	}
+
+	// Self reference only found if walked.
+	const data = new Uint8Array(8 + 2 + 1 + 32);
+	const view = new DataView(data.buffer);
+	data.set([...'bplist00'].map((c) => c.charCodeAt(0)));
+	view.setBigUint64(data.length - 24, 1n);
+	view.setBigUint64(data.length - 8, BigInt(data.length - 33));
+	data[data.length - 26] = 1;
+	data[data.length - 25] = 1;
+	data[data.length - 33] = 8;
+	data[8] = 0xA1;
+	data[9] = 0;
+	assertEquals(decodeBinary(data, { query: '1' }).plist, new PLArray());
+	assertThrows(
+		() => decodeBinary(data, { query: '0' }),
+		SyntaxError,
+		binaryError(8),
+	);
+	assertThrows(
+		() => decodeBinary(data, { query: '**/1' }),
+		SyntaxError,
+		binaryError(8),
+	);
+});
+
+Deno.test('validateBinary', async () => {
+	const nesting = await fixturePlist('dict-nesting', 'binary');
+	assertEquals(validateBinary(nesting), {
+		format: FORMAT_BINARY_V1_0,
+		objects: 29,
+		depth: 3,
+	});
+	for (
+		const name of [
+			'depth-25',
+			'infinite-recursion-array',
+			'key-type-array',
+			'key-type-int',
+			'reused-key-type-dict',
+			'uid-over',
+		]
+	) {
+		// deno-lint-ignore no-await-in-loop
+		const data = await fixturePlist('binary-edge', name);
+		for (const [style, options] of Object.entries(STYLES)) {
+			const tag = `${name}: ${style}`;
+			let error;
+			try {
+				decodeBinary(data, options);
+			} catch (err) {
+				error = err as Error;
+			}
+			if (error) {
+				assertThrows(
+					() => validateBinary(data, options),
+					SyntaxError,
+					error.message,
+					tag,
+				);
+			} else {
+				assertEquals(
+					validateBinary(data, options).format,
+					FORMAT_BINARY_V1_0,
+					tag,
+				);
+			}
+		}
+	}
+});
+
 Deno.test('spec: true', async () => {
 	const { format, plist } = decodeBinary(
 		await fixturePlist('true', 'binary'),
@@ -1497,6 +1597,13 @@ Deno.test('spec: integer-sizes', async () => {
 		assertInstanceOf(v, PLInteger, `${i}`);
 		const expected = BigInt.asIntN(64, BigInt(k.value));
 		assertEquals(v.value, expected, k.value);
+		assertStrictEquals(
+			v.compact,
+			Number.isSafeInteger(Number(expected))
+				? Number(expected)
+				: expected,
+			k.value,
+		);
 		i++;
 	}
 });
@@ -4,18 +4,30 @@
  * Binary decoding.
  */
 
-import { PLArray, PLTYPE_ARRAY } from '../array.ts';
+import { PLArray } from '../array.ts';
+import type { AsyncOptions } from '../async.ts';
 import { PLBoolean } from '../boolean.ts';
+import { BudgetError, type BudgetOptions } from '../budget.ts';
 import { PLData } from '../data.ts';
 import { PLDate } from '../date.ts';
-import { PLDictionary, PLTYPE_DICTIONARY } from '../dictionary.ts';
+import { PLDictionary } from '../dictionary.ts';
 import { FORMAT_BINARY_V1_0 } from '../format.ts';
 import { PLInteger } from '../integer.ts';
 import { PLNull } from '../null.ts';
-import { binaryError, bytes } from '../pri/data.ts';
+import { sliced, sync } from '../pri/async.ts';
+import { arrays } from '../pri/array.ts';
+import { getN, getU } from '../pri/binary.ts';
+import { budget } from '../pri/budget.ts';
+import { binaryError, binaryErrorBudget, bytes } from '../pri/data.ts';
+import { maps } from '../pri/dictionary.ts';
+import { queryCompiled, queryStep } from '../pri/query.ts';
+import { sets } from '../pri/set.ts';
+import { traceDecode } from '../pri/trace.ts';
+import type { Query } from '../query.ts';
 import { PLReal } from '../real.ts';
-import { PLSet, PLTYPE_SET } from '../set.ts';
-import { PLString, PLTYPE_STRING } from '../string.ts';
+import { PLSet } from '../set.ts';
+import { PLString } from '../string.ts';
+import type { TraceOptions } from '../trace.ts';
 import type { PLType } from '../type.ts';
 import { PLUID } from '../uid.ts';
 
@@ -24,28 +36,16 @@ import { PLUID } from '../uid.ts';
  */
 type Next = Generator<Next, Next | undefined>;
 
+/**
+ * Trace phases.
+ */
+const phases = ['trailer', 'objects'] as const;
+
 const U32_MAX = 0xffffffff;
 const I64_MAX = 0x7fffffffffffffffn;
 const U64_MAX = 0xffffffffffffffffn;
 const U128_MAX = 0xffffffffffffffffffffffffffffffffn;
 
-/**
- * Get uint of size.
- *
- * @param d Data.
- * @param i Offset.
- * @param c Byte count.
- * @param m Max.
- * @returns Integer.
- */
-function getU(d: Uint8Array, i: number, c: number, m = U64_MAX): bigint {
-	let r = 0n;
-	for (; c--;) {
-		r = r << 8n & m | BigInt(d[i++]);
-	}
-	return r;
-}
-
 /**
  * Get references.
  *
@@ -62,14 +62,14 @@ function* getRefs(
 	l: number,
 ): Generator<number> {
 	for (; l--; i += c) {
-		yield Number(getU(d, i, c));
+		yield getN(d, i, c);
 	}
 }
 
 /**
  * Decode binary plist options.
  */
-export interface DecodeBinaryOptions {
+export interface DecodeBinaryOptions extends BudgetOptions, TraceOptions {
 	/**
 	 * Optionally limit integers to 64-bit signed or unsigned values.
 	 *
@@ -84,6 +84,12 @@ export interface DecodeBinaryOptions {
 	 */
 	primitiveKeys?: boolean;
 
+	/**
+	 * Optionally decode only values matching a path query, into an array.
+	 * Branches that cannot match are not decoded or validated.
+	 */
+	query?: Query | string;
+
 	/**
 	 * Optionally limit key types to strings.
 	 *
@@ -108,20 +114,50 @@ export interface DecodeBinaryResult {
 }
 
 /**
- * Decode OpenStep encoded plist.
+ * Validate binary plist result.
+ */
+export interface ValidateBinaryResult {
+	/**
+	 * Encoded format.
+	 */
+	format: typeof FORMAT_BINARY_V1_0;
+
+	/**
+	 * Number of objects, counting keys, shared objects once.
+	 */
+	objects: number;
+
+	/**
+	 * Maximum depth of nested collections.
+	 */
+	depth: number;
+}
+
+/**
+ * Decode binary encoded plist, yielding objects decoded every step objects.
  *
- * @param encoded OpenStep plist encoded data.
+ * @param encoded Binary plist encoded data.
  * @param options Decoding options.
- * @returns Decode result.
+ * @param step References between yields, 0 for none.
+ * @param s Objects and depth, to only validate, or null.
+ * @param t Phase start times, to trace, or null.
+ * @yields Objects decoded.
+ * @returns Decode result, without a plist when validating.
  */
-export function decodeBinary(
+function* binary(
 	encoded: ArrayBufferView | ArrayBufferLike,
 	{
 		int64 = false,
 		stringKeys = false,
 		primitiveKeys = false,
-	}: Readonly<DecodeBinaryOptions> = {},
-): DecodeBinaryResult {
+		query,
+		...b
+	}: Readonly<DecodeBinaryOptions>,
+	step: number,
+	s: [objects: number, depth: number] | null,
+	t: number[] | null,
+): Generator<number, DecodeBinaryResult, void> {
+	const [maxDepth, maxObjects, maxBytes, maxLength] = budget(b);
 	const d = bytes(encoded);
 	let l = d.length;
 	let plist: PLType;
@@ -186,13 +222,18 @@ export function decodeBinary(
 		l--;
 		x += intc
 	) {
-		if (getU(d, x, intc) >= table) {
+		if (getN(d, x, intc) >= table) {
 			throw new SyntaxError(binaryError(x));
 		}
 	}
+	t?.push(performance.now());
 	primitiveKeys ||= stringKeys;
-	const ancestors = new Set<PLType>();
-	const object = new Map<number, PLType>();
+	const ancestors = new Set<number>();
+	const object = new Map<number, PLType | null>();
+	const noop = () => {};
+	let o = 0;
+	let y = step || -1;
+	let size = 0;
 	const walk = function* (
 		refs: Iterable<number>,
 		push: (p: PLType) => unknown,
@@ -202,35 +243,40 @@ export function decodeBinary(
 	): Next {
 		let c;
 		let i: number;
-		let p: PLType | ArrayBuffer | undefined;
+		let p: PLType | ArrayBuffer | null | undefined;
 		let m: number;
 		let r: number | string | Map<number, PLType>;
 		for (r of refs) {
-			i = Number(getU(d, x = table + r * intc, intc));
+			// Yield self to pause.
+			if (++o === y) {
+				y += step;
+				yield top as Next;
+			}
+			i = getN(d, x = table + r * intc, intc);
 			if (i > 7) {
-				if ((p = object.get(i))) {
+				if ((p = object.get(i)) !== undefined) {
 					if (
-						ancestors.has(p) ||
+						ancestors.has(i) ||
 						(
 							keys &&
 							primitiveKeys &&
 							(
 								stringKeys
-									? p[Symbol.toStringTag] !== PLTYPE_STRING
-									: (
-										(x = p[Symbol.toStringTag]) ===
-											PLTYPE_DICTIONARY ||
-										x === PLTYPE_ARRAY ||
-										x === PLTYPE_SET
-									)
+									? (m = d[i] >> 4) !== 5 && m !== 6
+									: (m = d[i] >> 4) === 10 ||
+										m === 12 ||
+										m === 13
 							)
 						)
 					) {
 						throw new SyntaxError(binaryError(aoff!));
 					}
-					push(p);
+					push(p!);
 					continue;
 				}
+				if (object.size >= maxObjects) {
+					throw new BudgetError(binaryErrorBudget(i, 'maxObjects'));
+				}
 				m = d[x = i++];
 				switch (m >> 4) {
 					case 0: {
@@ -239,18 +285,24 @@ export function decodeBinary(
 						}
 						switch (m) {
 							case 0: {
-								object.set(x, p = new PLNull());
-								push(p);
+								object.set(x, p = s ? null : new PLNull());
+								push(p!);
 								continue;
 							}
 							case 8: {
-								object.set(x, p = new PLBoolean(false));
-								push(p);
+								object.set(
+									x,
+									p = s ? null : new PLBoolean(false),
+								);
+								push(p!);
 								continue;
 							}
 							case 9: {
-								object.set(x, p = new PLBoolean(true));
-								push(p);
+								object.set(
+									x,
+									p = s ? null : new PLBoolean(true),
+								);
+								push(p!);
 								continue;
 							}
 						}
@@ -266,12 +318,14 @@ export function decodeBinary(
 						}
 						object.set(
 							x,
-							p = new PLInteger(
-								getU(d, i, c, int64 ? U64_MAX : U128_MAX),
+							p = s ? null : new PLInteger(
+								c < 8
+									? getN(d, i, c)
+									: getU(d, i, c, int64 ? U64_MAX : U128_MAX),
 								c > 8 ? 128 : 64,
 							),
 						);
-						push(p);
+						push(p!);
 						continue;
 					}
 					case 2: {
@@ -285,9 +339,11 @@ export function decodeBinary(
 								}
 								object.set(
 									x,
-									p = new PLReal(v.getFloat32(i), 32),
+									p = s
+										? null
+										: new PLReal(v.getFloat32(i), 32),
 								);
-								push(p);
+								push(p!);
 								continue;
 							}
 							case 3: {
@@ -296,9 +352,11 @@ export function decodeBinary(
 								}
 								object.set(
 									x,
-									p = new PLReal(v.getFloat64(i), 64),
+									p = s
+										? null
+										: new PLReal(v.getFloat64(i), 64),
 								);
-								push(p);
+								push(p!);
 								continue;
 							}
 						}
@@ -311,8 +369,11 @@ export function decodeBinary(
 						if (m !== 51 || i + 8 > table) {
 							break;
 						}
-						object.set(x, p = new PLDate(v.getFloat64(i)));
-						push(p);
+						object.set(
+							x,
+							p = s ? null : new PLDate(v.getFloat64(i)),
+						);
+						push(p!);
 						continue;
 					}
 					case 4: {
@@ -328,17 +389,27 @@ export function decodeBinary(
 							) {
 								break;
 							}
-							c = Number(getU(d, i, r));
+							c = getN(d, i, r);
 							i += r;
 						}
 						if (i + c > table) {
 							break;
 						}
-						new Uint8Array(p = new ArrayBuffer(c)).set(
-							d.subarray(i, i + c),
-						);
-						object.set(x, p = new PLData(p));
-						push(p);
+						if ((size += c) > maxBytes) {
+							throw new BudgetError(
+								binaryErrorBudget(x, 'maxBytes'),
+							);
+						}
+						if (s) {
+							p = null;
+						} else {
+							new Uint8Array(p = new ArrayBuffer(c)).set(
+								d.subarray(i, i + c),
+							);
+							p = new PLData(p);
+						}
+						object.set(x, p);
+						push(p!);
 						continue;
 					}
 					case 5: {
@@ -351,17 +422,27 @@ export function decodeBinary(
 							) {
 								break;
 							}
-							c = Number(getU(d, i, r));
+							c = getN(d, i, r);
 							i += r;
 						}
 						if (i + c > table) {
 							break;
 						}
-						for (r = ''; c--;) {
-							r += String.fromCharCode(d[i++]);
+						if ((size += c) > maxBytes) {
+							throw new BudgetError(
+								binaryErrorBudget(x, 'maxBytes'),
+							);
+						}
+						if (s) {
+							p = null;
+						} else {
+							for (r = ''; c--;) {
+								r += String.fromCharCode(d[i++]);
+							}
+							p = new PLString(r);
 						}
-						object.set(x, p = new PLString(r));
-						push(p);
+						object.set(x, p);
+						push(p!);
 						continue;
 					}
 					case 6: {
@@ -374,17 +455,27 @@ export function decodeBinary(
 							) {
 								break;
 							}
-							c = Number(getU(d, i, r));
+							c = getN(d, i, r);
 							i += r;
 						}
 						if (i + c * 2 > table) {
 							break;
 						}
-						for (r = ''; c--; i += 2) {
-							r += String.fromCharCode(v.getUint16(i));
+						if ((size += c * 2) > maxBytes) {
+							throw new BudgetError(
+								binaryErrorBudget(x, 'maxBytes'),
+							);
+						}
+						if (s) {
+							p = null;
+						} else {
+							for (r = ''; c--; i += 2) {
+								r += String.fromCharCode(v.getUint16(i));
+							}
+							p = new PLString(r);
 						}
-						object.set(x, p = new PLString(r));
-						push(p);
+						object.set(x, p);
+						push(p!);
 						continue;
 					}
 					case 8: {
@@ -395,8 +486,8 @@ export function decodeBinary(
 						if (i + c > table || (c = getU(d, i, c)) > U32_MAX) {
 							break;
 						}
-						object.set(x, p = new PLUID(c));
-						push(p);
+						object.set(x, p = s ? null : new PLUID(c));
+						push(p!);
 						continue;
 					}
 					case 10: {
@@ -412,24 +503,38 @@ export function decodeBinary(
 							) {
 								break;
 							}
-							c = Number(getU(d, i, r));
+							c = getN(d, i, r);
 							i += r;
 						}
 						if (i + c * refc > table) {
 							break;
 						}
-						object.set(x, p = new PLArray());
+						if (c > maxLength) {
+							throw new BudgetError(
+								binaryErrorBudget(x, 'maxLength'),
+							);
+						}
+						if (ancestors.size >= maxDepth) {
+							throw new BudgetError(
+								binaryErrorBudget(x, 'maxDepth'),
+							);
+						}
+						if (s && s[1] <= ancestors.size) {
+							s[1] = ancestors.size + 1;
+						}
+						object.set(x, p = s ? null : new PLArray());
 						if (c) {
-							ancestors.add(p);
+							ancestors.add(m = x);
+							const e = p && arrays.get(p)!;
 							yield walk(
 								getRefs(d, i, refc, c),
-								p.push.bind(p),
+								e ? e.push.bind(e) : noop,
 								top as Next,
 								x,
 							);
-							ancestors.delete(p);
+							ancestors.delete(m);
 						}
-						push(p);
+						push(p!);
 						continue;
 					}
 					case 12: {
@@ -445,24 +550,38 @@ export function decodeBinary(
 							) {
 								break;
 							}
-							c = Number(getU(d, i, r));
+							c = getN(d, i, r);
 							i += r;
 						}
 						if (i + c * refc > table) {
 							break;
 						}
-						object.set(x, p = new PLSet());
+						if (c > maxLength) {
+							throw new BudgetError(
+								binaryErrorBudget(x, 'maxLength'),
+							);
+						}
+						if (ancestors.size >= maxDepth) {
+							throw new BudgetError(
+								binaryErrorBudget(x, 'maxDepth'),
+							);
+						}
+						if (s && s[1] <= ancestors.size) {
+							s[1] = ancestors.size + 1;
+						}
+						object.set(x, p = s ? null : new PLSet());
 						if (c) {
-							ancestors.add(p);
+							ancestors.add(m = x);
+							const e = p && sets.get(p)!;
 							yield walk(
 								getRefs(d, i, refc, c),
-								p.add.bind(p),
+								e ? e.add.bind(e) : noop,
 								top as Next,
 								x,
 							);
-							ancestors.delete(p);
+							ancestors.delete(m);
 						}
-						push(p);
+						push(p!);
 						continue;
 					}
 					case 13: {
@@ -478,21 +597,37 @@ export function decodeBinary(
 							) {
 								break;
 							}
-							c = Number(getU(d, i, r));
+							c = getN(d, i, r);
 							i += r;
 						}
 						if (i + c * 2 * refc > table) {
 							break;
 						}
-						object.set(x, p = new PLDictionary());
+						if (c > maxLength) {
+							throw new BudgetError(
+								binaryErrorBudget(x, 'maxLength'),
+							);
+						}
+						if (ancestors.size >= maxDepth) {
+							throw new BudgetError(
+								binaryErrorBudget(x, 'maxDepth'),
+							);
+						}
+						if (s && s[1] <= ancestors.size) {
+							s[1] = ancestors.size + 1;
+						}
+						object.set(x, p = s ? null : new PLDictionary());
 						if (c) {
-							ancestors.add(p);
-							aoff = x;
+							ancestors.add(aoff = x);
 							r = new Map<number, PLType>();
+							const e = p && maps.get(p)!;
 							m = 0;
 							yield walk(
 								getRefs(d, i, refc, c),
-								(o) => (r as Map<number, PLType>).set(m++, o),
+								p
+									? (o) =>
+										(r as Map<number, PLType>).set(m++, o)
+									: noop,
 								top as Next,
 								aoff,
 								true,
@@ -500,17 +635,20 @@ export function decodeBinary(
 							m = 0;
 							yield walk(
 								getRefs(d, i + c * refc, refc, c),
-								(o) =>
-									(p as PLDictionary).set(
-										(r as Map<number, PLType>).get(m++)!,
-										o,
-									),
+								e
+									? (o) =>
+										e.set(
+											(r as Map<number, PLType>)
+												.get(m++)!,
+											o,
+										)
+									: noop,
 								top as Next,
 								aoff,
 							);
-							ancestors.delete(p);
+							ancestors.delete(aoff);
 						}
-						push(p);
+						push(p!);
 						continue;
 					}
 				}
@@ -519,9 +657,173 @@ export function decodeBinary(
 		}
 		return next;
 	};
-	for (
-		top = walk([Number(top)], (p: PLType) => plist = p);
-		(top = top.next().value);
-	);
+	const run = function* (g: Next): Generator<number, void, void> {
+		for (let n; (n = (top = g).next().value);) {
+			if (n === g) {
+				yield object.size;
+			} else {
+				g = n;
+			}
+		}
+	};
+	if (query !== undefined && !s) {
+		const q = queryCompiled(query);
+		const { e } = q;
+		const found = new PLArray();
+		const add = found.push.bind(found);
+		const key = (p: PLType) => k = p;
+
+		// Stack of containers, types, refs offsets, sizes, indexes, states.
+		const os: number[] = [];
+		const ts: number[] = [];
+		const is: number[] = [];
+		const cs: number[] = [];
+		const js: number[] = [];
+		const ms: number[] = [];
+		const parents = new Set<number>();
+		let r = Number(top);
+		let m = q.r;
+		let depth = 0;
+		let k: PLType;
+		let o;
+		let c;
+		let t;
+		let f;
+		let i;
+		let j;
+		for (;;) {
+			if (m & e) {
+				yield* run(walk([r], add));
+			}
+			if (
+				m & e - 1 &&
+				(
+					(t = d[o = getN(d, table + r * intc, intc)] >> 4) === 10 ||
+					t === 12 ||
+					t === 13
+				)
+			) {
+				c = d[o] & 15;
+				i = o + 1;
+				if (c === 15) {
+					if (
+						i >= table ||
+						((x = d[i++]) & 240) !== 16 ||
+						i + (x = 1 << (x & 15)) > table
+					) {
+						throw new SyntaxError(binaryError(o));
+					}
+					c = getN(d, i, x);
+					i += x;
+				}
+				if (i + c * (t === 13 ? 2 : 1) * refc > table) {
+					throw new SyntaxError(binaryError(o));
+				}
+				if (c) {
+					parents.add(os[depth] = o);
+					ts[depth] = t;
+					is[depth] = i;
+					cs[depth] = c;
+					js[depth] = 0;
+					ms[depth++] = m;
+				}
+			}
+
+			// Next child that can match, or back up to the parent.
+			for (m = 0; !m;) {
+				if (!depth) {
+					return { plist: found, format: FORMAT_BINARY_V1_0 };
+				}
+				if ((j = js[f = depth - 1]++) < cs[f]) {
+					r = getN(d, i = is[f] + j * refc, refc);
+					switch (ts[f]) {
+						case 10: {
+							m = queryStep(q, ms[f], j);
+							break;
+						}
+						case 12: {
+							m = queryStep(q, ms[f], null);
+							break;
+						}
+						default: {
+							yield* run(walk([r], key, undefined, os[f], true));
+							r = getN(d, i + cs[f] * refc, refc);
+							m = queryStep(q, ms[f], k!);
+						}
+					}
+					if (m && parents.has(getN(d, table + r * intc, intc))) {
+						throw new SyntaxError(binaryError(os[f]));
+					}
+				} else {
+					parents.delete(os[--depth]);
+				}
+			}
+		}
+	}
+	yield* run(walk([Number(top)], (p: PLType) => plist = p));
+	if (s) {
+		s[0] = object.size;
+	}
 	return { plist: plist!, format: FORMAT_BINARY_V1_0 };
 }
+
+/**
+ * Decode binary encoded plist.
+ *
+ * @param encoded Binary plist encoded data.
+ * @param options Decoding options.
+ * @returns Decode result.
+ */
+export function decodeBinary(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	options: Readonly<DecodeBinaryOptions> = {},
+): DecodeBinaryResult {
+	return sync(
+		traceDecode(
+			options,
+			phases,
+			encoded,
+			(t) => binary(encoded, options, 0, null, t),
+		),
+	);
+}
+
+/**
+ * Decode binary encoded plist, without blocking the event loop.
+ *
+ * @param encoded Binary plist encoded data.
+ * @param options Decoding and async options.
+ * @returns Decode result.
+ */
+export function decodeBinaryAsync(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	options: Readonly<DecodeBinaryOptions & AsyncOptions> = {},
+): Promise<DecodeBinaryResult> {
+	return sliced(
+		(step) =>
+			traceDecode(
+				options,
+				phases,
+				encoded,
+				(t) => binary(encoded, options, step, null, t),
+			),
+		options,
+	);
+}
+
+/**
+ * Validate binary encoded plist, without decoding any objects.
+ * Throws the same errors as decoding, query option is ignored.
+ *
+ * @param encoded Binary plist encoded data.
+ * @param options Decoding options.
+ * @returns Validate result.
+ */
+export function validateBinary(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	options: Readonly<DecodeBinaryOptions> = {},
+): ValidateBinaryResult {
+	const s: [number, number] = [0, 0];
+	const { format } = sync(binary(encoded, options, 0, s, null));
+	return { format, objects: s[0], depth: s[1] };
+}
@@ -0,0 +1,41 @@
+import { encodeBinary } from '../encode/binary.ts';
+import { encodeOpenStep } from '../encode/openstep.ts';
+import { encodeXml } from '../encode/xml.ts';
+import { benchFixtures, benchPlists } from '../spec/bench.ts';
+import type { PLType } from '../type.ts';
+import { decodeBinary } from './binary.ts';
+import { decode } from './mod.ts';
+import { decodeOpenStep } from './openstep.ts';
+import { decodeXml } from './xml.ts';
+
+const formats: [
+	'binary' | 'openstep' | 'xml',
+	(encoded: Uint8Array) => unknown,
+	(plist: PLType) => Uint8Array,
+][] = [
+	['binary', decodeBinary, encodeBinary],
+	['xml', decodeXml, encodeXml],
+	['openstep', decodeOpenStep, encodeOpenStep],
+];
+
+for (const [name, direct, encode] of formats) {
+	const fixtures = benchFixtures(name, decode);
+	Deno.bench(`decode: ${name}: fixtures`, { group: name }, () => {
+		for (const encoded of fixtures) {
+			decode(encoded);
+		}
+	});
+
+	const [[, wide]] = benchPlists(name === 'openstep');
+	const encoded = encode(wide);
+	Deno.bench(`decode: ${name}: wide`, { group: `${name}: wide` }, () => {
+		decode(encoded);
+	});
+	Deno.bench(
+		`decode: ${name}: wide: direct`,
+		{ group: `${name}: wide`, baseline: true },
+		() => {
+			direct(encoded);
+		},
+	);
+}
@@ -1,5 +1,5 @@
 import { assertEquals, assertInstanceOf, assertThrows } from '@std/assert';
-import { fixturePlist } from '../spec/fixture.ts';
+import { fixturePlist, fixturePlists } from '../spec/fixture.ts';
 import { PLArray } from '../array.ts';
 import { PLBoolean } from '../boolean.ts';
 import { PLDictionary } from '../dictionary.ts';
@@ -12,9 +12,11 @@ import {
 } from '../format.ts';
 import { PLInteger } from '../integer.ts';
 import { binaryError } from '../pri/data.ts';
+import { PLSet } from '../set.ts';
 import { PLString } from '../string.ts';
 import type { PLType } from '../type.ts';
-import { decode } from './mod.ts';
+import { PLUID } from '../uid.ts';
+import { decode, validate } from './mod.ts';
 
 const TE = new TextEncoder();
 const TDASCII = new TextDecoder('ascii', { fatal: true });
@@ -579,3 +581,94 @@ Deno.test('spec: integer-big: binary', async () => {
 		assertEquals(MIN_PLUS_2.bits, 128);
 	}
 });
+
+/**
+ * Count objects and depth like validation does, in decoding order.
+ *
+ * @param plist Plist object.
+ * @param seen Objects already counted.
+ * @returns Objects, depth, and if any UID.
+ */
+function stats(
+	plist: PLType,
+	seen = new Set<PLType>(),
+): [number, number, boolean] {
+	let objects = 1;
+	let depth = 0;
+	let uid = PLUID.is(plist);
+	seen.add(plist);
+	const children = PLDictionary.is(plist)
+		? [...plist.keys(), ...plist.values()]
+		: PLArray.is(plist) || PLSet.is(plist)
+		? [...plist]
+		: null;
+	if (children) {
+		depth = 1;
+		for (const child of children) {
+			if (!seen.has(child)) {
+				const [o, d, u] = stats(child, seen);
+				objects += o;
+				depth = Math.max(depth, d + 1);
+				uid ||= u;
+			}
+		}
+	}
+	return [objects, depth, uid];
+}
+
+Deno.test('validate: same as decode', async () => {
+	let seed = 1;
+	const rand = (n: number) => {
+		seed = seed * 1103515245 + 12345 & 0x7fffffff;
+		return seed % n;
+	};
+	const options = [
+		{},
+		{ binary: { stringKeys: true } },
+		{ binary: { primitiveKeys: true }, xml: { int64: true } },
+		{ openstep: { allowMissingSemi: true } },
+	];
+	for (const [group, name] of await fixturePlists()) {
+		// deno-lint-ignore no-await-in-loop
+		const data = await fixturePlist(group, name);
+		const samples = [data];
+		const small = data.length < 0x4000;
+		if (small) {
+			for (let i = 8; i--;) {
+				samples.push(data.slice(0, rand(data.length)));
+				const mutated = data.slice();
+				mutated[rand(data.length)] = rand(256);
+				samples.push(mutated);
+			}
+		}
+		for (const sample of samples) {
+			for (const o of small ? options : options.slice(0, 1)) {
+				const tag = `${group}/${name}: ${JSON.stringify(o)}`;
+				let decoded;
+				let validated;
+				let de;
+				let ve;
+				try {
+					decoded = decode(sample, o);
+				} catch (err) {
+					de = err as Error;
+				}
+				try {
+					validated = validate(sample, o);
+				} catch (err) {
+					ve = err as Error;
+				}
+				assertEquals(ve?.constructor, de?.constructor, tag);
+				assertEquals(ve?.message, de?.message, tag);
+				if (decoded && validated && small) {
+					assertEquals(validated.format, decoded.format, tag);
+					const [objects, depth, uid] = stats(decoded.plist);
+					if (!uid || decoded.format === FORMAT_BINARY_V1_0) {
+						assertEquals(validated.objects, objects, tag);
+						assertEquals(validated.depth, depth, tag);
+					}
+				}
+			}
+		}
+	}
+});
@@ -8,18 +8,38 @@ export * from './binary.ts';
 export * from './openstep.ts';
 export * from './xml.ts';
 
+import type { AsyncOptions } from '../async.ts';
+import { BudgetError, type BudgetOptions } from '../budget.ts';
 import type { Format } from '../format.ts';
+import { budgets } from '../pri/budget.ts';
 import { bytes } from '../pri/data.ts';
 import { utf8Encoded } from '../pri/utf8.ts';
+import type { TraceOptions } from '../trace.ts';
 import type { PLType } from '../type.ts';
-import { decodeBinary, type DecodeBinaryOptions } from './binary.ts';
-import { decodeOpenStep, type DecodeOpenStepOptions } from './openstep.ts';
-import { decodeXml, type DecodeXmlOptions } from './xml.ts';
+import {
+	decodeBinary,
+	decodeBinaryAsync,
+	type DecodeBinaryOptions,
+	validateBinary,
+} from './binary.ts';
+import {
+	decodeOpenStep,
+	decodeOpenStepAsync,
+	type DecodeOpenStepOptions,
+	validateOpenStep,
+} from './openstep.ts';
+import {
+	decodeXml,
+	decodeXmlAsync,
+	type DecodeXmlOptions,
+	validateXml,
+} from './xml.ts';
 
 /**
- * Decoding options.
+ * Decoding options, with budgets and trace for every format,
+ * unless set per format.
  */
-export interface DecodeOptions {
+export interface DecodeOptions extends BudgetOptions, TraceOptions {
 	/**
 	 * Binary decoding options.
 	 */
@@ -52,17 +72,67 @@ export interface DecodeResult {
 }
 
 /**
- * Decode plist.
+ * Validate plist result.
+ */
+export interface ValidateResult {
+	/**
+	 * Encoded format.
+	 */
+	format: Format;
+
+	/**
+	 * Number of objects, counting keys, shared objects once.
+	 */
+	objects: number;
+
+	/**
+	 * Maximum depth of nested collections.
+	 */
+	depth: number;
+}
+
+/**
+ * Decoding plan, the first decoder to try, then OpenStep as a fallback.
+ */
+type Plan =
+	| [
+		encoded: ArrayBufferView | ArrayBufferLike,
+		xml: true,
+		options: DecodeXmlOptions | undefined,
+		openstep: DecodeOpenStepOptions | undefined,
+	]
+	| [
+		encoded: ArrayBufferView | ArrayBufferLike,
+		xml: false,
+		options: DecodeBinaryOptions | undefined,
+		openstep: DecodeOpenStepOptions | undefined,
+	];
+
+/**
+ * Plan decoding, transcoding any UTF-16 text once for both text decoders.
  *
  * @param encoded Encoded plist.
  * @param options Decoding options.
- * @returns Decoded plist and format.
+ * @returns Decoding plan.
  */
-export function decode(
+function plan(
 	encoded: ArrayBufferView | ArrayBufferLike,
-	{ binary, xml, openstep }: Readonly<DecodeOptions> = {},
-): DecodeResult {
+	options: Readonly<DecodeOptions>,
+): Plan {
+	const b = budgets(options);
+	const { trace } = options;
+	let { binary, xml, openstep } = options;
 	let x, d;
+	if (b) {
+		binary = { ...b, ...binary };
+		xml = { ...b, ...xml };
+		openstep = { ...b, ...openstep };
+	}
+	if (trace) {
+		binary = { trace, ...binary };
+		xml = { trace, ...xml };
+		openstep = { trace, ...openstep };
+	}
 	d = bytes(encoded);
 	if (
 		d.length < 8 ||
@@ -79,35 +149,102 @@ export function decode(
 				(x = xml?.utf16le) === openstep?.utf16le &&
 				(utf8Encoded(d, x)))
 		) {
-			encoded = d;
-			xml = {
-				int64: xml?.int64,
-				decoded: true,
-			};
+			return [
+				d,
+				true,
+				{ ...xml, decoded: true },
+				{ ...openstep, decoded: true },
+			];
+		}
+		return [encoded, true, xml, openstep];
+	}
+	return [encoded, false, binary, openstep];
+}
+
+/**
+ * Decode plist.
+ *
+ * @param encoded Encoded plist.
+ * @param options Decoding options.
+ * @returns Decoded plist and format.
+ */
+export function decode(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	options: Readonly<DecodeOptions> = {},
+): DecodeResult {
+	const [d, x, o, openstep] = plan(encoded, options);
+	try {
+		return x ? decodeXml(d, o) : decodeBinary(d, o);
+	} catch (err) {
+		// Exceeding a budget means the format was detected.
+		if (err instanceof BudgetError) {
+			throw err;
 		}
 		try {
-			return decodeXml(encoded, xml);
-		} catch (err) {
-			if (d) {
-				openstep = {
-					allowMissingSemi: openstep?.allowMissingSemi,
-					decoded: true,
-				};
-			}
-			try {
-				return decodeOpenStep(encoded, openstep);
-			} catch {
-				throw err;
-			}
+			return decodeOpenStep(d, openstep);
+		} catch (e) {
+			// Exceeding a budget means the input was OpenStep.
+			throw e instanceof BudgetError ? e : err;
 		}
 	}
+}
+
+/**
+ * Decode plist, without blocking the event loop.
+ *
+ * @param encoded Encoded plist.
+ * @param options Decoding and async options.
+ * @returns Decoded plist and format.
+ */
+export async function decodeAsync(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	options: Readonly<DecodeOptions & AsyncOptions> = {},
+): Promise<DecodeResult> {
+	const { signal, progress, step, slice } = options;
+	const a = { signal, progress, step, slice };
+	const [d, x, o, openstep] = plan(encoded, options);
 	try {
-		return decodeBinary(encoded, binary);
+		return await (x
+			? decodeXmlAsync(d, { ...o, ...a })
+			: decodeBinaryAsync(d, { ...o, ...a }));
 	} catch (err) {
+		// Exceeding a budget means the format was detected.
+		if (signal?.aborted || err instanceof BudgetError) {
+			throw err;
+		}
 		try {
-			return decodeOpenStep(encoded, openstep);
-		} catch {
+			return await decodeOpenStepAsync(d, { ...openstep, ...a });
+		} catch (e) {
+			throw signal?.aborted || e instanceof BudgetError ? e : err;
+		}
+	}
+}
+
+/**
+ * Validate plist, without decoding any objects.
+ * Throws the same errors as decoding.
+ *
+ * @param encoded Encoded plist.
+ * @param options Decoding options.
+ * @returns Format and stats.
+ */
+export function validate(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	options: Readonly<DecodeOptions> = {},
+): ValidateResult {
+	const [d, x, o, openstep] = plan(encoded, options);
+	try {
+		return x ? validateXml(d, o) : validateBinary(d, o);
+	} catch (err) {
+		// Exceeding a budget means the format was detected.
+		if (err instanceof BudgetError) {
 			throw err;
 		}
+		try {
+			return validateOpenStep(d, openstep);
+		} catch (e) {
+			// Exceeding a budget means the input was OpenStep.
+			throw e instanceof BudgetError ? e : err;
+		}
 	}
 }
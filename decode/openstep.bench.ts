@@ -0,0 +1,28 @@
+import { encodeOpenStep } from '../encode/openstep.ts';
+import { benchFixtures, benchFuzzed, benchPlists } from '../spec/bench.ts';
+import { decodeOpenStep } from './openstep.ts';
+
+const fixtures = benchFixtures('openstep', decodeOpenStep);
+
+Deno.bench('decodeOpenStep: fixtures', { group: 'fixtures' }, () => {
+	for (const encoded of fixtures) {
+		decodeOpenStep(encoded);
+	}
+});
+
+for (const [name, plist] of benchPlists(true)) {
+	const encoded = encodeOpenStep(plist);
+	Deno.bench(`decodeOpenStep: ${name}`, { group: name }, () => {
+		decodeOpenStep(encoded);
+	});
+}
+
+for (const [name, encoded] of benchFuzzed('openstep')) {
+	Deno.bench(`decodeOpenStep: fuzz ${name}`, { group: 'fuzz' }, () => {
+		try {
+			decodeOpenStep(encoded);
+		} catch {
+			// Invalid input, timed to the error.
+		}
+	});
+}
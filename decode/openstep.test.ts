@@ -13,7 +13,11 @@ import { FORMAT_OPENSTEP, FORMAT_STRINGS } from '../format.ts';
 import { unquoted } from '../pri/openstep.ts';
 import { PLString } from '../string.ts';
 import type { PLType } from '../type.ts';
-import { decodeOpenStep, type DecodeOpenStepOptions } from './openstep.ts';
+import {
+	decodeOpenStep,
+	type DecodeOpenStepOptions,
+	validateOpenStep,
+} from './openstep.ts';
 import { PLData } from '../data.ts';
 
 const CF_STYLE = {
@@ -214,6 +218,50 @@ Deno.test('Data EOF', () => {
 	);
 });
 
+Deno.test('validateOpenStep', async () => {
+	assertEquals(
+		validateOpenStep(await fixturePlist('dict-nesting', 'openstep')),
+		{ format: FORMAT_OPENSTEP, objects: 29, depth: 3 },
+	);
+	assertEquals(validateOpenStep(TE.encode(' ')), {
+		format: FORMAT_STRINGS,
+		objects: 1,
+		depth: 1,
+	});
+	assertEquals(validateOpenStep(TE.encode('a = b; c;')), {
+		format: FORMAT_STRINGS,
+		objects: 4,
+		depth: 1,
+	});
+	for (
+		const str of [
+			'(a,',
+			'(a b)',
+			'{a = b}',
+			'{a b;}',
+			'"abc',
+			'<0g>',
+			'<0>',
+			')',
+		]
+	) {
+		const data = TE.encode(str);
+		let error;
+		try {
+			decodeOpenStep(data);
+		} catch (err) {
+			error = err as Error;
+		}
+		assert(error, str);
+		assertThrows(
+			() => validateOpenStep(data),
+			error.constructor as ErrorConstructor,
+			error.message,
+			str,
+		);
+	}
+});
+
 Deno.test('Option: decoded', () => {
 	const data = new Uint8Array([...'ABC123'].map((c) => c.charCodeAt(0)));
 	const { format, plist } = decodeOpenStep(data, { decoded: true });
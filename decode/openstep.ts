@@ -5,36 +5,55 @@
  */
 
 import { PLArray } from '../array.ts';
+import type { AsyncOptions } from '../async.ts';
+import { BudgetError, type BudgetOptions } from '../budget.ts';
 import { PLData } from '../data.ts';
 import { PLDictionary } from '../dictionary.ts';
 import { FORMAT_OPENSTEP, FORMAT_STRINGS } from '../format.ts';
+import { arrays } from '../pri/array.ts';
+import { sliced, sync } from '../pri/async.ts';
 import { b16d } from '../pri/base.ts';
+import { budget } from '../pri/budget.ts';
 import { bytes } from '../pri/data.ts';
+import { maps } from '../pri/dictionary.ts';
 import { latin, unesc, unquoted } from '../pri/openstep.ts';
+import { traceDecode } from '../pri/trace.ts';
 import {
 	utf8Decode,
 	utf8Encoded,
+	utf8ErrorBudget,
 	utf8ErrorEnd,
 	utf8ErrorToken,
 	utf8Length,
 } from '../pri/utf8.ts';
 import { PLString } from '../string.ts';
+import type { TraceOptions } from '../trace.ts';
 import type { PLType } from '../type.ts';
 
+/**
+ * Trace phases.
+ */
+const phases = ['decode', 'parse'] as const;
+
 /**
  * Linked list node type.
  */
 interface Node {
 	/**
-	 * Plist object.
+	 * Plist object, or true when validating.
 	 */
-	o: PLArray | PLDictionary;
+	o: PLArray | PLDictionary | true;
 
 	/**
 	 * End character.
 	 */
 	e: number;
 
+	/**
+	 * Number of entries.
+	 */
+	l: number;
+
 	/**
 	 * Next node.
 	 */
@@ -98,12 +117,17 @@ function next(d: Uint8Array, p: [number]): number {
  *
  * @param d Data.
  * @param p Parse context.
- * @returns Decoded data.
+ * @param v Truthy to only validate.
+ * @returns Decoded data, or true when validating.
  */
-function decodeData(d: Uint8Array, p: [number]): PLData {
+function decodeData(d: Uint8Array, p: [number], v: boolean): PLData | true {
 	for (let i = p[0] + 1, b = i, c, s = 0, r, l = d.length; i < l;) {
 		if (b16d(c = d[i]) < 0) {
 			if (c === 62) {
+				if (v) {
+					p[0] = i + 1;
+					return true;
+				}
 				c = new Uint8Array(r = new ArrayBuffer(s));
 				r = new PLData(r);
 				for (s = 0; b < i;) {
@@ -194,6 +218,28 @@ function decodeStrQ(d: Uint8Array, p: [number], q: number): PLString {
 	throw new SyntaxError(utf8ErrorEnd(d));
 }
 
+/**
+ * Skip quoted string.
+ *
+ * @param d Data.
+ * @param p Position.
+ * @param q Quote character.
+ * @returns True.
+ */
+function skipStrQ(d: Uint8Array, p: [number], q: number): true {
+	for (let [i] = p, c, l = d.length; ++i < l;) {
+		c = d[i];
+		if (c === q) {
+			p[0] = i + 1;
+			return true;
+		}
+		if (c === 92) {
+			i++;
+		}
+	}
+	throw new SyntaxError(utf8ErrorEnd(d));
+}
+
 /**
  * Decode unquoted string.
  *
@@ -212,10 +258,24 @@ function decodeStrU(d: Uint8Array, p: [number]): PLString {
 	return new PLString(s);
 }
 
+/**
+ * Skip unquoted string.
+ *
+ * @param d Data.
+ * @param p Position.
+ * @returns True.
+ */
+function skipStrU(d: Uint8Array, p: [number]): true {
+	let [i] = p;
+	while (unquoted(d[++i]));
+	p[0] = i;
+	return true;
+}
+
 /**
  * Decode OpenStep plist options.
  */
-export interface DecodeOpenStepOptions {
+export interface DecodeOpenStepOptions extends BudgetOptions, TraceOptions {
 	/**
 	 * Allow missing semicolon on the last dictionary item.
 	 *
@@ -253,61 +313,138 @@ export interface DecodeOpenStepResult {
 }
 
 /**
- * Decode OpenStep encoded plist.
+ * Validate OpenStep plist result.
+ */
+export interface ValidateOpenStepResult {
+	/**
+	 * Encoded format.
+	 */
+	format: typeof FORMAT_OPENSTEP | typeof FORMAT_STRINGS;
+
+	/**
+	 * Number of objects, counting keys, shared objects once.
+	 */
+	objects: number;
+
+	/**
+	 * Maximum depth of nested collections.
+	 */
+	depth: number;
+}
+
+/**
+ * Decode OpenStep encoded plist, yielding bytes decoded every step values.
  *
  * @param encoded OpenStep plist encoded data.
  * @param options Decoding options.
- * @returns Decode result.
+ * @param step Values between yields, 0 for none.
+ * @param s Objects and depth, to only validate, or null.
+ * @param t Phase start times, to trace, or null.
+ * @yields Bytes decoded.
+ * @returns Decode result, without a plist when validating.
  */
-export function decodeOpenStep(
+function* openstep(
 	encoded: ArrayBufferView | ArrayBufferLike,
 	{
 		allowMissingSemi = false,
 		utf16le,
 		decoded = false,
-	}: Readonly<DecodeOpenStepOptions> = {},
-): DecodeOpenStepResult {
+		...b
+	}: Readonly<DecodeOpenStepOptions>,
+	step: number,
+	s: [objects: number, depth: number] | null,
+	t: number[] | null,
+): Generator<number, DecodeOpenStepResult, void> {
+	const [maxDepth, maxObjects, maxBytes, maxLength] = budget(b);
 	let d = bytes(encoded);
 	let p: [number];
 	let format: DecodeOpenStepResult['format'] = FORMAT_OPENSTEP;
 	let n: Node | null = null;
 	let semi;
 	let e;
-	let plist;
+	let plist: PLType | true | undefined;
+	let o = 0;
+	let y = step || -1;
+	let depth = 1;
+	let count = 1;
+	let size = 0;
+	let x;
 	let c = (
 		utf8Length(d = decoded ? d : utf8Encoded(d, utf16le) || d),
+			t?.push(performance.now()),
 			next(d, p = [0])
 	);
+	if (s) {
+		s[0] = 1;
+	}
+	if (!maxObjects) {
+		throw new BudgetError(utf8ErrorBudget(d, p[0], 'maxObjects'));
+	}
 	if (c < 0) {
-		return { format: FORMAT_STRINGS, plist: new PLDictionary() };
+		if (!maxDepth) {
+			throw new BudgetError(utf8ErrorBudget(d, p[0], 'maxDepth'));
+		}
+		if (s) {
+			s[1] = 1;
+		}
+		return {
+			format: FORMAT_STRINGS,
+			plist: (s ? true : new PLDictionary()) as PLType,
+		};
 	}
+	x = p[0];
 	if (c === 34 || c === 39) {
-		plist = decodeStrQ(d, p, c);
+		plist = s ? skipStrQ(d, p, c) : decodeStrQ(d, p, c);
+		size = p[0] - x - 2;
 	} else if (unquoted(c)) {
-		plist = decodeStrU(d, p);
+		plist = s ? skipStrU(d, p) : decodeStrU(d, p);
+		size = p[0] - x;
 	}
 	if (plist) {
+		if (size > maxBytes) {
+			throw new BudgetError(utf8ErrorBudget(d, x, 'maxBytes'));
+		}
 		c = next(d, p);
 		if (c < 0) {
-			return { format, plist };
+			return { format, plist: plist as PLType };
 		}
 		if (c === 59 || c === 61) {
-			n = { o: plist = new PLDictionary(), e: e = -1, n };
-			p[0] = 0;
+			n = {
+				o: plist = s ? true : new PLDictionary(),
+				e: e = -1,
+				l: 0,
+				n,
+			};
+			p[0] = size = 0;
 			format = FORMAT_STRINGS;
 		}
 	} else if (c === 60) {
-		plist = decodeData(d, p);
+		plist = decodeData(d, p, !!s);
+		if (p[0] - x - 2 > maxBytes) {
+			throw new BudgetError(utf8ErrorBudget(d, x, 'maxBytes'));
+		}
 	} else if (c === 123) {
-		n = { o: plist = new PLDictionary(), e: e = 125, n };
+		n = { o: plist = s ? true : new PLDictionary(), e: e = 125, l: 0, n };
 		p[0]++;
 	} else if (c === 40) {
-		n = { o: plist = new PLArray(), e: e = 41, n };
+		n = { o: plist = s ? true : new PLArray(), e: e = 41, l: 0, n };
 		p[0]++;
 	} else {
 		throw new SyntaxError(utf8ErrorToken(d, p[0]));
 	}
+	if (n) {
+		if (!maxDepth) {
+			throw new BudgetError(utf8ErrorBudget(d, x, 'maxDepth'));
+		}
+		if (s) {
+			s[1] = 1;
+		}
+	}
 	while (n) {
+		if (++o === y) {
+			yield p[0];
+			y += step;
+		}
 		if (semi) {
 			c = next(d, p);
 			if (e === 41) {
@@ -322,7 +459,7 @@ export function decodeOpenStep(
 				} else if (c === 125) {
 					semi = allowMissingSemi;
 				} else if ((semi = allowMissingSemi && e! < 0)) {
-					return { format, plist };
+					return { format, plist: plist as PLType };
 				}
 			}
 			if (!semi) {
@@ -335,7 +472,7 @@ export function decodeOpenStep(
 		c = next(d, p);
 		if ((semi = c < 0)) {
 			if (e! < 0) {
-				return { format, plist };
+				return { format, plist: plist as PLType };
 			}
 			throw new SyntaxError(utf8ErrorEnd(d));
 		}
@@ -344,28 +481,50 @@ export function decodeOpenStep(
 			if ((n = n.n)) {
 				semi = plist = n.o;
 				e = n.e;
+				depth--;
 			}
 			continue;
 		}
 		let key;
 		let val;
+		if (++n.l > maxLength) {
+			throw new BudgetError(utf8ErrorBudget(d, p[0], 'maxLength'));
+		}
 		if (e !== 41) {
+			x = p[0];
 			if (c === 34 || c === 39) {
-				key = decodeStrQ(d, p, c);
+				key = s ? skipStrQ(d, p, c) : decodeStrQ(d, p, c);
+				size += p[0] - x - 2;
 			} else if (unquoted(c)) {
-				key = decodeStrU(d, p);
+				key = s ? skipStrU(d, p) : decodeStrU(d, p);
+				size += p[0] - x;
 			} else if (e! < 0) {
-				return { format, plist };
+				return { format, plist: plist as PLType };
 			} else {
 				throw new SyntaxError(utf8ErrorToken(d, p[0]));
 			}
+			if (size > maxBytes) {
+				throw new BudgetError(utf8ErrorBudget(d, x, 'maxBytes'));
+			}
 			c = next(d, p);
 			if (c !== 61) {
 				if (c < 0) {
 					throw new SyntaxError(utf8ErrorEnd(d));
 				}
 				if (c === 59) {
-					(plist as PLDictionary).set(key, key);
+					if (++count > maxObjects) {
+						throw new BudgetError(
+							utf8ErrorBudget(d, x, 'maxObjects'),
+						);
+					}
+					if (s) {
+						s[0]++;
+					} else {
+						maps.get(plist as PLDictionary)!.set(
+							key,
+							key as PLString,
+						);
+					}
 					p[0]++;
 					continue;
 				}
@@ -377,33 +536,120 @@ export function decodeOpenStep(
 				throw new SyntaxError(utf8ErrorEnd(d));
 			}
 		}
+		x = p[0];
 		if (c === 34 || c === 39) {
-			semi = val = decodeStrQ(d, p, c);
+			semi = val = s ? skipStrQ(d, p, c) : decodeStrQ(d, p, c);
+			size += p[0] - x - 2;
 		} else if (unquoted(c)) {
-			semi = val = decodeStrU(d, p);
+			semi = val = s ? skipStrU(d, p) : decodeStrU(d, p);
+			size += p[0] - x;
 		} else if (c === 60) {
-			semi = val = decodeData(d, p);
+			semi = val = decodeData(d, p, !!s);
+			size += p[0] - x - 2;
 		} else if (c === 123) {
-			n = { o: val = new PLDictionary(), e: e = 125, n };
+			n = {
+				o: val = s ? true : new PLDictionary(),
+				e: e = 125,
+				l: 0,
+				n,
+			};
 			p[0]++;
 		} else if (c === 40) {
-			n = { o: val = new PLArray(), e: e = 41, n };
+			n = { o: val = s ? true : new PLArray(), e: e = 41, l: 0, n };
 			p[0]++;
 		} else {
 			throw new SyntaxError(utf8ErrorToken(d, p[0]));
 		}
-		if (key) {
-			(plist as PLDictionary).set(key, val);
+		if (size > maxBytes) {
+			throw new BudgetError(utf8ErrorBudget(d, x, 'maxBytes'));
+		}
+		if ((count += key ? 2 : 1) > maxObjects) {
+			throw new BudgetError(utf8ErrorBudget(d, x, 'maxObjects'));
+		}
+		if (s) {
+			s[0] += key ? 2 : 1;
+		} else if (key) {
+			maps.get(plist as PLDictionary)!.set(
+				key as PLString,
+				val as PLType,
+			);
 		} else {
-			(plist as PLArray).push(val);
+			arrays.get(plist as PLArray)!.push(val as PLType);
 		}
 		if (!semi) {
 			plist = val;
+			if (++depth > maxDepth) {
+				throw new BudgetError(utf8ErrorBudget(d, x, 'maxDepth'));
+			}
+			if (s && depth > s[1]) {
+				s[1] = depth;
+			}
 		}
 	}
 	c = next(d, p);
 	if (c < 0) {
-		return { format, plist };
+		return { format, plist: plist as PLType };
 	}
 	throw new SyntaxError(utf8ErrorToken(d, p[0]));
 }
+
+/**
+ * Decode OpenStep encoded plist.
+ *
+ * @param encoded OpenStep plist encoded data.
+ * @param options Decoding options.
+ * @returns Decode result.
+ */
+export function decodeOpenStep(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	options: Readonly<DecodeOpenStepOptions> = {},
+): DecodeOpenStepResult {
+	return sync(
+		traceDecode(
+			options,
+			phases,
+			encoded,
+			(t) => openstep(encoded, options, 0, null, t),
+		),
+	);
+}
+
+/**
+ * Decode OpenStep encoded plist, without blocking the event loop.
+ *
+ * @param encoded OpenStep plist encoded data.
+ * @param options Decoding and async options.
+ * @returns Decode result.
+ */
+export function decodeOpenStepAsync(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	options: Readonly<DecodeOpenStepOptions & AsyncOptions> = {},
+): Promise<DecodeOpenStepResult> {
+	return sliced(
+		(step) =>
+			traceDecode(
+				options,
+				phases,
+				encoded,
+				(t) => openstep(encoded, options, step, null, t),
+			),
+		options,
+	);
+}
+
+/**
+ * Validate OpenStep encoded plist, without decoding any objects.
+ * Throws the same errors as decoding.
+ *
+ * @param encoded OpenStep plist encoded data.
+ * @param options Decoding options.
+ * @returns Validate result.
+ */
+export function validateOpenStep(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	options: Readonly<DecodeOpenStepOptions> = {},
+): ValidateOpenStepResult {
+	const s: [number, number] = [0, 0];
+	const { format } = sync(openstep(encoded, options, 0, s, null));
+	return { format, objects: s[0], depth: s[1] };
+}
@@ -0,0 +1,28 @@
+import { encodeXml } from '../encode/xml.ts';
+import { benchFixtures, benchFuzzed, benchPlists } from '../spec/bench.ts';
+import { decodeXml } from './xml.ts';
+
+const fixtures = benchFixtures('xml', decodeXml);
+
+Deno.bench('decodeXml: fixtures', { group: 'fixtures' }, () => {
+	for (const encoded of fixtures) {
+		decodeXml(encoded);
+	}
+});
+
+for (const [name, plist] of benchPlists()) {
+	const encoded = encodeXml(plist);
+	Deno.bench(`decodeXml: ${name}`, { group: name }, () => {
+		decodeXml(encoded);
+	});
+}
+
+for (const [name, encoded] of benchFuzzed('xml')) {
+	Deno.bench(`decodeXml: fuzz ${name}`, { group: 'fuzz' }, () => {
+		try {
+			decodeXml(encoded);
+		} catch {
+			// Invalid input, timed to the error.
+		}
+	});
+}
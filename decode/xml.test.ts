@@ -3,6 +3,7 @@ import {
 	assertEquals,
 	assertInstanceOf,
 	assertNotStrictEquals,
+	assertStrictEquals,
 	assertThrows,
 } from '@std/assert';
 import { fixturePlist } from '../spec/fixture.ts';
@@ -13,11 +14,12 @@ import { PLDate } from '../date.ts';
 import { PLDictionary } from '../dictionary.ts';
 import { FORMAT_XML_V0_9, FORMAT_XML_V1_0 } from '../format.ts';
 import { PLInteger } from '../integer.ts';
+import { lazies } from '../pri/data.ts';
 import { PLReal } from '../real.ts';
 import { PLString } from '../string.ts';
 import type { PLType } from '../type.ts';
 import { PLUID } from '../uid.ts';
-import { decodeXml, type DecodeXmlOptions } from './xml.ts';
+import { decodeXml, type DecodeXmlOptions, validateXml } from './xml.ts';
 
 const CF_STYLE = {
 	// Integers are limited to 64-bit signed or unsigned values range.
@@ -72,6 +74,89 @@ Deno.test('Option: decoded', () => {
 	}
 });
 
+Deno.test('Option: lazy', () => {
+	for (
+		const [s, c] of [
+			['', true],
+			['YQ==', true],
+			['YWI=', true],
+			['YWJj', true],
+			['\n\tYWJj\n\tZA==\n', true],
+			['YR==', false],
+			['YWJ=', false],
+			['YQ', false],
+			['YQ===', false],
+			['YQ==YQ==', false],
+			['Y-Q==', false],
+			['Y\x01Q==', false],
+		] as const
+	) {
+		const tag = JSON.stringify(s);
+		const data = TE.encode(
+			[
+				DOCTYPE,
+				'<plist version="1.0">',
+				`<data>${s}</data>`,
+				'</plist>',
+				'',
+			].join('\n'),
+		);
+		const eager = decodeXml(data).plist;
+		const { plist } = decodeXml(data, { lazy: true });
+		assertInstanceOf(eager, PLData, tag);
+		assertInstanceOf(plist, PLData, tag);
+		assertEquals(lazies.get(plist)?.c, c, tag);
+		assertEquals(plist.byteLength, eager.byteLength, tag);
+		assertEquals(plist.byteOffset, 0, tag);
+		assert(lazies.has(plist), tag);
+		assertEquals(
+			new Uint8Array(plist.buffer),
+			new Uint8Array(eager.buffer),
+			tag,
+		);
+		assertEquals(lazies.has(plist), false, tag);
+		assertStrictEquals(plist.buffer, plist.buffer, tag);
+	}
+});
+
+Deno.test('validateXml', async () => {
+	assertEquals(validateXml(await fixturePlist('dict-nesting', 'xml')), {
+		format: FORMAT_XML_V1_0,
+		objects: 29,
+		depth: 3,
+	});
+	assertEquals(
+		validateXml(TE.encode('<plist version="0.9"><array/></plist>')),
+		{ format: FORMAT_XML_V0_9, objects: 1, depth: 1 },
+	);
+	for (
+		const xml of [
+			'<plist><string>a&bad;</string></plist>',
+			'<plist><integer>0x10000000000000000</integer></plist>',
+			'<plist><real>x</real></plist>',
+			'<plist><data>AA==',
+			'<plist><date>2001-01-01</date></plist>',
+			'<plist><dict><string>a</string></dict></plist>',
+			'<plist><true/><true/></plist>',
+		]
+	) {
+		const data = TE.encode(xml);
+		let error;
+		try {
+			decodeXml(data, { int64: true });
+		} catch (err) {
+			error = err as Error;
+		}
+		assert(error, xml);
+		assertThrows(
+			() => validateXml(data, { int64: true }),
+			error.constructor as ErrorConstructor,
+			error.message,
+			xml,
+		);
+	}
+});
+
 Deno.test('XML encoding: default', () => {
 	const options = {
 		decoder(encoding: string): Uint8Array | null {
@@ -183,6 +268,11 @@ Deno.test('XML encoding: Error EOF', () => {
 		SyntaxError,
 		'Invalid end on line 1',
 	);
+	assertThrows(
+		() => decodeXml(TE.encode('<?xml version="1.0" encoding="UTF-')),
+		SyntaxError,
+		'Invalid end on line 1',
+	);
 });
 
 Deno.test('XML encoding: custom', () => {
@@ -2318,6 +2408,13 @@ Deno.test('spec: integer-sizes', async () => {
 		assertInstanceOf(v, PLInteger, `${i}`);
 		const expected = BigInt.asIntN(64, BigInt(k.value));
 		assertEquals(v.value, expected, k.value);
+		assertStrictEquals(
+			v.compact,
+			Number.isSafeInteger(Number(expected))
+				? Number(expected)
+				: expected,
+			k.value,
+		);
 		i++;
 	}
 });
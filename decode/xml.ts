@@ -5,30 +5,50 @@
  */
 
 import { PLArray } from '../array.ts';
+import type { AsyncOptions } from '../async.ts';
+import { BudgetError, type BudgetOptions } from '../budget.ts';
 import { PLBoolean } from '../boolean.ts';
 import { PLData } from '../data.ts';
 import { PLDate } from '../date.ts';
 import { PLDictionary } from '../dictionary.ts';
 import { FORMAT_XML_V0_9, FORMAT_XML_V1_0 } from '../format.ts';
 import { PLInteger, PLTYPE_INTEGER } from '../integer.ts';
-import { b16d, b64d } from '../pri/base.ts';
-import { bytes } from '../pri/data.ts';
+import { arrays } from '../pri/array.ts';
+import { sliced, sync } from '../pri/async.ts';
+import { b16d, b64d, b64Decode } from '../pri/base.ts';
+import { budget } from '../pri/budget.ts';
+import { bytes, lazies } from '../pri/data.ts';
 import { getTime } from '../pri/date.ts';
+import { maps } from '../pri/dictionary.ts';
+import { traceDecode } from '../pri/trace.ts';
 import {
 	utf8Decode,
 	utf8Encoded,
+	utf8ErrorBudget,
 	utf8ErrorEnd,
 	utf8ErrorXML,
 	utf8Length,
 } from '../pri/utf8.ts';
 import { PLReal, PLTYPE_REAL } from '../real.ts';
 import { PLString } from '../string.ts';
+import type { TraceOptions } from '../trace.ts';
 import type { PLType } from '../type.ts';
 import { PLUID } from '../uid.ts';
 
+/**
+ * Trace phases.
+ */
+const phases = ['decode', 'parse'] as const;
+
+const I64_MIN = 0x8000000000000000n;
+const U64_MAX = 0xffffffffffffffffn;
+const I128_MIN = 0x80000000000000000000000000000000n;
+const I128_MAX = 0x7fffffffffffffffffffffffffffffffn;
+
 const rUTF8 = /^(x-mac-)?utf-8$/i;
 const rREAL = /^[\de.+-]+$/i;
 const rRLWS = /^[\0-\x20\x7F-\xA0\u2000-\u200B\u3000]+/;
+const EMPTY = new ArrayBuffer(0);
 
 /**
  * Check if whitespace character.
@@ -83,9 +103,14 @@ interface Node {
 	s: number;
 
 	/**
-	 * Plist object.
+	 * Plist object, or true when validating.
+	 */
+	p: PLArray | PLDictionary | Plist | true;
+
+	/**
+	 * Number of entries.
 	 */
-	p: PLArray | PLDictionary | Plist;
+	l: number;
 
 	/**
 	 * Next node.
@@ -126,7 +151,7 @@ function encoding(d: Uint8Array): string | null {
 			) {
 				c = d[i++];
 				if (c === 39 || c === 34) {
-					for (j = i; i < l; j++) {
+					for (j = i; j < l; j++) {
 						if (d[j] === c) {
 							return String.fromCharCode(...d.subarray(i, j));
 						}
@@ -230,9 +255,9 @@ function doctype(d: Uint8Array, i: number, l: number): number {
  * @param d Data.
  * @param p Offset pointer.
  * @param l Length.
- * @returns Date.
+ * @returns Time.
  */
-function date(d: Uint8Array, p: [number], l: number): PLDate {
+function date(d: Uint8Array, p: [number], l: number): number {
 	let [i] = p;
 	let c = d[i];
 	let n;
@@ -322,7 +347,7 @@ function date(d: Uint8Array, p: [number], l: number): PLDate {
 			break;
 		}
 		p[0] = i;
-		return new PLDate(getTime(n ? (-Y) | 0 : Y, M, D, h, m, s));
+		return getTime(n ? (-Y) | 0 : Y, M, D, h, m, s);
 	}
 	throw new SyntaxError(i < l ? utf8ErrorXML(d, i) : utf8ErrorEnd(d));
 }
@@ -333,60 +358,47 @@ function date(d: Uint8Array, p: [number], l: number): PLDate {
  * @param d Data.
  * @param p Offset pointer.
  * @param l Length.
+ * @param z Truthy to decode lazily.
  * @returns Data.
  */
-function data(d: Uint8Array, p: [number], l: number): PLData {
+function data(
+	d: Uint8Array,
+	p: [number],
+	l: number,
+	z: boolean,
+): PLData {
 	for (
-		let [i] = p, a = 0, e = 0, s = 0, t = 0, h = i, b, c, o, r;
+		let [i] = p, e = 0, k = 0, s = 0, t = 0, v = 0, h = i, b, c, r;
 		i < l;
 		i++
 	) {
 		c = d[i];
 		if (c > 42 && c < 123) {
-			if ((b64d[c - 43] + c - 80) < 0) {
+			if ((b = b64d[c - 43] + c - 80) < 0) {
 				if (c !== 61) {
-					e = 0;
 					if (c !== 60) {
+						e = 0;
+						k = 1;
 						continue;
 					}
-					o = new Uint8Array(r = new ArrayBuffer(s));
-					r = new PLData(r);
-					for (a = s = t = 0, i = h;; i++) {
-						c = d[i];
-						if (c > 42 && c < 123) {
-							b = b64d[c - 43] + c - 80;
-							if (b < 0) {
-								if (c !== 61) {
-									e = 0;
-									if (c !== 60) {
-										continue;
-									}
-									p[0] = i;
-									return r!;
-								}
-								e++;
-								b = 0;
-							} else {
-								e = 0;
-							}
-							a = a << 6 | b;
-							if (++t & 4) {
-								o[s++] = a >> 16 & 255;
-								if (e < 2) {
-									o[s++] = a >> 8 & 255;
-									if (!e) {
-										o[s++] = a & 255;
-									}
-								}
-								t = 0;
-							}
-						} else if (!ws(c)) {
-							e = 0;
-						}
+					p[0] = i;
+					if (!z) {
+						return new PLData(b64Decode(d, h, i, s));
 					}
+					lazies.set(r = new PLData(EMPTY), {
+						d,
+						i: h,
+						e: i,
+						s,
+						c: !(k || t || e > 2 || v & (e > 1 ? 15 : e ? 3 : 0)),
+						f: b64Decode,
+					});
+					return r;
 				}
 				e++;
 			} else {
+				k ||= e;
+				v = b;
 				e = 0;
 			}
 			if (++t & 4) {
@@ -395,6 +407,7 @@ function data(d: Uint8Array, p: [number], l: number): PLData {
 			}
 		} else if (!ws(c)) {
 			e = 0;
+			k = 1;
 		}
 	}
 	throw new SyntaxError(utf8ErrorEnd(d));
@@ -407,17 +420,17 @@ function data(d: Uint8Array, p: [number], l: number): PLData {
  * @param p Offset pointer.
  * @param l Length.
  * @param z Truthy to limit to 64-bit signed or unsigned.
- * @returns Integer.
+ * @returns Integer, as number when a safe integer.
  */
 function integer(
 	d: Uint8Array,
 	p: [number],
 	l: number,
-	m: boolean | number | bigint,
-): bigint {
+	z: boolean,
+): number | bigint {
 	let x;
 	let n;
-	let r = 0n;
+	let r: number | bigint = 0;
 	let i = whitespace(d, p[0]);
 	let c = d[i];
 	c = c === 45
@@ -425,12 +438,19 @@ function integer(
 		: c === 43
 		? d[i = whitespace(d, i + 1)]
 		: c;
-	m = (1n << (m ? n ? 63n : 64n : 127n)) - (n ? r : 1n);
+	const m = z ? n ? I64_MIN : U64_MAX : n ? I128_MIN : I128_MAX;
 	if ((x = c === 48) && ((c = d[++i]) === 120 || c === 88)) {
 		c = d[++i];
 		do {
 			x = b16d(c);
-			if (x < 0 || (r = r << 4n | BigInt(x)) > m) {
+			if (
+				x < 0 ||
+				(
+					typeof r === 'number' && r < 0x1000000000000
+						? (r = r * 16 + x, false)
+						: (r = BigInt(r) << 4n | BigInt(x)) > m
+				)
+			) {
 				throw new SyntaxError(
 					i < l ? utf8ErrorXML(d, i) : utf8ErrorEnd(d),
 				);
@@ -438,7 +458,14 @@ function integer(
 		} while ((c = d[++i]) !== 60);
 	} else if (c !== 60 || !x) {
 		do {
-			if (!(c > 47 && c < 58) || (r = r * 10n + BigInt(c - 48)) > m) {
+			if (
+				!(c > 47 && c < 58) ||
+				(
+					typeof r === 'number' && r < 900719925474099
+						? (r = r * 10 + c - 48, false)
+						: (r = BigInt(r) * 10n + BigInt(c - 48)) > m
+				)
+			) {
 				throw new SyntaxError(
 					i < l ? utf8ErrorXML(d, i) : utf8ErrorEnd(d),
 				);
@@ -486,16 +513,21 @@ function real(d: Uint8Array, p: [number], l: number): number {
  * @param d Data.
  * @param p Offset pointer.
  * @param l Length.
- * @returns String.
+ * @param v Truthy to only validate.
+ * @returns String, or empty when validating.
  */
-function string(d: Uint8Array, p: [number], l: number): string {
+function string(d: Uint8Array, p: [number], l: number, v = false): string {
 	let r = '', [i] = p, j = i, a, b, c;
 	for (; i < l; i++) {
 		c = d[i];
 		if (c === 60) {
 			c = d[i + 1];
 			if (c === 47) {
-				r += utf8Decode(d, j, i);
+				if (v) {
+					utf8Length(d, j, i);
+				} else {
+					r += utf8Decode(d, j, i);
+				}
 				p[0] = i;
 				return r;
 			}
@@ -509,13 +541,21 @@ function string(d: Uint8Array, p: [number], l: number): string {
 				d[i + 7] === 65 &&
 				d[i + 8] === 91
 			) {
-				r += utf8Decode(d, j, i);
+				if (v) {
+					utf8Length(d, j, i);
+				} else {
+					r += utf8Decode(d, j, i);
+				}
 				for (j = i += 9; i < l; i++) {
 					a = b;
 					b = c;
 					c = d[i];
 					if (c === 62 && b === 93 && a === 93) {
-						r += utf8Decode(d, j, i - 2);
+						if (v) {
+							utf8Length(d, j, i - 2);
+						} else {
+							r += utf8Decode(d, j, i - 2);
+						}
 						j = i + 1;
 						break;
 					}
@@ -529,7 +569,11 @@ function string(d: Uint8Array, p: [number], l: number): string {
 				++i < l ? utf8ErrorXML(d, i) : utf8ErrorEnd(d),
 			);
 		} else if (c === 38) {
-			r += utf8Decode(d, j, i);
+			if (v) {
+				utf8Length(d, j, i);
+			} else {
+				r += utf8Decode(d, j, i);
+			}
 			c = d[++i];
 			b = -1;
 			if (c === 97) {
@@ -603,7 +647,9 @@ function string(d: Uint8Array, p: [number], l: number): string {
 					i < l ? utf8ErrorXML(d, i) : utf8ErrorEnd(d),
 				);
 			}
-			r += String.fromCharCode(b);
+			if (!v) {
+				r += String.fromCharCode(b);
+			}
 			j = i + 1;
 		}
 	}
@@ -626,7 +672,7 @@ export type DecodeXmlDecoder = (
 /**
  * Decode XML plist options.
  */
-export interface DecodeXmlOptions {
+export interface DecodeXmlOptions extends BudgetOptions, TraceOptions {
 	/**
 	 * Flag to skip decoding and assume UTF-8 without BOM.
 	 *
@@ -646,6 +692,15 @@ export interface DecodeXmlOptions {
 	 */
 	int64?: boolean;
 
+	/**
+	 * Optionally defer decoding data until the buffer is first accessed.
+	 * Data is still validated, but holds a reference to the encoded data.
+	 * Untouched canonical data is passed through as is by the XML encoder.
+	 *
+	 * @default false
+	 */
+	lazy?: boolean;
+
 	/**
 	 * Optional UTF-16 endian flag when no BOM available.
 	 * Defaults to auto detect.
@@ -669,21 +724,51 @@ export interface DecodeXmlResult {
 }
 
 /**
- * Decode OpenStep encoded plist.
+ * Validate XML plist result.
+ */
+export interface ValidateXmlResult {
+	/**
+	 * Encoded format.
+	 */
+	format: typeof FORMAT_XML_V1_0 | typeof FORMAT_XML_V0_9;
+
+	/**
+	 * Number of objects, counting keys, shared objects once.
+	 */
+	objects: number;
+
+	/**
+	 * Maximum depth of nested collections.
+	 */
+	depth: number;
+}
+
+/**
+ * Decode XML encoded plist, yielding bytes decoded every step elements.
  *
- * @param encoded OpenStep plist encoded data.
+ * @param encoded XML plist encoded data.
  * @param options Decoding options.
- * @returns Decode result.
+ * @param step Elements between yields, 0 for none.
+ * @param s Objects and depth, to only validate, or null.
+ * @param t Phase start times, to trace, or null.
+ * @yields Bytes decoded.
+ * @returns Decode result, without a plist when validating.
  */
-export function decodeXml(
+function* xml(
 	encoded: ArrayBufferView | ArrayBufferLike,
 	{
 		decoder,
 		utf16le,
 		int64 = false,
+		lazy = false,
 		decoded = false,
-	}: Readonly<DecodeXmlOptions> = {},
-): DecodeXmlResult {
+		...b
+	}: Readonly<DecodeXmlOptions>,
+	step: number,
+	s: [objects: number, depth: number] | null,
+	t: number[] | null,
+): Generator<number, DecodeXmlResult, void> {
+	const [maxDepth, maxObjects, maxBytes, maxLength] = budget(b);
 	let x;
 	let d = bytes(encoded);
 	let keyed;
@@ -699,21 +784,28 @@ export function decodeXml(
 		}
 		d = keyed ? bytes(keyed) : d;
 	}
+	t?.push(performance.now());
 	const l = d.length;
 	const p: [number] = [0];
 	let i = 0;
 	let key: PLString | null = null;
 	let n: Node | null = null;
+	let pN: Node | null = null;
 	let c;
 	let sc;
 	let obj;
 	let tagI;
 	let tagL;
 	let cId;
-	let cObj: PLArray | PLDictionary | Plist;
+	let cObj: PLArray | PLDictionary | Plist | true;
 	let pId;
 	let pObj: typeof cObj;
 	let format: DecodeXmlResult['format'] = FORMAT_XML_V1_0;
+	let o = 0;
+	let y = step || -1;
+	let depth = 0;
+	let count = 0;
+	let size = 0;
 	keyed = new Map<PLDictionary, PLString>();
 	for (;;) {
 		c = d[i = whitespace(d, i)];
@@ -732,6 +824,10 @@ export function decodeXml(
 		}
 	}
 	for (;;) {
+		if (++o === y) {
+			yield i;
+			y += step;
+		}
 		if (c === 47) {
 			if (!n || key) {
 				throw new SyntaxError(utf8ErrorXML(d, i));
@@ -747,6 +843,9 @@ export function decodeXml(
 			++i;
 			n = x.n;
 			sc = x.a;
+			if (sc !== 112) {
+				depth--;
+			}
 			if (sc === 100) {
 				sc = obj = x.p as PLDictionary;
 				if (obj.size === 1 && (x = obj.find(cfuid))) {
@@ -771,12 +870,13 @@ export function decodeXml(
 				cObj = n.p;
 				if (sc !== obj) {
 					if (cId === 100) {
-						(cObj as PLDictionary).set(keyed.get(sc)!, obj);
-					} else if (cId === 97) {
-						(cObj as PLArray).set(
-							(cObj as PLArray).length - 1,
+						maps.get(cObj as PLDictionary)!.set(
+							keyed.get(sc)!,
 							obj,
 						);
+					} else if (cId === 97) {
+						const a = arrays.get(cObj as PLArray)!;
+						a[a.length - 1] = obj;
 					} else if (cId === 112) {
 						(cObj as Plist).v = obj;
 					}
@@ -793,10 +893,10 @@ export function decodeXml(
 				}
 				cId = n.a;
 				cObj = n.p;
-				if (cId === 100) {
-					(cObj as PLDictionary).set(x.k!, obj);
-				} else if (cId === 97) {
-					(cObj as PLArray).push(obj);
+				if (cId === 100 && !s) {
+					maps.get(cObj as PLDictionary)!.set(x.k!, obj);
+				} else if (cId === 97 && !s) {
+					arrays.get(cObj as PLArray)!.push(obj);
 				} else if (cId === 112) {
 					(cObj as Plist).v = obj;
 				}
@@ -829,6 +929,7 @@ export function decodeXml(
 			x = i++;
 			pId = cId!;
 			pObj = cObj!;
+			pN = n;
 			switch (c) {
 				case 97: {
 					if (
@@ -837,8 +938,17 @@ export function decodeXml(
 						d[tagI + 3] === 97 &&
 						d[tagI + 4] === 121
 					) {
-						obj = new PLArray();
+						obj = s ? true : new PLArray();
+						if (depth >= maxDepth) {
+							throw new BudgetError(
+								utf8ErrorBudget(d, tagI, 'maxDepth'),
+							);
+						}
+						if (s && depth >= s[1]) {
+							s[1] = depth + 1;
+						}
 						if (!sc) {
+							depth++;
 							cId = c;
 							cObj = obj;
 							sc = n = {
@@ -846,6 +956,7 @@ export function decodeXml(
 								t: tagI,
 								s: tagL,
 								p: cObj,
+								l: 0,
 								n,
 							};
 						}
@@ -856,8 +967,17 @@ export function decodeXml(
 					x = d[tagI + 1];
 					if (x === 105) {
 						if (d[tagI + 2] === 99 && d[tagI + 3] === 116) {
-							obj = new PLDictionary();
+							obj = s ? true : new PLDictionary();
+							if (depth >= maxDepth) {
+								throw new BudgetError(
+									utf8ErrorBudget(d, tagI, 'maxDepth'),
+								);
+							}
+							if (s && depth >= s[1]) {
+								s[1] = depth + 1;
+							}
 							if (!sc) {
+								depth++;
 								cId = c;
 								cObj = obj;
 								sc = n = {
@@ -865,21 +985,32 @@ export function decodeXml(
 									t: tagI,
 									s: tagL,
 									p: cObj,
+									l: 0,
 									n,
 								};
-								if (key) {
+								if (key && obj !== true) {
 									keyed.set(obj, key);
 								}
 							}
 						}
 					} else if (!sc && x === 97 && d[tagI + 2] === 116) {
 						if (d[tagI + 3] === 97) {
-							p[0] = i;
-							obj = data(d, p, l);
-							i = p[0];
+							if (!s) {
+								p[0] = i;
+								obj = data(d, p, l, lazy);
+								size += p[0] - i;
+								i = p[0];
+							} else if ((x = d.indexOf(60, i)) < 0) {
+								throw new SyntaxError(utf8ErrorEnd(d));
+							} else {
+								size += x - i;
+								i = x;
+								obj = true;
+							}
 						} else if (d[tagI + 3] === 101) {
 							p[0] = i;
 							obj = date(d, p, l);
+							obj = s ? true : new PLDate(obj);
 							i = p[0];
 						}
 					}
@@ -892,7 +1023,7 @@ export function decodeXml(
 						d[tagI + 3] === 115 &&
 						d[tagI + 4] === 101
 					) {
-						obj = new PLBoolean(false);
+						obj = s ? true : new PLBoolean(false);
 					}
 					break;
 				}
@@ -906,9 +1037,13 @@ export function decodeXml(
 						d[tagI + 5] === 101
 					) {
 						p[0] = i;
-						obj = new PLInteger(
-							obj = integer(d, p, l, int64),
-							(obj < 0 ? ~obj : obj) >> 63n ? 128 : 64,
+						obj = integer(d, p, l, int64);
+						obj = s ? true : new PLInteger(
+							obj,
+							typeof obj === 'number' ||
+								!((obj < 0 ? ~obj : obj) >> 63n)
+								? 64
+								: 128,
 						);
 						i = p[0];
 					}
@@ -920,10 +1055,11 @@ export function decodeXml(
 							obj = '';
 						} else {
 							p[0] = i;
-							obj = string(d, p, l);
+							obj = string(d, p, l, !!s);
+							size += p[0] - i;
 							i = p[0];
 						}
-						obj = new PLString(obj);
+						obj = s ? true : new PLString(obj);
 					}
 					break;
 				}
@@ -972,6 +1108,7 @@ export function decodeXml(
 							t: tagI,
 							s: tagL,
 							p: cObj,
+							l: 0,
 							n,
 						};
 					}
@@ -985,7 +1122,8 @@ export function decodeXml(
 						d[tagI + 3] === 108
 					) {
 						p[0] = i;
-						obj = new PLReal(real(d, p, l), 64);
+						obj = real(d, p, l);
+						obj = s ? true : new PLReal(obj, 64);
 						i = p[0];
 					}
 					break;
@@ -1002,10 +1140,11 @@ export function decodeXml(
 							obj = '';
 						} else {
 							p[0] = i;
-							obj = string(d, p, l);
+							obj = string(d, p, l, !!s);
+							size += p[0] - i;
 							i = p[0];
 						}
-						obj = new PLString(obj);
+						obj = s ? true : new PLString(obj);
 					}
 					break;
 				}
@@ -1015,7 +1154,7 @@ export function decodeXml(
 						d[tagI + 2] === 117 &&
 						d[tagI + 3] === 101
 					) {
-						obj = new PLBoolean(true);
+						obj = s ? true : new PLBoolean(true);
 					}
 					break;
 				}
@@ -1023,6 +1162,9 @@ export function decodeXml(
 			if (!obj) {
 				throw new SyntaxError(utf8ErrorXML(d, tagI));
 			}
+			if (size > maxBytes) {
+				throw new BudgetError(utf8ErrorBudget(d, tagI, 'maxBytes'));
+			}
 			if (!sc) {
 				if (d[i] === 60 && d[++i] === 47) {
 					for (sc = tagI, ++i; tagL && d[i] === d[sc++]; ++i, tagL--);
@@ -1034,10 +1176,25 @@ export function decodeXml(
 				}
 				++i;
 			}
+			if (c !== 112) {
+				if (++count > maxObjects) {
+					throw new BudgetError(
+						utf8ErrorBudget(d, tagI, 'maxObjects'),
+					);
+				}
+				if (s) {
+					s[0]++;
+				}
+			}
 			if (pId === 100) {
 				if (key) {
-					if (c !== 112) {
-						(pObj as PLDictionary).set(key, obj as PLType);
+					if (++pN!.l > maxLength) {
+						throw new BudgetError(
+							utf8ErrorBudget(d, tagI, 'maxLength'),
+						);
+					}
+					if (c !== 112 && !s) {
+						maps.get(pObj as PLDictionary)!.set(key, obj as PLType);
 					}
 					key = null;
 				} else if (c === 107) {
@@ -1046,8 +1203,13 @@ export function decodeXml(
 					throw new SyntaxError(utf8ErrorXML(d, tagI));
 				}
 			} else if (pId === 97) {
-				if (c !== 112) {
-					(pObj as PLArray).push(obj as PLType);
+				if (++pN!.l > maxLength) {
+					throw new BudgetError(
+						utf8ErrorBudget(d, tagI, 'maxLength'),
+					);
+				}
+				if (c !== 112 && !s) {
+					arrays.get(pObj as PLArray)!.push(obj as PLType);
 				}
 			} else if (pId === 112) {
 				if (c !== 112) {
@@ -1080,3 +1242,64 @@ export function decodeXml(
 		}
 	}
 }
+
+/**
+ * Decode XML encoded plist.
+ *
+ * @param encoded XML plist encoded data.
+ * @param options Decoding options.
+ * @returns Decode result.
+ */
+export function decodeXml(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	options: Readonly<DecodeXmlOptions> = {},
+): DecodeXmlResult {
+	return sync(
+		traceDecode(
+			options,
+			phases,
+			encoded,
+			(t) => xml(encoded, options, 0, null, t),
+		),
+	);
+}
+
+/**
+ * Decode XML encoded plist, without blocking the event loop.
+ *
+ * @param encoded XML plist encoded data.
+ * @param options Decoding and async options.
+ * @returns Decode result.
+ */
+export function decodeXmlAsync(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	options: Readonly<DecodeXmlOptions & AsyncOptions> = {},
+): Promise<DecodeXmlResult> {
+	return sliced(
+		(step) =>
+			traceDecode(
+				options,
+				phases,
+				encoded,
+				(t) => xml(encoded, options, step, null, t),
+			),
+		options,
+	);
+}
+
+/**
+ * Validate XML encoded plist, without decoding any objects.
+ * Throws the same errors as decoding, lazy option is ignored.
+ *
+ * @param encoded XML plist encoded data.
+ * @param options Decoding options.
+ * @returns Validate result.
+ */
+export function validateXml(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	options: Readonly<DecodeXmlOptions> = {},
+): ValidateXmlResult {
+	const s: [number, number] = [0, 0];
+	const { format } = sync(xml(encoded, options, 0, s, null));
+	return { format, objects: s[0], depth: s[1] };
+}
@@ -4,10 +4,10 @@
  * Property list dictionary.
  */
 
+import { maps } from './pri/dictionary.ts';
+import { mutable } from './pri/mutate.ts';
 import type { PLType } from './type.ts';
 
-const maps = new WeakMap<PLDictionary, Map<PLType, PLType>>();
-
 /**
  * PLDictionary type.
  */
@@ -80,6 +80,7 @@ export class PLDictionary<
 		if (map.has(key)) {
 			return map.get(key)!;
 		}
+		mutable(this);
 		map.set(key, defaultValue);
 		return defaultValue;
 	}
@@ -96,6 +97,7 @@ export class PLDictionary<
 		if (map.has(key)) {
 			return map.get(key)!;
 		}
+		mutable(this);
 		const value = callback(key);
 		map.set(key, value);
 		return value;
@@ -108,6 +110,7 @@ export class PLDictionary<
 	 * @param value Value.
 	 */
 	public set(key: K, value: V): void {
+		mutable(this);
 		(maps.get(this) as Map<K, V>).set(key, value);
 	}
 
@@ -118,6 +121,7 @@ export class PLDictionary<
 	 * @returns Deleted.
 	 */
 	public delete(key: K): boolean {
+		mutable(this);
 		return (maps.get(this) as Map<K, V>).delete(key);
 	}
 
@@ -125,6 +129,7 @@ export class PLDictionary<
 	 * Clear dictionary.
 	 */
 	public clear(): void {
+		mutable(this);
 		(maps.get(this) as Map<K, V>).clear();
 	}
 
@@ -0,0 +1,333 @@
+import { assertEquals, assertStrictEquals, assertThrows } from '@std/assert';
+import { PLArray } from './array.ts';
+import { decodeBinary } from './decode/binary.ts';
+import { PLDictionary } from './dictionary.ts';
+import { applyPatch, diff, patchFromPlist, patchToPlist } from './diff.ts';
+import { encodeBinary } from './encode/binary.ts';
+import { PLInteger } from './integer.ts';
+import { equal } from './pri/hash.ts';
+import { PLReal } from './real.ts';
+import { PLSet } from './set.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+
+const str = (s: string) => new PLString(s);
+const int = (i: number) => new PLInteger(i);
+const list = (s: string) => new PLArray([...s].map(str));
+
+function clone(v: PLType): PLType {
+	if (PLArray.is(v)) {
+		return new PLArray(v.toArray().map(clone));
+	}
+	if (PLDictionary.is(v)) {
+		return new PLDictionary([...v].map(([k, v]) => [clone(k), clone(v)]));
+	}
+	if (PLSet.is(v)) {
+		return new PLSet([...v].map(clone));
+	}
+	if (PLString.is(v)) {
+		return str(v.value);
+	}
+	if (PLInteger.is(v)) {
+		return new PLInteger(v.value, v.bits);
+	}
+	if (PLReal.is(v)) {
+		return new PLReal(v.value, v.bits);
+	}
+	throw new Error('Unexpected');
+}
+
+function check(a: PLType, b: PLType) {
+	const patch = diff(a, b);
+	const before = clone(a);
+	const r = applyPatch(clone(a), patch);
+	assertEquals(equal(r, b, new WeakMap()), true);
+	assertEquals(equal(a, before, new WeakMap()), true);
+	assertEquals(diff(r, b), []);
+	return patch;
+}
+
+Deno.test('diff: identical', () => {
+	const a = new PLDictionary([[str('a'), list('abc')]]);
+	assertEquals(diff(a, a), []);
+	assertEquals(diff(a, clone(a)), []);
+	assertEquals(diff(a, new PLDictionary([[str('a'), list('abc')]])), []);
+});
+
+Deno.test('diff: root', () => {
+	const b = list('b');
+	const patch = check(str('a'), b);
+	assertEquals(patch.length, 1);
+	assertEquals(patch[0].op, 'set');
+	assertEquals(patch[0].path, []);
+	assertStrictEquals(patch[0].value, b);
+	assertStrictEquals(applyPatch(str('a'), patch), b);
+});
+
+Deno.test('diff: dictionary', () => {
+	const a = new PLDictionary<PLType, PLType>([
+		[str('same'), str('same')],
+		[str('change'), str('from')],
+		[str('delete'), str('delete')],
+		[int(1), str('integer')],
+	]);
+	const b = new PLDictionary<PLType, PLType>([
+		[int(1), str('integer')],
+		[str('add'), str('add')],
+		[str('change'), str('to')],
+		[str('same'), str('same')],
+	]);
+	const patch = check(a, b);
+	assertEquals(patch.map(({ op, path }) => [op, path.map(String)]), [
+		['set', ['change']],
+		['delete', ['delete']],
+		['set', ['add']],
+	]);
+});
+
+Deno.test('diff: dictionary duplicate keys', () => {
+	const a = new PLDictionary([[str('a'), str('1')], [str('a'), str('2')]]);
+	const b = new PLDictionary([[str('a'), str('1')], [str('a'), str('3')]]);
+	const patch = check(a, b);
+	assertEquals(patch.length, 1);
+	assertEquals(patch[0].path, []);
+});
+
+Deno.test('applyPatch: original keys', () => {
+	const keep = str('keep');
+	const drop = str('drop');
+	const a = new PLDictionary<PLType, PLType>([
+		[keep, str('1')],
+		[drop, str('2')],
+	]);
+	const b = new PLDictionary<PLType, PLType>([[keep, str('3')]]);
+	const r = applyPatch(a, diff(a, b));
+	assertStrictEquals(r, a);
+	assertEquals(equal(r, b, new WeakMap()), true);
+	assertEquals(a.size, 1);
+	assertStrictEquals(a.get(keep)?.valueOf(), '3');
+});
+
+Deno.test('diff: array', () => {
+	for (
+		const [a, b] of [
+			['', 'abc'],
+			['abc', ''],
+			['abc', 'abc'],
+			['abcdef', 'abXdef'],
+			['abcdef', 'acdf'],
+			['abcdef', 'aXbcdYef'],
+			['abcabba', 'cbabac'],
+			['abcdef', 'fabcde'],
+			['abcdef', 'bcdefa'],
+			['abcdef', 'fedcba'],
+			['aaaa', 'aa'],
+			['abcd', 'dcXba'],
+		]
+	) {
+		check(list(a), list(b));
+	}
+	assertEquals(
+		diff(list('abcdef'), list('abXdef')).map(({ op, path }) => [op, path]),
+		[['set', [2]]],
+	);
+	assertEquals(
+		diff(list('abcdef'), list('abcdXef')).map(({ op, path }) => [op, path]),
+		[['insert', [4]]],
+	);
+	assertEquals(
+		diff(list('abcdef'), list('abdef')).map(({ op, path }) => [op, path]),
+		[['delete', [2]]],
+	);
+	assertEquals(
+		diff(list('abcdef'), list('bcdefa')).map(({ op, path, from }) => [
+			op,
+			path,
+			from,
+		]),
+		[['move', [5], 0]],
+	);
+});
+
+Deno.test('diff: array nested', () => {
+	const a = new PLArray([
+		new PLDictionary([[str('id'), str('1')], [str('v'), str('a')]]),
+		new PLDictionary([[str('id'), str('2')], [str('v'), str('b')]]),
+	]);
+	const b = new PLArray([
+		new PLDictionary([[str('id'), str('1')], [str('v'), str('a')]]),
+		new PLDictionary([[str('id'), str('2')], [str('v'), str('c')]]),
+	]);
+	const patch = check(a, b);
+	assertEquals(patch.length, 1);
+	assertEquals(patch[0].op, 'set');
+	assertEquals(patch[0].path.map(String), ['1', 'v']);
+});
+
+Deno.test('diff: set', () => {
+	const patch = check(
+		new PLSet([str('a'), str('b'), int(1)]),
+		new PLSet([str('b'), int(1), int(2)]),
+	);
+	assertEquals(patch.map(({ op, value }) => [op, `${value}`]), [
+		['remove', 'a'],
+		['add', '2'],
+	]);
+});
+
+Deno.test('diff: random', () => {
+	let seed = 1;
+	const rand = (n: number) => {
+		seed = seed * 1103515245 + 12345 & 0x7fffffff;
+		return seed % n;
+	};
+	const gen = (d: number): PLType => {
+		switch (d ? rand(5) : rand(2)) {
+			case 0: {
+				return str('abcd'[rand(4)]);
+			}
+			case 1: {
+				return int(rand(3));
+			}
+			case 2: {
+				const l = rand(6);
+				return new PLArray(Array.from({ length: l }, () => gen(d - 1)));
+			}
+			case 3: {
+				const l = rand(4);
+				return new PLDictionary(
+					Array.from(
+						{ length: l },
+						(_, i) => [str(`${i}`), gen(d - 1)],
+					),
+				);
+			}
+		}
+		return new PLSet(Array.from({ length: rand(4) }, () => gen(0)));
+	};
+	const mutate = (v: PLType, d: number): PLType => {
+		if (PLArray.is(v)) {
+			const a = v.toArray();
+			for (let n = rand(3); n--;) {
+				switch (rand(4)) {
+					case 0: {
+						a.splice(rand(a.length + 1), 0, gen(d));
+						break;
+					}
+					case 1: {
+						a.splice(rand(a.length + 1), 1);
+						break;
+					}
+					case 2: {
+						if (a.length) {
+							const [e] = a.splice(rand(a.length), 1);
+							a.splice(rand(a.length + 1), 0, e);
+						}
+						break;
+					}
+					default: {
+						if (a.length) {
+							const i = rand(a.length);
+							a[i] = mutate(a[i], d);
+						}
+					}
+				}
+			}
+			return new PLArray(a);
+		}
+		if (PLDictionary.is(v)) {
+			const r = new PLDictionary<PLType, PLType>();
+			for (const [k, e] of v) {
+				switch (rand(4)) {
+					case 0: {
+						break;
+					}
+					case 1: {
+						r.set(k, mutate(e, d));
+						break;
+					}
+					default: {
+						r.set(k, e);
+					}
+				}
+			}
+			if (!rand(3)) {
+				r.set(str(`${rand(8)}`), gen(d));
+			}
+			return r;
+		}
+		return rand(2) ? v : gen(d);
+	};
+	for (let i = 0; i < 1000; i++) {
+		const a = gen(4);
+		const b = mutate(clone(a), 3);
+		check(a, b);
+		check(a, gen(4));
+		const c = mutate(a, 3);
+		const r = applyPatch(a, diff(a, c));
+		assertEquals(equal(r, c, new WeakMap()), true);
+	}
+});
+
+Deno.test('diff: near identical', () => {
+	const a = new PLArray(
+		Array.from({ length: 100000 }, (_, i) => str(`${i}`)),
+	);
+	const b = new PLArray(a.toArray());
+	b.splice(500, 1);
+	b.splice(50000, 0, str('x'));
+	b.set(90000, str('y'));
+	b.push(b.shift()!);
+	const patch = check(a, b);
+	assertEquals(patch.length, 4);
+});
+
+Deno.test('applyPatch: invalid', () => {
+	const a = new PLDictionary([[str('a'), list('abc')]]);
+	assertThrows(
+		() => applyPatch(a, [{ op: 'delete', path: [str('b')] }]),
+		RangeError,
+		'Invalid patch operation: 0',
+	);
+	assertThrows(
+		() =>
+			applyPatch(a, [
+				{ op: 'insert', path: [str('a'), 3], value: str('d') },
+				{ op: 'delete', path: [str('a'), 4] },
+			]),
+		RangeError,
+		'Invalid patch operation: 1',
+	);
+	assertThrows(
+		() => applyPatch(a, [{ op: 'add', path: [str('a')], value: str('d') }]),
+		RangeError,
+	);
+	assertThrows(() => applyPatch(a, [{ op: 'delete', path: [] }]), RangeError);
+});
+
+Deno.test('patchToPlist', () => {
+	const a = new PLDictionary<PLType, PLType>([
+		[str('list'), list('abcdef')],
+		[str('set'), new PLSet([str('a')])],
+		[int(1), str('one')],
+	]);
+	const b = new PLDictionary<PLType, PLType>([
+		[str('list'), list('bXdefa')],
+		[str('set'), new PLSet([str('b')])],
+		[int(1), str('uno')],
+	]);
+	const patch = diff(a, b);
+	const { plist } = decodeBinary(encodeBinary(patchToPlist(patch)));
+	const decoded = patchFromPlist(plist);
+	assertEquals(decoded.length, patch.length);
+	assertEquals(
+		equal(applyPatch(clone(a), decoded), b, new WeakMap()),
+		true,
+	);
+	assertThrows(() => patchFromPlist(str('')), TypeError, 'Invalid patch');
+	assertThrows(
+		() => patchFromPlist(new PLArray([new PLDictionary()])),
+		TypeError,
+		'Invalid patch operation: 0',
+	);
+});
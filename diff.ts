@@ -0,0 +1,671 @@
+/**
+ * @module
+ *
+ * Property list diff and patch.
+ */
+
+import { PLArray, PLTYPE_ARRAY } from './array.ts';
+import { PLDictionary, PLTYPE_DICTIONARY } from './dictionary.ts';
+import { PLInteger, PLTYPE_INTEGER } from './integer.ts';
+import { arrays } from './pri/array.ts';
+import { equal, type Hashes, hash, pairs } from './pri/hash.ts';
+import { type PLSet, PLTYPE_SET } from './set.ts';
+import { PLString, PLTYPE_STRING } from './string.ts';
+import type { PLType } from './type.ts';
+
+/**
+ * Maximum edit distance to align arrays by, before matching by position.
+ */
+const EDITS = 1024;
+
+/**
+ * Patch operation names.
+ */
+const OPS = new Set(['set', 'delete', 'insert', 'move', 'add', 'remove']);
+
+/**
+ * Patch path, dictionary keys and array indexes from the root.
+ */
+export type PatchPath = (PLType | number)[];
+
+/**
+ * Patch operation.
+ */
+export interface PatchOp {
+	/**
+	 * Operation:
+	 * - `set` sets the value at path, adding dictionary keys as needed.
+	 * - `delete` deletes the dictionary key or array index at path.
+	 * - `insert` inserts the value at array index of path.
+	 * - `move` moves the array value at index from to index of path.
+	 * - `add` adds the value to the set at path.
+	 * - `remove` removes a value equal to value from the set at path.
+	 */
+	op: 'set' | 'delete' | 'insert' | 'move' | 'add' | 'remove';
+
+	/**
+	 * Path of value, or of set for set operations.
+	 */
+	path: PatchPath;
+
+	/**
+	 * Value to set, insert, add, or remove.
+	 */
+	value?: PLType;
+
+	/**
+	 * Array index to move from.
+	 */
+	from?: number;
+}
+
+/**
+ * Patch, operations applied in order.
+ */
+export type Patch = PatchOp[];
+
+/**
+ * Align arrays ranges, finding the longest common subsequence.
+ *
+ * @param x Array values.
+ * @param y Array values.
+ * @param hx Array hashes.
+ * @param hy Array hashes.
+ * @param a Start of x range.
+ * @param b Start of y range.
+ * @param n Length of x range.
+ * @param m Length of y range.
+ * @param c Hash cache.
+ * @returns Matched x and y index pairs, or null if too different.
+ */
+function align(
+	x: PLType[],
+	y: PLType[],
+	hx: number[],
+	hy: number[],
+	a: number,
+	b: number,
+	n: number,
+	m: number,
+	c: Hashes,
+): number[] | null {
+	// Myers greedy algorithm, keeping furthest reaching paths to backtrack.
+	const vs: Int32Array[] = [];
+	for (let d = 0, e = Math.min(n + m, EDITS); d <= e; d++) {
+		const p = vs[d - 1];
+		const v = vs[d] = new Int32Array(d + d + 1);
+		for (let k = -d, i, j; k <= d; k += 2) {
+			i = d
+				? k === -d || (k !== d && p[k + d - 2] < p[k + d])
+					? p[k + d]
+					: p[k + d - 2] + 1
+				: 0;
+			j = i - k;
+			while (
+				i < n && j < m && hx[a + i] === hy[b + j] &&
+				equal(x[a + i], y[b + j], c)
+			) {
+				i++;
+				j++;
+			}
+			v[k + d] = i;
+			if (i >= n && j >= m) {
+				const r: number[] = [];
+				for (let s; d; d--) {
+					const p = vs[d - 1];
+					k = i - j;
+					s = k === -d || (k !== d && p[k + d - 2] < p[k + d])
+						? k + 1
+						: k - 1;
+					for (
+						let t = p[s + d - 1] + (s < k ? 1 : 0);
+						i > t;
+						r.push(b + --j, a + --i)
+					);
+					i = p[s + d - 1];
+					j = i - s;
+				}
+				while (i) {
+					r.push(b + --j, a + --i);
+				}
+				return r.reverse();
+			}
+		}
+	}
+	return null;
+}
+
+/**
+ * Diff arrays.
+ *
+ * @param a Array from.
+ * @param b Array to.
+ * @param path Array path.
+ * @param r Patch.
+ * @param c Hash cache.
+ */
+function list(
+	a: PLArray,
+	b: PLArray,
+	path: PatchPath,
+	r: Patch,
+	c: Hashes,
+): void {
+	const x = arrays.get(a)!;
+	const y = arrays.get(b)!;
+	const hx = x.map((v) => hash(v, c));
+	const hy = y.map((v) => hash(v, c));
+	const n = x.length;
+	const m = y.length;
+	let s = 0;
+	let e = 0;
+	while (s < n && s < m && hx[s] === hy[s] && equal(x[s], y[s], c)) {
+		s++;
+	}
+	while (
+		s + e < n && s + e < m && hx[n - e - 1] === hy[m - e - 1] &&
+		equal(x[n - e - 1], y[m - e - 1], c)
+	) {
+		e++;
+	}
+
+	// Source index of each value, -1 for inserted, and what x values became.
+	const from = new Array<number>(m).fill(-1);
+	const to = new Array<number>(n).fill(-1);
+	const moved = new Set<number>();
+	for (let i = 0; i < s; i++) {
+		from[i] = to[i] = i;
+	}
+	for (let i = 1; i <= e; i++) {
+		from[m - i] = n - i;
+		to[n - i] = m - i;
+	}
+	const l = align(x, y, hx, hy, s, s, n - s - e, m - s - e, c) ?? [];
+	for (let i = 0; i < l.length; i += 2) {
+		from[l[i + 1]] = l[i];
+		to[l[i]] = l[i + 1];
+	}
+
+	// Unaligned values that are equal are moved.
+	const ux = [];
+	const uy = [];
+	for (let i = s; i < n - e; i++) {
+		if (to[i] < 0) {
+			ux.push(i);
+		}
+	}
+	for (let j = s; j < m - e; j++) {
+		if (from[j] < 0) {
+			uy.push(j);
+		}
+	}
+	const p = pairs(ux.map((i) => x[i]), uy.map((j) => y[j]), c);
+	for (let i = p.length; i--;) {
+		if (p[i] >= 0) {
+			from[uy[p[i]]] = ux[i];
+			to[ux[i]] = uy[p[i]];
+			moved.add(ux[i]);
+		}
+	}
+
+	// Remaining unaligned values between aligned values change in place.
+	const changed = [];
+	for (let i = s, j = s; i < n - e || j < m - e;) {
+		if (i < n - e && moved.has(i)) {
+			i++;
+		} else if (j < m - e && moved.has(from[j])) {
+			j++;
+		} else if (i < n - e && to[i] < 0) {
+			if (j < m - e && from[j] < 0) {
+				from[j] = i;
+				to[i] = j;
+				changed.push(i++, j++);
+			} else {
+				i++;
+			}
+		} else if (j < m - e && from[j] < 0) {
+			j++;
+		} else {
+			j = to[i++] + 1;
+		}
+	}
+
+	// Delete from the end, then fill in values from the start.
+	for (let i = n; i--;) {
+		if (to[i] < 0) {
+			r.push({ op: 'delete', path: [...path, i] });
+		}
+	}
+	const cur = [];
+	if (moved.size) {
+		for (let i = 0; i < n; i++) {
+			if (to[i] >= 0) {
+				cur.push(i);
+			}
+		}
+	}
+	for (let j = 0, i, k; j < m; j++) {
+		if ((i = from[j]) < 0) {
+			r.push({ op: 'insert', path: [...path, j], value: y[j] });
+			if (moved.size) {
+				cur.splice(j, 0, -1);
+			}
+		} else if (moved.size) {
+			if (moved.has(i)) {
+				if ((k = cur.indexOf(i, j)) !== j) {
+					r.push({ op: 'move', path: [...path, j], from: k });
+					cur.splice(k, 1);
+					cur.splice(j, 0, i);
+				}
+			} else {
+				// Move any moved values still in the way to the end.
+				while (cur[j] !== i) {
+					r.push({
+						op: 'move',
+						path: [...path, cur.length - 1],
+						from: j,
+					});
+					cur.push(cur.splice(j, 1)[0]);
+				}
+			}
+		}
+	}
+	for (let i = 0; i < changed.length; i += 2) {
+		const j = changed[i + 1];
+		change(x[changed[i]], y[j], [...path, j], r, c);
+	}
+}
+
+/**
+ * Diff values.
+ *
+ * @param a Value from.
+ * @param b Value to.
+ * @param path Value path.
+ * @param r Patch.
+ * @param c Hash cache.
+ */
+function change(
+	a: PLType,
+	b: PLType,
+	path: PatchPath,
+	r: Patch,
+	c: Hashes,
+): void {
+	if (equal(a, b, c)) {
+		return;
+	}
+	const t = a[Symbol.toStringTag];
+	if (t === b[Symbol.toStringTag]) {
+		switch (t) {
+			case PLTYPE_ARRAY: {
+				list(a as PLArray, b as PLArray, path, r, c);
+				return;
+			}
+			case PLTYPE_DICTIONARY: {
+				const x = [...(a as PLDictionary).keys()];
+				const y = [...(b as PLDictionary).keys()];
+				// Keys must be unique by value to be found again.
+				if (unique(x, c) && unique(y, c)) {
+					const m = pairs(x, y, c);
+					const u = new Set(m);
+					for (let i = 0, l = x.length; i < l; i++) {
+						if (m[i] < 0) {
+							r.push({ op: 'delete', path: [...path, x[i]] });
+						} else {
+							change(
+								(a as PLDictionary).get(x[i])!,
+								(b as PLDictionary).get(y[m[i]])!,
+								[...path, x[i]],
+								r,
+								c,
+							);
+						}
+					}
+					for (let j = 0, l = y.length; j < l; j++) {
+						if (!u.has(j)) {
+							r.push({
+								op: 'set',
+								path: [...path, y[j]],
+								value: (b as PLDictionary).get(y[j])!,
+							});
+						}
+					}
+					return;
+				}
+				break;
+			}
+			case PLTYPE_SET: {
+				const x = [...(a as PLSet)];
+				const y = [...(b as PLSet)];
+				const m = pairs(x, y, c);
+				const u = new Set(m);
+				for (let i = 0, l = x.length; i < l; i++) {
+					if (m[i] < 0) {
+						r.push({ op: 'remove', path, value: x[i] });
+					}
+				}
+				for (let j = 0, l = y.length; j < l; j++) {
+					if (!u.has(j)) {
+						r.push({ op: 'add', path, value: y[j] });
+					}
+				}
+				return;
+			}
+		}
+	}
+	r.push({ op: 'set', path, value: b });
+}
+
+/**
+ * Check if values are unique.
+ *
+ * @param l Values.
+ * @param c Hash cache.
+ * @returns Is unique.
+ */
+function unique(l: PLType[], c: Hashes): boolean {
+	const m = new Map<number, PLType[]>();
+	for (const v of l) {
+		const h = hash(v, c);
+		const e = m.get(h);
+		if (e) {
+			for (const o of e) {
+				if (equal(v, o, c)) {
+					return false;
+				}
+			}
+			e.push(v);
+		} else {
+			m.set(h, [v]);
+		}
+	}
+	return true;
+}
+
+/**
+ * Diff two plists, creating a patch that changes one into the other.
+ *
+ * Equal values are skipped, identical ones without looking inside.
+ * Dictionary and set order is ignored.
+ * Arrays are aligned by longest common subsequence, detecting moves.
+ * Dictionaries with duplicate keys are set whole.
+ *
+ * Patch values are the values of b, not copies.
+ *
+ * @param a Plist from.
+ * @param b Plist to.
+ * @returns Patch.
+ */
+export function diff(a: PLType, b: PLType): Patch {
+	const r: Patch = [];
+	change(a, b, [], r, new WeakMap());
+	return r;
+}
+
+/**
+ * Get array index from path key.
+ *
+ * @param key Path key.
+ * @returns Index, or -1.
+ */
+function index(key: PLType | number): number {
+	const i = typeof key === 'number'
+		? key
+		: key[Symbol.toStringTag] === PLTYPE_INTEGER
+		? Number((key as PLInteger).value)
+		: -1;
+	return i === (i >>> 0) ? i : -1;
+}
+
+/**
+ * Apply patch to plist, changing it in place.
+ * Dictionary keys are found by value, array indexes are numbers or integers.
+ *
+ * @param plist Plist object.
+ * @param patch Patch.
+ * @returns Plist object, a new one if the root was set.
+ */
+export function applyPatch(plist: PLType, patch: Readonly<Patch>): PLType {
+	const c: Hashes = new WeakMap();
+	const keys = new WeakMap<PLDictionary, Map<number, PLType[]>>();
+	const key = (d: PLDictionary, k: PLType | number): PLType | undefined => {
+		if (typeof k === 'number') {
+			k = new PLInteger(k);
+		}
+		if (d.has(k)) {
+			return k;
+		}
+		let m = keys.get(d);
+		if (!m) {
+			keys.set(d, m = new Map());
+			for (const k of d.keys()) {
+				const h = hash(k, c);
+				m.get(h)?.push(k) ?? m.set(h, [k]);
+			}
+		}
+		const h = hash(k, c);
+		const l = m.get(h);
+		if (l) {
+			for (const e of l) {
+				if (equal(e, k, c)) {
+					return e;
+				}
+			}
+		}
+		return undefined;
+	};
+	for (let o = 0, n = patch.length; o < n; o++) {
+		const { op, path, value, from } = patch[o];
+		const error = () => new RangeError(`Invalid patch operation: ${o}`);
+		const set = op === 'add' || op === 'remove';
+		const l = path.length - (set ? 0 : 1);
+		let p: PLType | undefined = plist;
+		if (l < 0) {
+			if (op !== 'set' || !value) {
+				throw error();
+			}
+			plist = value;
+			continue;
+		}
+		for (let i = 0, k; p && i < l; i++) {
+			switch (p[Symbol.toStringTag]) {
+				case PLTYPE_ARRAY: {
+					p = (p as PLArray).get(index(path[i]));
+					break;
+				}
+				case PLTYPE_DICTIONARY: {
+					k = key(p as PLDictionary, path[i]);
+					p = k && (p as PLDictionary).get(k);
+					break;
+				}
+				default: {
+					p = undefined;
+				}
+			}
+		}
+		switch (p?.[Symbol.toStringTag]) {
+			case PLTYPE_ARRAY: {
+				const a = arrays.get(p as PLArray)!;
+				const i = set ? -1 : index(path[l]);
+				if (i < 0) {
+					break;
+				}
+				switch (op) {
+					case 'set': {
+						if (value && i < a.length) {
+							a[i] = value;
+							continue;
+						}
+						break;
+					}
+					case 'delete': {
+						if (i < a.length) {
+							a.splice(i, 1);
+							continue;
+						}
+						break;
+					}
+					case 'insert': {
+						if (value && i <= a.length) {
+							a.splice(i, 0, value);
+							continue;
+						}
+						break;
+					}
+					case 'move': {
+						if (
+							from !== undefined && from === (from >>> 0) &&
+							from < a.length && i < a.length
+						) {
+							a.splice(i, 0, a.splice(from, 1)[0]);
+							continue;
+						}
+					}
+				}
+				break;
+			}
+			case PLTYPE_DICTIONARY: {
+				if (set) {
+					break;
+				}
+				const d = p as PLDictionary;
+				const k = key(d, path[l]);
+				switch (op) {
+					case 'set': {
+						if (value) {
+							if (k) {
+								d.set(k, value);
+							} else {
+								const k = typeof path[l] === 'number'
+									? new PLInteger(path[l] as number)
+									: path[l] as PLType;
+								d.set(k, value);
+								const h = hash(k, c);
+								const m = keys.get(d)!;
+								m.get(h)?.push(k) ?? m.set(h, [k]);
+							}
+							continue;
+						}
+						break;
+					}
+					case 'delete': {
+						if (k) {
+							d.delete(k);
+							// Index is only built once a key is not found.
+							const e = keys.get(d)?.get(hash(k, c));
+							e?.splice(e.indexOf(k), 1);
+							continue;
+						}
+					}
+				}
+				break;
+			}
+			case PLTYPE_SET: {
+				const s = p as PLSet;
+				if (value) {
+					if (op === 'add') {
+						s.add(value);
+						continue;
+					}
+					if (op === 'remove') {
+						const v = s.has(value)
+							? value
+							: s.find((v) => equal(v, value, c));
+						if (v) {
+							s.delete(v);
+							continue;
+						}
+					}
+				}
+			}
+		}
+		throw error();
+	}
+	return plist;
+}
+
+/**
+ * Convert patch to a plist, for encoding.
+ *
+ * Each operation is a dictionary with `op`, `path`, and optionally `value`,
+ * and `from` keys, with array indexes in paths as integers.
+ *
+ * @param patch Patch.
+ * @returns Plist array.
+ */
+export function patchToPlist(
+	patch: Readonly<Patch>,
+): PLArray<PLDictionary<PLString, PLType>> {
+	return new PLArray(
+		patch.map(({ op, path, value, from }) => {
+			const d = new PLDictionary<PLString, PLType>([
+				[new PLString('op'), new PLString(op)],
+				[
+					new PLString('path'),
+					new PLArray(
+						path.map((k) =>
+							typeof k === 'number' ? new PLInteger(k) : k
+						),
+					),
+				],
+			]);
+			if (value) {
+				d.set(new PLString('value'), value);
+			}
+			if (from !== undefined) {
+				d.set(new PLString('from'), new PLInteger(from));
+			}
+			return d;
+		}),
+	);
+}
+
+/**
+ * Convert plist to a patch, after decoding.
+ *
+ * @param plist Plist object.
+ * @returns Patch.
+ */
+export function patchFromPlist(plist: PLType): Patch {
+	if (plist[Symbol.toStringTag] !== PLTYPE_ARRAY) {
+		throw new TypeError('Invalid patch');
+	}
+	return (plist as PLArray).toArray().map((d, o) => {
+		const r: Partial<PatchOp> = {};
+		if (d[Symbol.toStringTag] === PLTYPE_DICTIONARY) {
+			for (const [k, v] of d as PLDictionary) {
+				if (k[Symbol.toStringTag] !== PLTYPE_STRING) {
+					continue;
+				}
+				switch (k.valueOf()) {
+					case 'op': {
+						if (v[Symbol.toStringTag] === PLTYPE_STRING) {
+							r.op = v.valueOf() as PatchOp['op'];
+						}
+						break;
+					}
+					case 'path': {
+						if (v[Symbol.toStringTag] === PLTYPE_ARRAY) {
+							r.path = (v as PLArray).toArray();
+						}
+						break;
+					}
+					case 'value': {
+						r.value = v;
+						break;
+					}
+					case 'from': {
+						if (v[Symbol.toStringTag] === PLTYPE_INTEGER) {
+							r.from = Number(v.valueOf());
+						}
+					}
+				}
+			}
+		}
+		if (!r.path || !OPS.has(r.op!)) {
+			throw new TypeError(`Invalid patch operation: ${o}`);
+		}
+		return r as PatchOp;
+	});
+}
@@ -0,0 +1,97 @@
+import { decodeBinary } from '../decode/binary.ts';
+import { benchFixtures, benchPlists } from '../spec/bench.ts';
+import { encodeBinary, type EncodeBinaryOrder } from './binary.ts';
+
+const orders: EncodeBinaryOrder[] = ['walk', 'breadth', 'cluster', 'frequency'];
+
+// Read the offset of a value by path, like a partial reader.
+function read(e: Uint8Array, path: (string | number)[]): number {
+	const d = new DataView(e.buffer, e.byteOffset, e.byteLength);
+	const int = (i: number, c: number): number =>
+		c === 1
+			? e[i]
+			: c === 2
+			? d.getUint16(i)
+			: c === 4
+			? d.getUint32(i)
+			: Number(d.getBigUint64(i));
+	const t = e.length - 32;
+	const intC = e[t + 6];
+	const refC = e[t + 7];
+	const table = int(t + 24, 8);
+	const offset = (r: number): number => int(table + r * intC, intC);
+	let o = offset(int(t + 16, 8));
+	for (const p of path) {
+		let i = o + 1;
+		let n = e[o] & 15;
+		if (n === 15) {
+			n = int(i + 1, 1 << (e[i] & 15));
+			i += 1 + (1 << (e[i] & 15));
+		}
+		if (typeof p === 'number') {
+			o = offset(int(i + p * refC, refC));
+			continue;
+		}
+		for (let k = 0; k < n; k++) {
+			const s = offset(int(i + k * refC, refC));
+			if ((e[s] & 15) === p.length) {
+				let j = 0;
+				while (j < p.length && e[s + 1 + j] === p.charCodeAt(j)) {
+					j++;
+				}
+				if (j === p.length) {
+					o = offset(int(i + (n + k) * refC, refC));
+					break;
+				}
+			}
+		}
+	}
+	return o;
+}
+
+// Paths to the last value in each shape.
+const paths: { [name: string]: (string | number)[] } = {
+	wide: ['key-9999'],
+	deep: [...new Array(999).fill(0), 1, 'key'],
+	strings: [15],
+	blobs: [15],
+	integers: [99999],
+};
+
+const fixtures = benchFixtures('binary', decodeBinary).map((d) =>
+	decodeBinary(d).plist
+);
+
+Deno.bench('encodeBinary: fixtures', { group: 'fixtures' }, () => {
+	for (const plist of fixtures) {
+		encodeBinary(plist);
+	}
+});
+
+for (const [name, plist] of benchPlists()) {
+	Deno.bench(`encodeBinary: ${name}`, { group: name }, () => {
+		encodeBinary(plist);
+	});
+}
+
+for (const [name, plist] of benchPlists()) {
+	for (const order of orders) {
+		Deno.bench(
+			`encodeBinary: ${name}: order ${order}`,
+			{ group: `order: ${name}` },
+			() => {
+				encodeBinary(plist, { order });
+			},
+		);
+	}
+	for (const order of orders) {
+		const encoded = encodeBinary(plist, { order });
+		Deno.bench(
+			`encodeBinary: ${name}: order ${order}: read`,
+			{ group: `order: ${name}: read` },
+			() => {
+				read(encoded, paths[name]);
+			},
+		);
+	}
+}
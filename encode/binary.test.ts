@@ -1,4 +1,6 @@
 import { assertEquals, assertThrows } from '@std/assert';
+import { decodeBinary } from '../decode/binary.ts';
+import { deepEqual } from '../fingerprint.ts';
 import { fixturePlist } from '../spec/fixture.ts';
 import { PLArray, PLTYPE_ARRAY } from '../array.ts';
 import { PLBoolean, PLTYPE_BOOLEAN } from '../boolean.ts';
@@ -13,7 +15,11 @@ import { PLSet, PLTYPE_SET } from '../set.ts';
 import { PLString } from '../string.ts';
 import type { PLType } from '../type.ts';
 import { PLTYPE_UID, PLUID } from '../uid.ts';
-import { encodeBinary, type EncodeBinaryOptions } from './binary.ts';
+import {
+	encodeBinary,
+	type EncodeBinaryOptions,
+	type EncodeBinaryOrder,
+} from './binary.ts';
 
 const CF_STYLE = {
 	// CF duplicates encoding reused references to certain types.
@@ -55,6 +61,84 @@ Deno.test('Invalid format', () => {
 	);
 });
 
+Deno.test('Invalid order', () => {
+	assertThrows(
+		() => {
+			encodeBinary(new PLString(), {
+				order: 'UNKNOWN' as EncodeBinaryOrder,
+			});
+		},
+		RangeError,
+		'Invalid order',
+	);
+});
+
+Deno.test('Order', () => {
+	const TRUE = new PLBoolean(true);
+	const shared = new PLString('shared');
+	const plist = new PLDictionary<PLType, PLType>([
+		[new PLString('A'), new PLArray([shared, new PLInteger(1), TRUE])],
+		[new PLString('B'), new PLDictionary([[new PLString('C'), shared]])],
+		[
+			new PLString('D'),
+			new PLSet([shared, new PLData(new ArrayBuffer(4))]),
+		],
+		[new PLString('E'), TRUE],
+	]);
+	const walk = encodeBinary(plist, CF_STYLE);
+	const offset = (e: Uint8Array, s: string): number =>
+		String.fromCharCode(...e).indexOf(s);
+	for (
+		const order of [
+			'walk',
+			'breadth',
+			'cluster',
+			'frequency',
+		] as EncodeBinaryOrder[]
+	) {
+		const encoded = encodeBinary(plist, { ...CF_STYLE, order });
+		assertEquals(encoded.length, walk.length, order);
+		assertEquals(
+			deepEqual(decodeBinary(encoded).plist, plist),
+			true,
+			order,
+		);
+		if (order === 'walk') {
+			assertEquals(encoded, walk);
+		}
+		if (order === 'frequency') {
+			assertEquals(
+				offset(encoded, 'shared') < offset(encoded, 'A'),
+				true,
+			);
+		}
+		if (order === 'cluster') {
+			assertEquals(
+				offset(encoded, 'B') - offset(encoded, 'A') > 2,
+				true,
+			);
+		} else if (order !== 'frequency') {
+			assertEquals(offset(encoded, 'B') - offset(encoded, 'A'), 2);
+		}
+		if (order === 'breadth') {
+			assertEquals(
+				encoded.indexOf(0xd1) < offset(encoded, 'shared'),
+				true,
+			);
+		}
+		if (order === 'walk') {
+			assertEquals(
+				encoded.indexOf(0xd1) > offset(encoded, 'shared'),
+				true,
+			);
+		}
+	}
+	assertEquals(
+		encodeBinary(new PLString('root'), { order: 'cluster' }),
+		encodeBinary(new PLString('root')),
+	);
+});
+
 Deno.test('Invalid key', () => {
 	const keys: PLType[] = [
 		{ [Symbol.toStringTag]: 'UNKNOWN' } as unknown as PLType,
@@ -5,6 +5,7 @@
  */
 
 import { type PLArray, PLTYPE_ARRAY } from '../array.ts';
+import type { AsyncOptions } from '../async.ts';
 import { type PLBoolean, PLTYPE_BOOLEAN } from '../boolean.ts';
 import { type PLData, PLTYPE_DATA } from '../data.ts';
 import { type PLDate, PLTYPE_DATE } from '../date.ts';
@@ -12,14 +13,23 @@ import { type PLDictionary, PLTYPE_DICTIONARY } from '../dictionary.ts';
 import { FORMAT_BINARY_V1_0 } from '../format.ts';
 import { type PLInteger, PLTYPE_INTEGER } from '../integer.ts';
 import { PLTYPE_NULL } from '../null.ts';
+import { sliced, sync } from '../pri/async.ts';
+import { dataBuffer } from '../pri/data.ts';
+import { unchanged, type Watch, watching } from '../pri/mutate.ts';
+import { stringSizes } from '../pri/string.ts';
+import { traceEncode } from '../pri/trace.ts';
+import { walker } from '../pri/walk.ts';
 import { type PLReal, PLTYPE_REAL } from '../real.ts';
 import { type PLSet, PLTYPE_SET } from '../set.ts';
 import { type PLString, PLTYPE_STRING } from '../string.ts';
+import type { TraceOptions } from '../trace.ts';
 import type { PLType, PLTypeName } from '../type.ts';
 import { PLTYPE_UID, type PLUID } from '../uid.ts';
-import { walk } from '../walk.ts';
 
-const rUni = /[^\0-\x7F]/;
+/**
+ * Trace phases.
+ */
+const phases = ['size', 'write'] as const;
 
 /**
  * Number of bytes needed to encode integer.
@@ -46,7 +56,12 @@ const setInt = (
 ): void => {
 	if (c > 2) {
 		if (c > 4) {
-			d.setBigInt64(i, BigInt(v));
+			if (typeof v === 'number') {
+				d.setInt32(i, Math.floor(v / 4294967296));
+				d.setUint32(i + 4, v >>> 0);
+			} else {
+				d.setBigInt64(i, v);
+			}
 		} else {
 			d.setInt32(i, Number(v));
 		}
@@ -72,10 +87,102 @@ const encodeInt = (d: DataView, i: number, v: bigint | number): number => {
 	return i + c;
 };
 
+/**
+ * Binary object order.
+ *
+ * - walk: Walk order, with dictionary keys first, like official encoders.
+ * - breadth: Breadth first, each level in reference order.
+ * - cluster: Each container followed by its children, keys beside values.
+ * - frequency: Most referenced objects first, after the root.
+ */
+export type EncodeBinaryOrder = 'walk' | 'breadth' | 'cluster' | 'frequency';
+
+/**
+ * Reorder objects, keeping the root first and duplicates together.
+ *
+ * @param list Objects in walk order, with duplicates.
+ * @param index Object indexes, to rebuild.
+ * @param order Object order.
+ * @returns Objects in order.
+ */
+function reorder(
+	list: Map<number, PLType>,
+	index: Map<PLType, number>,
+	order: Exclude<EncodeBinaryOrder, 'walk'>,
+): PLType[] {
+	const r: PLType[] = [];
+	const objects = [...index.keys()];
+	let count: Map<PLType, number> | null = null;
+	if (list.size !== objects.length) {
+		count = new Map();
+		for (const v of list.values()) {
+			count.set(v, (count.get(v) ?? 0) + 1);
+		}
+	}
+	index.clear();
+	const place = (v: PLType): void => {
+		index.set(v, r.length);
+		for (let n = count?.get(v) ?? 1; n--;) {
+			r.push(v);
+		}
+	};
+	const children = (v: PLType): Iterable<PLType> | null => {
+		switch (v[Symbol.toStringTag]) {
+			case PLTYPE_ARRAY:
+			case PLTYPE_SET: {
+				return v as PLArray | PLSet;
+			}
+			case PLTYPE_DICTIONARY: {
+				const d = v as PLDictionary;
+				return order === 'cluster'
+					? [...d].flat()
+					: [...d.keys(), ...d.values()];
+			}
+		}
+		return null;
+	};
+	const root = objects[0];
+	place(root);
+	if (order === 'frequency') {
+		const refs = new Map<PLType, number>();
+		for (const v of objects) {
+			for (const c of children(v) ?? []) {
+				refs.set(c, (refs.get(c) ?? 0) + 1);
+			}
+		}
+		for (
+			const v of objects.slice(1)
+				.sort((a, b) => refs.get(b)! - refs.get(a)!)
+		) {
+			place(v);
+		}
+		return r;
+	}
+	const pending = [root];
+	for (let i = 0; i < pending.length;) {
+		const v = order === 'breadth' ? pending[i++] : pending.pop()!;
+		const s = pending.length;
+		for (const c of children(v) ?? []) {
+			if (!index.has(c)) {
+				place(c);
+				pending.push(c);
+			}
+		}
+		if (order === 'cluster') {
+			for (let a = s, b = pending.length - 1; a < b;) {
+				const c = pending[a];
+				pending[a++] = pending[b];
+				pending[b--] = c;
+			}
+		}
+	}
+	return r;
+}
+
 /**
  * Encoding options for binary.
  */
-export interface EncodeBinaryOptions {
+export interface EncodeBinaryOptions extends TraceOptions {
 	/**
 	 * Encoding format.
 	 *
@@ -89,22 +196,38 @@ export interface EncodeBinaryOptions {
 	 * @default [] Empty list.
 	 */
 	duplicates?: Iterable<PLTypeName | PLType>;
+
+	/**
+	 * Object order, for locality of lazy or partial readers.
+	 * Reference and offset sizes depend only on object count and size.
+	 *
+	 * @default 'walk'
+	 */
+	order?: EncodeBinaryOrder;
 }
 
 /**
- * Encode plist, BINARY format.
+ * Encode plist, BINARY format, yielding objects processed every step.
  *
  * @param plist Plist object.
  * @param options Encoding options.
+ * @param step Objects between yields, 0 for none.
+ * @param t Phase start times, to trace, or null.
+ * @param w Watch of objects, to throw if changed between yields, or null.
+ * @yields Objects processed.
  * @returns Encoded plist.
  */
-export function encodeBinary(
+function* binary(
 	plist: PLType,
 	{
 		format = FORMAT_BINARY_V1_0,
 		duplicates,
-	}: Readonly<EncodeBinaryOptions> = {},
-): Uint8Array<ArrayBuffer> {
+		order = 'walk',
+	}: Readonly<EncodeBinaryOptions>,
+	step: number,
+	t: number[] | null,
+	w: Watch | null,
+): Generator<number, Uint8Array<ArrayBuffer>, void> {
 	let e;
 	let x;
 	let i = 8;
@@ -114,12 +237,17 @@ export function encodeBinary(
 	if (format !== FORMAT_BINARY_V1_0) {
 		throw new RangeError('Invalid format');
 	}
+	if (
+		order !== 'walk' && order !== 'breadth' && order !== 'cluster' &&
+		order !== 'frequency'
+	) {
+		throw new RangeError('Invalid order');
+	}
 
 	const ancestors = new Set<PLType>();
 	const dup = new Set(duplicates ?? []);
 	const list = new Map<number, PLType>();
 	const index = new Map<PLType, number>();
-	const uni = new Map<PLType, boolean>();
 	const add = <T extends PLType>(v: T) => {
 		if (index.has(v)) {
 			if (!dup.has(v) && !dup.has(v[Symbol.toStringTag])) {
@@ -132,7 +260,7 @@ export function encodeBinary(
 		return true;
 	};
 
-	walk(
+	let o = yield* walker(
 		plist,
 		{
 			PLArray(v): void {
@@ -183,7 +311,7 @@ export function encodeBinary(
 				if (add(v)) {
 					i += 128 === v.bits
 						? 17
-						: (x = v.value) < 0
+						: (x = v.compact) < 0
 						? 9
 						: 1 + byteCount(x);
 				}
@@ -215,11 +343,8 @@ export function encodeBinary(
 			PLString(v): void {
 				if (add(v)) {
 					x = v.length;
-					i += (x < 15 ? 1 : 2 + byteCount(x)) + (
-						uni.get(v) ?? (uni.set(v, e = rUni.test(v.value)), e)
-							? x + x
-							: x
-					);
+					i += (x < 15 ? 1 : 2 + byteCount(x)) +
+						(stringSizes(v).a ? x : x + x);
 				}
 			},
 			PLUID(v): void {
@@ -243,16 +368,23 @@ export function encodeBinary(
 		{
 			keysFirst: true,
 		},
+		step,
+		0,
+		w,
 	);
 
+	const objects = order === 'walk'
+		? list.values()
+		: reorder(list, index, order);
+	t?.push(performance.now());
 	const refC = byteCount(l);
 	const intC = byteCount(table = i += refC * table);
 	const d = new DataView(x = new ArrayBuffer((i += intC * l + 6) + 26));
 	const r = new Uint8Array(x);
 	r[i++] = intC;
 	r[i++] = refC;
-	d.setBigInt64(i, BigInt(l));
-	d.setBigInt64(i + 16, BigInt(table));
+	setInt(d, i, 8, l);
+	setInt(d, i + 16, 8, table);
 	i = 0;
 	r[i++] = 98;
 	r[i++] = 112;
@@ -263,7 +395,13 @@ export function encodeBinary(
 	r[i++] = 48;
 	r[i++] = 48;
 
-	for (e of list.values()) {
+	let y = step ? o + step : -1;
+	for (e of objects) {
+		if (++o === y) {
+			yield o;
+			y += step;
+			unchanged(w!);
+		}
 		setInt(d, table, intC, i);
 		table += intC;
 		switch (e?.[Symbol.toStringTag]) {
@@ -311,7 +449,7 @@ export function encodeBinary(
 					r[i++] = 79;
 					i = encodeInt(d, i, l);
 				}
-				r.set(new Uint8Array((e as PLData).buffer), i);
+				r.set(new Uint8Array(dataBuffer(e as PLData)), i);
 				i += l;
 				break;
 			}
@@ -322,15 +460,16 @@ export function encodeBinary(
 				break;
 			}
 			case PLTYPE_INTEGER: {
-				x = (e as PLInteger).value;
+				x = (e as PLInteger).compact;
 				if ((e as PLInteger).bits === 128) {
 					r[i++] = 20;
+					x = BigInt(x);
 					d.setBigInt64(i, x >> 64n);
 					d.setBigInt64(i += 8, x & 0xffffffffffffffffn);
 					i += 8;
 				} else if (x < 0) {
 					r[i++] = 19;
-					d.setBigInt64(i, x);
+					setInt(d, i, 8, x);
 					i += 8;
 				} else {
 					i = encodeInt(d, i, x);
@@ -368,7 +507,7 @@ export function encodeBinary(
 				break;
 			}
 			case PLTYPE_STRING: {
-				x = uni.get(e);
+				x = !stringSizes(e as PLString).a;
 				e = (e as PLString).value;
 				l = e.length;
 				if (l < 15) {
@@ -399,3 +538,49 @@ export function encodeBinary(
 	}
 	return r;
 }
+
+/**
+ * Encode plist, BINARY format.
+ *
+ * @param plist Plist object.
+ * @param options Encoding options.
+ * @returns Encoded plist.
+ */
+export function encodeBinary(
+	plist: PLType,
+	options: Readonly<EncodeBinaryOptions> = {},
+): Uint8Array<ArrayBuffer> {
+	return sync(
+		traceEncode(
+			options,
+			phases,
+			plist,
+			options.format ?? FORMAT_BINARY_V1_0,
+			(t) => binary(plist, options, 0, t, null),
+		),
+	);
+}
+
+/**
+ * Encode plist, BINARY format, without blocking the event loop.
+ *
+ * @param plist Plist object.
+ * @param options Encoding and async options.
+ * @returns Encoded plist.
+ */
+export function encodeBinaryAsync(
+	plist: PLType,
+	options: Readonly<EncodeBinaryOptions & AsyncOptions> = {},
+): Promise<Uint8Array<ArrayBuffer>> {
+	return sliced(
+		(step) =>
+			traceEncode(
+				options,
+				phases,
+				plist,
+				options.format ?? FORMAT_BINARY_V1_0,
+				(t) => watching((w) => binary(plist, options, step, t, w)),
+			),
+		options,
+	);
+}
@@ -112,3 +112,27 @@ Deno.test('Format: Invalid', () => {
 		'Invalid format',
 	);
 });
+
+Deno.test('Re-encode after string change', () => {
+	const str = new PLString('A');
+	const plist = new PLDictionary([[new PLString('Key'), str]]);
+	for (
+		const format of [
+			FORMAT_OPENSTEP,
+			FORMAT_STRINGS,
+			FORMAT_XML_V1_0,
+			FORMAT_XML_V0_9,
+			FORMAT_BINARY_V1_0,
+		]
+	) {
+		str.value = 'A';
+		const a = encode(plist, { format });
+		assertEquals(encode(plist, { format }), a, format);
+		str.value = 'é & "B"';
+		const b = encode(plist, { format });
+		assertGreater(b.byteLength, a.byteLength, format);
+		assertEquals(encode(plist, { format }), b, format);
+		str.value = 'A';
+		assertEquals(encode(plist, { format }), a, format);
+	}
+});
@@ -8,6 +8,7 @@ export * from './binary.ts';
 export * from './openstep.ts';
 export * from './xml.ts';
 
+import type { AsyncOptions } from '../async.ts';
 import {
 	type Format,
 	FORMAT_BINARY_V1_0,
@@ -17,9 +18,21 @@ import {
 	FORMAT_XML_V1_0,
 } from '../format.ts';
 import type { PLType } from '../type.ts';
-import { encodeBinary, type EncodeBinaryOptions } from './binary.ts';
-import { encodeOpenStep, type EncodeOpenStepOptions } from './openstep.ts';
-import { encodeXml, type EncodeXmlOptions } from './xml.ts';
+import {
+	encodeBinary,
+	encodeBinaryAsync,
+	type EncodeBinaryOptions,
+} from './binary.ts';
+import {
+	encodeOpenStep,
+	encodeOpenStepAsync,
+	type EncodeOpenStepOptions,
+} from './openstep.ts';
+import {
+	encodeXml,
+	encodeXmlAsync,
+	type EncodeXmlOptions,
+} from './xml.ts';
 
 /**
  * Encoding options.
@@ -58,3 +71,32 @@ export function encode(
 		}
 	}
 }
+
+/**
+ * Encode plist, without blocking the event loop.
+ *
+ * @param plist Plist object.
+ * @param options Encoding and async options.
+ * @returns Encoded plist.
+ */
+export function encodeAsync(
+	plist: PLType,
+	options: Readonly<EncodeOptions & AsyncOptions>,
+): Promise<Uint8Array<ArrayBuffer>> {
+	switch (options.format) {
+		case FORMAT_BINARY_V1_0: {
+			return encodeBinaryAsync(plist, options);
+		}
+		case FORMAT_XML_V1_0:
+		case FORMAT_XML_V0_9: {
+			return encodeXmlAsync(plist, options);
+		}
+		case FORMAT_OPENSTEP:
+		case FORMAT_STRINGS: {
+			return encodeOpenStepAsync(plist, options);
+		}
+		default: {
+			return Promise.reject(new RangeError('Invalid format'));
+		}
+	}
+}
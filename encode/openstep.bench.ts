@@ -0,0 +1,19 @@
+import { decodeOpenStep } from '../decode/openstep.ts';
+import { benchFixtures, benchPlists } from '../spec/bench.ts';
+import { encodeOpenStep } from './openstep.ts';
+
+const fixtures = benchFixtures('openstep', decodeOpenStep).map((d) =>
+	decodeOpenStep(d).plist
+);
+
+Deno.bench('encodeOpenStep: fixtures', { group: 'fixtures' }, () => {
+	for (const plist of fixtures) {
+		encodeOpenStep(plist);
+	}
+});
+
+for (const [name, plist] of benchPlists(true)) {
+	Deno.bench(`encodeOpenStep: ${name}`, { group: name }, () => {
+		encodeOpenStep(plist);
+	});
+}
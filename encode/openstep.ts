@@ -4,52 +4,70 @@
  * OpenStep encoding.
  */
 
+import type { AsyncOptions } from '../async.ts';
 import { FORMAT_OPENSTEP, FORMAT_STRINGS } from '../format.ts';
+import { sliced, sync } from '../pri/async.ts';
+import { dataBuffer } from '../pri/data.ts';
+import { type Watch, watching } from '../pri/mutate.ts';
 import { esc, unquoted } from '../pri/openstep.ts';
+import { stringMeta } from '../pri/string.ts';
+import { traceEncode } from '../pri/trace.ts';
+import { walker } from '../pri/walk.ts';
+import type { PLString } from '../string.ts';
+import type { TraceOptions } from '../trace.ts';
 import type { PLType } from '../type.ts';
-import { walk } from '../walk.ts';
+
+/**
+ * Trace phases.
+ */
+const phases = ['size', 'write'] as const;
 
 const rIndent = /^[\t ]*$/;
 
 /**
  * Calculate string encode size.
  *
- * @param str String.
+ * @param s String.
  * @param quote Quote.
  * @param quoted Quoted.
  * @returns Size.
  */
-function stringLength(
-	str: string,
-	quote: 34 | 39,
-	quoted: boolean | number,
-): number {
-	let i = str.length;
-	let total = i;
-	let next = 0;
-	let chr: number;
-	while (i--) {
-		if (!unquoted(chr = str.charCodeAt(i))) {
-			quoted = total += chr < 32
-				? (
-					chr > 13
-						? (next < 56 && next > 47) as unknown as number + 2
-						: (chr < 7 && next < 56 && next > 47 ? 3 : 1)
-				)
-				: (
-					(chr === quote || chr === 92) ||
-					(chr > 126 && (chr === 127 ? 3 : 5))
-				) as number;
+function stringLength(s: PLString, quote: 34 | 39, quoted: boolean): number {
+	const m = stringMeta(s);
+	if (m.q !== quote) {
+		const str = s.value;
+		let i = str.length;
+		let total = i;
+		let next = 0;
+		let chr: number;
+		let q = !i;
+		while (i--) {
+			if (!unquoted(chr = str.charCodeAt(i))) {
+				q = true;
+				total += chr < 32
+					? (
+						chr > 13
+							? (next < 56 && next > 47) as unknown as number + 2
+							: (chr < 7 && next < 56 && next > 47 ? 3 : 1)
+					)
+					: (
+						(chr === quote || chr === 92) ||
+						(chr > 126 && (chr === 127 ? 3 : 5))
+					) as number;
+			}
+			next = chr;
 		}
-		next = chr;
+		m.q = quote;
+		m.o = total;
+		m.n = q;
 	}
-	return quoted || !total ? total + 2 : total;
+	return quoted || m.n ? m.o + 2 : m.o;
 }
 
 /**
- * Encode string into buffer.
+ * Encode string into buffer, after calculating size.
  *
- * @param str String.
+ * @param s String.
  * @param dest Buffer.
  * @param start Offset.
  * @param quote Quote.
@@ -57,21 +75,18 @@ function stringLength(
  * @returns End.
  */
 function stringEncode(
-	str: string,
+	s: PLString,
 	dest: Uint8Array,
 	start: number,
 	quote: 34 | 39,
 	quoted: boolean,
 ): number {
+	const str = s.value;
 	const l = str.length;
 	let i = 0;
 	let chr: number;
 	let x: number;
-	if (!(quoted ||= !l)) {
-		while (!(quoted = !unquoted(str.charCodeAt(i++))) && i < l);
-		i = 0;
-	}
-	if (quoted) {
+	if ((quoted ||= stringMeta(s).n)) {
 		dest[start++] = quote;
 	}
 	while (i < l) {
@@ -146,7 +161,7 @@ function dataEncode(
 /**
  * Encoding options for OpenStep.
  */
-export interface EncodeOpenStepOptions {
+export interface EncodeOpenStepOptions extends TraceOptions {
 	/**
 	 * Encoding format.
 	 *
@@ -184,13 +199,17 @@ export interface EncodeOpenStepOptions {
 }
 
 /**
- * Encode plist, OpenStep format.
+ * Encode plist, OpenStep format, yielding objects processed every step.
  *
  * @param plist Plist object.
  * @param options Encoding options.
+ * @param step Objects between yields, 0 for none.
+ * @param t Phase start times, to trace, or null.
+ * @param w Watch of objects, to throw if changed between yields, or null.
+ * @yields Objects processed.
  * @returns Encoded plist.
  */
-export function encodeOpenStep(
+function* openstep(
 	plist: PLType,
 	{
 		format = FORMAT_OPENSTEP,
@@ -198,8 +217,11 @@ export function encodeOpenStep(
 		quote = '"',
 		quoted = false,
 		shortcut = false,
-	}: Readonly<EncodeOpenStepOptions> = {},
-): Uint8Array<ArrayBuffer> {
+	}: Readonly<EncodeOpenStepOptions>,
+	step: number,
+	t: number[] | null,
+	w: Watch | null,
+): Generator<number, Uint8Array<ArrayBuffer>, void> {
 	let base = 0;
 	let i: number;
 
@@ -233,7 +255,7 @@ export function encodeOpenStep(
 	}
 	i = 1;
 
-	walk(
+	const o = yield* walker(
 		plist,
 		{
 			PLArray(v, d, k): void {
@@ -278,10 +300,10 @@ export function encodeOpenStep(
 				}
 				if (k && typeof k !== 'number') {
 					if (!shortcut || v !== k) {
-						i += 3 + stringLength(v.value, qc, quoted);
+						i += 3 + stringLength(v, qc, quoted);
 					}
 				} else {
-					i += stringLength(v.value, qc, quoted);
+					i += stringLength(v, qc, quoted);
 				}
 			},
 			PLDictionary(v, d, k): void {
@@ -315,12 +337,17 @@ export function encodeOpenStep(
 				ancestors.delete(v);
 			},
 		},
+		{},
+		step,
+		0,
+		w,
 	);
 
+	t?.push(performance.now());
 	const r = new Uint8Array(i);
 	i = 0;
 
-	walk(
+	yield* walker(
 		plist,
 		{
 			PLArray(v, d, k): void {
@@ -361,7 +388,7 @@ export function encodeOpenStep(
 					r[i++] = 61;
 					r[i++] = 32;
 				}
-				i = dataEncode(new Uint8Array(v.buffer), r, i);
+				i = dataEncode(new Uint8Array(dataBuffer(v)), r, i);
 				if (k) {
 					r[i++] = 59;
 				}
@@ -401,7 +428,7 @@ export function encodeOpenStep(
 					for (d += base; d--; i += inl) {
 						r.set(ind, i);
 					}
-					i = stringEncode(v.value, r, i, qc, quoted);
+					i = stringEncode(v, r, i, qc, quoted);
 				} else if (!k) {
 					if (i) {
 						r[i++] = 10;
@@ -409,13 +436,13 @@ export function encodeOpenStep(
 							r.set(ind, i);
 						}
 					}
-					i = stringEncode(v.value, r, i, qc, quoted);
+					i = stringEncode(v, r, i, qc, quoted);
 				} else {
 					if (!shortcut || v !== k) {
 						r[i++] = 32;
 						r[i++] = 61;
 						r[i++] = 32;
-						i = stringEncode(v.value, r, i, qc, quoted);
+						i = stringEncode(v, r, i, qc, quoted);
 					}
 					r[i++] = 59;
 				}
@@ -447,8 +474,58 @@ export function encodeOpenStep(
 				}
 			},
 		},
+		{},
+		step,
+		o,
+		w,
 	);
 
 	r[i] = 10;
 	return r;
 }
+
+/**
+ * Encode plist, OpenStep format.
+ *
+ * @param plist Plist object.
+ * @param options Encoding options.
+ * @returns Encoded plist.
+ */
+export function encodeOpenStep(
+	plist: PLType,
+	options: Readonly<EncodeOpenStepOptions> = {},
+): Uint8Array<ArrayBuffer> {
+	return sync(
+		traceEncode(
+			options,
+			phases,
+			plist,
+			options.format ?? FORMAT_OPENSTEP,
+			(t) => openstep(plist, options, 0, t, null),
+		),
+	);
+}
+
+/**
+ * Encode plist, OpenStep format, without blocking the event loop.
+ *
+ * @param plist Plist object.
+ * @param options Encoding and async options.
+ * @returns Encoded plist.
+ */
+export function encodeOpenStepAsync(
+	plist: PLType,
+	options: Readonly<EncodeOpenStepOptions & AsyncOptions> = {},
+): Promise<Uint8Array<ArrayBuffer>> {
+	return sliced(
+		(step) =>
+			traceEncode(
+				options,
+				phases,
+				plist,
+				options.format ?? FORMAT_OPENSTEP,
+				(t) => watching((w) => openstep(plist, options, step, t, w)),
+			),
+		options,
+	);
+}
@@ -0,0 +1,19 @@
+import { decodeXml } from '../decode/xml.ts';
+import { benchFixtures, benchPlists } from '../spec/bench.ts';
+import { encodeXml } from './xml.ts';
+
+const fixtures = benchFixtures('xml', decodeXml).map((d) =>
+	decodeXml(d).plist
+);
+
+Deno.bench('encodeXml: fixtures', { group: 'fixtures' }, () => {
+	for (const plist of fixtures) {
+		encodeXml(plist);
+	}
+});
+
+for (const [name, plist] of benchPlists()) {
+	Deno.bench(`encodeXml: ${name}`, { group: name }, () => {
+		encodeXml(plist);
+	});
+}
@@ -4,9 +4,11 @@ import { PLArray } from '../array.ts';
 import { PLBoolean } from '../boolean.ts';
 import { PLData } from '../data.ts';
 import { PLDate } from '../date.ts';
+import { decodeXml } from '../decode/xml.ts';
 import { PLDictionary } from '../dictionary.ts';
 import { FORMAT_XML_V1_0 } from '../format.ts';
 import { PLInteger } from '../integer.ts';
+import { lazies } from '../pri/data.ts';
 import { PLReal } from '../real.ts';
 import { PLString } from '../string.ts';
 import type { PLType } from '../type.ts';
@@ -165,6 +167,69 @@ Deno.test('Option: unsignZero', () => {
 	);
 });
 
+Deno.test('Lazy data', () => {
+	const td = new TextDecoder();
+	const te = new TextEncoder();
+	for (let l = 0; l < 200; l += 7) {
+		const tag = `${l}`;
+		const bytes = new Uint8Array(l);
+		for (let i = 0; i < l; i++) {
+			bytes[i] = i * 31;
+		}
+		const array = new PLArray([
+			new PLArray([new PLData(bytes.buffer)]),
+			new PLData(bytes.buffer),
+		]);
+		const expected = encodeXml(array, { indent: '  ' });
+		const nested = td.decode(encodeXml(array))
+			.replace(/<data>[^<]*/g, (m) => m.replace(/(.{1,60})/g, ' $1\n'))
+			.replace(/<data>/, '<data>\r\n');
+		const lazy = decodeXml(te.encode(nested), { lazy: true }).plist;
+		assertEquals(encodeXml(lazy, { indent: '  ' }), expected, tag);
+		assertEquals(
+			lazies.get((lazy as PLArray).get(1)!)?.c,
+			true,
+			tag,
+		);
+	}
+	for (const s of ['YR==', 'Y Q = =', 'YQ']) {
+		const data = te.encode(
+			td.decode(encodeXml(new PLData(new ArrayBuffer(1))))
+				.replace(/<data>[^<]*/, `<data>${s}`),
+		);
+		const eager = decodeXml(data).plist;
+		const lazy = decodeXml(data, { lazy: true }).plist;
+		assertEquals(encodeXml(lazy), encodeXml(eager), s);
+	}
+});
+
+Deno.test('Data line length', () => {
+	const td = new TextDecoder();
+	for (let l = 0; l < 200; l++) {
+		const tag = `${l}`;
+		const bytes = new Uint8Array(l).fill(l);
+		const encoded = encodeXml(new PLData(bytes.buffer));
+		const lines = td.decode(encoded).split('\n');
+		assertEquals(lines.pop(), '', tag);
+		for (const line of lines) {
+			assertEquals(line.length <= 174, true, tag);
+			assertEquals(line.includes('\0'), false, tag);
+		}
+		const data = lines.slice(4, -2);
+		assertEquals(data.every((line) => line.length <= 76), true, tag);
+		assertEquals(
+			data.slice(0, -1).every((line) => line.length === 76),
+			true,
+			tag,
+		);
+		assertEquals(
+			new Uint8Array((decodeXml(encoded).plist as PLData).buffer),
+			bytes,
+			tag,
+		);
+	}
+});
+
 Deno.test('spec: array-0', async () => {
 	const encode = encodeXml(new PLArray(), CF_STYLE);
 	assertEquals(
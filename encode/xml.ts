@@ -4,69 +4,38 @@
  * XML encoding.
  */
 
+import type { AsyncOptions } from '../async.ts';
 import { FORMAT_XML_V0_9, FORMAT_XML_V1_0 } from '../format.ts';
-import { b64e } from '../pri/base.ts';
-import { utf8Encode, utf8Size } from '../pri/utf8.ts';
+import { sliced, sync } from '../pri/async.ts';
+import { dataBuffer, lazies } from '../pri/data.ts';
+import { type Watch, watching } from '../pri/mutate.ts';
+import { stringSizes } from '../pri/string.ts';
+import { traceEncode } from '../pri/trace.ts';
+import { utf8Encode } from '../pri/utf8.ts';
+import { walker } from '../pri/walk.ts';
+import {
+	dataLines,
+	dataSize,
+	date,
+	escape,
+	head,
+	integer,
+	real,
+} from '../pri/xml.ts';
 import type { PLType } from '../type.ts';
-import { walk } from '../walk.ts';
-
-const rIndent = /^[\t ]*$/;
-const rDateY4 = /^(-)0*(\d{3}-)|\+?0*(\d{4,}-)/;
-const rRealTrim = /\.?0+$/;
-const rEnt = /[&<>]/g;
-const ents = { '&': '&amp;', '<': '&lt;', '>': '&gt;' } as const;
-const ent = (s: string) => ents[s as keyof typeof ents];
-
-/**
- * Encode integer to string.
- *
- * @param i Integer value.
- * @param mz Encode smallest 128-bit integer as -0.
- * @returns Integer string.
- */
-function integer(i: bigint, mz: boolean): string {
-	// Format issue encodes smallest 128-bit as negative zero.
-	return mz && i === -0x80000000000000000000000000000000n
-		? '-0'
-		: i.toString();
-}
+import type { TraceOptions } from '../trace.ts';
 
 /**
- * Encode real to string.
- *
- * @param real Real value.
- * @param uz Unsign zero.
- * @returns Real string.
+ * Trace phases.
  */
-function real(real: number, uz: boolean): string {
-	// No trailing zeros except on 0.
-	switch (real) {
-		case 0:
-			return uz || 1 / real === Infinity ? '0.0' : '-0.0';
-		case Infinity:
-			return '+infinity';
-		case -Infinity:
-			return '-infinity';
-	}
-	// deno-lint-ignore no-self-compare
-	return real === real ? real.toPrecision(17).replace(rRealTrim, '') : 'nan';
-}
+const phases = ['size', 'write'] as const;
 
-/**
- * Convert date to string.
- *
- * @param date Date.
- * @returns Date string.
- */
-function date(date: { toISOString: () => string }): string {
-	// No decimal seconds, 4+ characters for year, no leading plus.
-	return `${date.toISOString().slice(0, -5).replace(rDateY4, '$1$2$3')}Z`;
-}
+const rIndent = /^[\t ]*$/;
 
 /**
  * Encoding options for XML.
  */
-export interface EncodeXmlOptions {
+export interface EncodeXmlOptions extends TraceOptions {
 	/**
 	 * Encoding format.
 	 *
@@ -97,46 +66,32 @@ export interface EncodeXmlOptions {
 }
 
 /**
- * Encode plist, XML format.
+ * Encode plist, XML format, yielding objects processed every step.
  *
  * @param plist Plist object.
  * @param options Encoding options.
+ * @param step Objects between yields, 0 for none.
+ * @param t Phase start times, to trace, or null.
+ * @param w Watch of objects, to throw if changed between yields, or null.
+ * @yields Objects processed.
  * @returns Encoded plist.
  */
-export function encodeXml(
+function* xml(
 	plist: PLType,
 	{
 		format = FORMAT_XML_V1_0,
 		indent = '\t',
 		unsignZero = false,
 		min128Zero = false,
-	}: Readonly<EncodeXmlOptions> = {},
-): Uint8Array<ArrayBuffer> {
-	let doctype: string;
-	let version: string;
-	let i: number;
+	}: Readonly<EncodeXmlOptions>,
+	step: number,
+	t: number[] | null,
+	w: Watch | null,
+): Generator<number, Uint8Array<ArrayBuffer>, void> {
+	const h = head(format);
+	let i = h.length + 10;
 	let x;
 
-	switch (format) {
-		case FORMAT_XML_V1_0: {
-			doctype =
-				'<!DOCTYPE plist PUBLIC "-//Apple//DTD PLIST 1.0//EN" "http://www.apple.com/DTDs/PropertyList-1.0.dtd">';
-			version = '1.0';
-			i = 174;
-			break;
-		}
-		case FORMAT_XML_V0_9: {
-			doctype =
-				'<!DOCTYPE plist SYSTEM "file://localhost/System/Library/DTDs/PropertyList.dtd">';
-			version = '0.9';
-			i = 151;
-			break;
-		}
-		default: {
-			throw new RangeError('Invalid format');
-		}
-	}
-
 	if (!rIndent.test(indent)) {
 		throw new RangeError('Invalid indent');
 	}
@@ -148,7 +103,7 @@ export function encodeXml(
 		ind[x] = indent.charCodeAt(x);
 	}
 
-	walk(
+	const o = yield* walker(
 		plist,
 		{
 			PLArray(v, d, k): void {
@@ -175,21 +130,21 @@ export function encodeXml(
 				if (d && k === null) {
 					throw new TypeError('Invalid XML key type');
 				}
-				x = v.byteLength;
-				x = ((x - (x % 3 || 3)) / 3 + 1) * 4;
-				i += 13 + x + (d * inl + 1) * ((x - (x % 76 || 76)) / 76 + 2);
+				i += dataSize(v.byteLength, inl, d);
 			},
 			PLDate(v, d, k): void {
 				if (d && k === null) {
 					throw new TypeError('Invalid XML key type');
 				}
-				i += 13 + date(v).length;
+				// Year has at least 4 characters, including any sign.
+				x = `${v.year}`.length;
+				i += 29 + (x < 4 ? 4 : x);
 			},
 			PLInteger(v, d, k): void {
 				if (d && k === null) {
 					throw new TypeError('Invalid XML key type');
 				}
-				i += 19 + integer(v.value, min128Zero).length;
+				i += 19 + integer(v.compact, min128Zero).length;
 			},
 			PLReal(v, d, k): void {
 				if (d && k === null) {
@@ -198,8 +153,8 @@ export function encodeXml(
 				i += 13 + real(v.value, unsignZero).length;
 			},
 			PLString(v, d, k): void {
-				i += (d && k === null ? 11 : 17) +
-					utf8Size(v.value.replace(rEnt, ent));
+				x = stringSizes(v);
+				i += (d && k === null ? 11 : 17) + x.u + x.x;
 			},
 			PLUID(v, d, k): void {
 				if (d && k === null) {
@@ -234,17 +189,17 @@ export function encodeXml(
 				ancestors.delete(v);
 			},
 		},
+		{},
+		step,
+		0,
+		w,
 	);
 
+	t?.push(performance.now());
 	const r = new Uint8Array(i);
-	i = utf8Encode('<?xml version="1.0" encoding="UTF-8"?>', r, 0);
-	r[i++] = 10;
-	i = utf8Encode(doctype, r, i);
-	r[i++] = 10;
-	i = utf8Encode(`<plist version="${version}">`, r, i);
-	r[i++] = 10;
+	i = utf8Encode(h, r, 0);
 
-	walk(
+	yield* walker(
 		plist,
 		{
 			PLArray(v, d): void {
@@ -267,41 +222,25 @@ export function encodeXml(
 				}
 				i = utf8Encode('<data>', r, i);
 				r[i++] = 10;
-				for (
-					let u = new Uint8Array(v.buffer),
-						l = u.length,
-						l3 = l - (l % 3),
-						b = 0,
-						c,
-						e;
-					b < l;
-				) {
-					for (x = d; x--; i += inl) {
-						r.set(ind, i);
-					}
-					for (x = 20; b < l3 && --x;) {
-						e = u[b++];
-						r[i++] = b64e[c = e >> 2] + c - 19;
-						e = e << 8 | u[b++];
-						r[i++] = b64e[c = e >> 4 & 63] + c - 19;
-						e = e << 8 | u[b++];
-						r[i++] = b64e[c = e >> 6 & 63] + c - 19;
-						r[i++] = b64e[c = e & 63] + c - 19;
-					}
-					if (x && b < l) {
-						e = u[b++];
-						r[i++] = b64e[c = e >> 2] + c - 19;
+				const z = lazies.get(v);
+				if (z?.c) {
+					for (let u = z.d, b = z.i, l = z.e, c; b < l;) {
+						for (; b < l && u[b] < 33; b++);
 						if (b < l) {
-							e = e << 8 | u[b++];
-							r[i++] = b64e[c = e >> 4 & 63] + c - 19;
-							r[i++] = b64e[c = e << 2 & 63] + c - 19;
-						} else {
-							r[i++] = b64e[c = e << 4 & 63] + c - 19;
-							r[i++] = 61;
+							for (x = d; x--; i += inl) {
+								r.set(ind, i);
+							}
+							for (x = 76; x && b < l;) {
+								if ((c = u[b++]) > 32) {
+									r[i++] = c;
+									x--;
+								}
+							}
+							r[i++] = 10;
 						}
-						r[i++] = 61;
 					}
-					r[i++] = 10;
+				} else {
+					i = dataLines(new Uint8Array(dataBuffer(v)), r, i, ind, d);
 				}
 				for (; d--; i += inl) {
 					r.set(ind, i);
@@ -330,7 +269,7 @@ export function encodeXml(
 					r.set(ind, i);
 				}
 				i = utf8Encode('<integer>', r, i);
-				i = utf8Encode(integer(v.value, min128Zero), r, i);
+				i = utf8Encode(integer(v.compact, min128Zero), r, i);
 				i = utf8Encode('</integer>', r, i);
 				r[i++] = 10;
 			},
@@ -349,7 +288,11 @@ export function encodeXml(
 					r.set(ind, i);
 				}
 				i = utf8Encode(x ? '<key>' : '<string>', r, i);
-				i = utf8Encode(v.value.replace(rEnt, ent), r, i);
+				i = utf8Encode(
+					stringSizes(v).x ? escape(v.value) : v.value,
+					r,
+					i,
+				);
 				i = utf8Encode(x ? '</key>' : '</string>', r, i);
 				r[i++] = 10;
 			},
@@ -398,8 +341,58 @@ export function encodeXml(
 				}
 			},
 		},
+		{},
+		step,
+		o,
+		w,
 	);
 
 	r[utf8Encode('</plist>', r, i)] = 10;
 	return r;
 }
+
+/**
+ * Encode plist, XML format.
+ *
+ * @param plist Plist object.
+ * @param options Encoding options.
+ * @returns Encoded plist.
+ */
+export function encodeXml(
+	plist: PLType,
+	options: Readonly<EncodeXmlOptions> = {},
+): Uint8Array<ArrayBuffer> {
+	return sync(
+		traceEncode(
+			options,
+			phases,
+			plist,
+			options.format ?? FORMAT_XML_V1_0,
+			(t) => xml(plist, options, 0, t, null),
+		),
+	);
+}
+
+/**
+ * Encode plist, XML format, without blocking the event loop.
+ *
+ * @param plist Plist object.
+ * @param options Encoding and async options.
+ * @returns Encoded plist.
+ */
+export function encodeXmlAsync(
+	plist: PLType,
+	options: Readonly<EncodeXmlOptions & AsyncOptions> = {},
+): Promise<Uint8Array<ArrayBuffer>> {
+	return sliced(
+		(step) =>
+			traceEncode(
+				options,
+				phases,
+				plist,
+				options.format ?? FORMAT_XML_V1_0,
+				(t) => watching((w) => xml(plist, options, step, t, w)),
+			),
+		options,
+	);
+}
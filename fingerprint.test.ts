@@ -0,0 +1,102 @@
+import { assertEquals, assertNotEquals } from '@std/assert';
+import { PLArray } from './array.ts';
+import { PLData } from './data.ts';
+import { PLDictionary } from './dictionary.ts';
+import { deepEqual, fingerprint } from './fingerprint.ts';
+import { PLInteger } from './integer.ts';
+import { tracked } from './pri/mutate.ts';
+import { PLReal } from './real.ts';
+import { PLSet } from './set.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+
+const str = (s: string) => new PLString(s);
+
+Deno.test('fingerprint: order', () => {
+	const a = new PLDictionary([[str('a'), str('1')], [str('b'), str('2')]]);
+	const b = new PLDictionary([[str('b'), str('2')], [str('a'), str('1')]]);
+	const ordered = { ordered: true };
+	assertEquals(fingerprint(a), fingerprint(b));
+	assertNotEquals(fingerprint(a, ordered), fingerprint(b, ordered));
+	assertEquals(
+		fingerprint(new PLSet([str('a'), str('b')])),
+		fingerprint(new PLSet([str('b'), str('a')])),
+	);
+	assertNotEquals(
+		fingerprint(new PLSet([str('a'), str('b')]), ordered),
+		fingerprint(new PLSet([str('b'), str('a')]), ordered),
+	);
+	assertEquals(deepEqual(a, b), true);
+	assertEquals(deepEqual(a, b, ordered), false);
+	assertEquals(deepEqual(a, a, ordered), true);
+});
+
+Deno.test('fingerprint: values', () => {
+	const values = [
+		str('1'),
+		new PLInteger(1),
+		new PLInteger(1, 128),
+		new PLReal(1),
+		new PLReal(1, 32),
+		new PLReal(0),
+		new PLReal(-0),
+		new PLData(new Uint8Array([1]).buffer),
+		new PLData(new Uint8Array([2]).buffer),
+		new PLArray(),
+		new PLSet(),
+		new PLDictionary(),
+	];
+	const hashes = new Set(values.map((v) => fingerprint(v)));
+	assertEquals(hashes.size, values.length);
+	for (const a of values) {
+		for (const b of values) {
+			assertEquals(deepEqual(a, b), a === b);
+		}
+	}
+	assertEquals(fingerprint(str('')) >= 0, true);
+	assertEquals(fingerprint(str('a')), fingerprint(str('a')));
+	assertEquals(
+		fingerprint(new PLArray([new PLInteger(1), str('a')])),
+		0x28c363c8,
+	);
+});
+
+Deno.test('fingerprint: changes', () => {
+	const leaf = str('a');
+	const shared = new PLArray([leaf]);
+	const other = new PLArray([str('b')]);
+	const root = new PLDictionary<PLType, PLType>([
+		[str('x'), shared],
+		[str('y'), new PLArray([shared])],
+		[str('z'), other],
+	]);
+	const before = fingerprint(root);
+	const [c] = tracked;
+	assertEquals(c.has(leaf), true);
+
+	leaf.value = 'c';
+	assertEquals(c.has(leaf), false);
+	assertEquals(c.has(shared), false);
+	assertEquals(c.has(root), false);
+	assertEquals(c.has(other), true);
+	const after = fingerprint(root);
+	assertNotEquals(after, before);
+
+	leaf.value = 'a';
+	assertEquals(fingerprint(root), before);
+
+	other.push(str('c'));
+	assertEquals(c.has(shared), true);
+	assertNotEquals(fingerprint(root), before);
+	other.pop();
+	assertEquals(fingerprint(root), before);
+
+	const copy = new PLDictionary<PLType, PLType>([
+		[str('z'), new PLArray([str('b')])],
+		[str('y'), new PLArray([new PLArray([str('a')])])],
+		[str('x'), new PLArray([str('a')])],
+	]);
+	assertEquals(deepEqual(root, copy), true);
+	(root.get(root.keys().next().value!) as PLArray).push(str('d'));
+	assertEquals(deepEqual(root, copy), false);
+});
@@ -0,0 +1,58 @@
+/**
+ * @module
+ *
+ * Property list fingerprinting.
+ */
+
+import { equal, hash } from './pri/hash.ts';
+import { tracked } from './pri/mutate.ts';
+import type { PLType } from './type.ts';
+
+/**
+ * Fingerprint options.
+ */
+export interface FingerprintOptions {
+	/**
+	 * Dictionary and set order matters.
+	 *
+	 * @default false
+	 */
+	ordered?: boolean;
+}
+
+/**
+ * Structural hash of a plist, the same across runs and platforms.
+ * Integers and reals of different widths, and 0 and -0, differ.
+ * Hashes are kept for each object, until it or a descendant is changed,
+ * so only changed subtrees are hashed again.
+ * Data buffers modified directly are not detected.
+ *
+ * @param plist Plist object.
+ * @param options Fingerprint options.
+ * @returns Unsigned 32-bit hash.
+ */
+export function fingerprint(
+	plist: PLType,
+	options?: Readonly<FingerprintOptions>,
+): number {
+	const o = !!options?.ordered;
+	return hash(plist, tracked[+o], o, true) >>> 0;
+}
+
+/**
+ * Check if plists are structurally equal, as fingerprinted.
+ * Different fingerprints are rejected without further comparison.
+ *
+ * @param a Plist object.
+ * @param b Plist object.
+ * @param options Fingerprint options.
+ * @returns Is equal.
+ */
+export function deepEqual(
+	a: PLType,
+	b: PLType,
+	options?: Readonly<FingerprintOptions>,
+): boolean {
+	const o = !!options?.ordered;
+	return equal(a, b, tracked[+o], o, true);
+}
@@ -0,0 +1,157 @@
+import { PLArray } from './array.ts';
+import { decode } from './decode/mod.ts';
+import { PLDictionary } from './dictionary.ts';
+import { encode } from './encode/mod.ts';
+import { type Format, FORMAT_BINARY_V1_0, FORMAT_XML_V1_0 } from './format.ts';
+import { PlistFrameDecoderStream, PlistFrameEncoderStream } from './frame.ts';
+import { PLInteger } from './integer.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+
+const formats: [string, Format][] = [
+	['binary', FORMAT_BINARY_V1_0],
+	['xml', FORMAT_XML_V1_0],
+];
+
+const records: PLType[] = [];
+for (let i = 0; i < 10000; i++) {
+	records.push(
+		new PLDictionary<PLType, PLType>([
+			[new PLString('time'), new PLInteger(1700000000 + i)],
+			[new PLString('level'), new PLString(i % 7 ? 'info' : 'warn')],
+			[new PLString('message'), new PLString(`request ${i} done`)],
+			[new PLString('tags'), new PLArray([new PLString('http')])],
+		]),
+	);
+}
+
+function source<T>(chunks: readonly T[]): ReadableStream<T> {
+	let i = 0;
+	return new ReadableStream({
+		pull(c): void {
+			if (i < chunks.length) {
+				c.enqueue(chunks[i++]);
+			} else {
+				c.close();
+			}
+		},
+	}, { highWaterMark: 0 });
+}
+
+async function drain(stream: ReadableStream<unknown>): Promise<number> {
+	let n = 0;
+	for (const reader = stream.getReader(); !(await reader.read()).done;) {
+		n++;
+	}
+	return n;
+}
+
+// Length prefix and copy each record into a fresh buffer.
+function prefixed(plist: PLType, format: Format): Uint8Array {
+	const e = encode(plist, { format });
+	const r = new Uint8Array(4 + e.length);
+	new DataView(r.buffer).setUint32(0, e.length);
+	r.set(e, 4);
+	return r;
+}
+
+// Buffer chunks, then slice each complete record out to decode.
+function unprefix(): TransformStream<Uint8Array, PLType> {
+	let buffer = new Uint8Array(0);
+	return new TransformStream({
+		transform(chunk, c): void {
+			const b = new Uint8Array(buffer.length + chunk.length);
+			b.set(buffer);
+			b.set(chunk, buffer.length);
+			let i = 0;
+			for (let l; i + 4 <= b.length; i += 4 + l) {
+				l = new DataView(b.buffer, i).getUint32(0);
+				if (i + 4 + l > b.length) {
+					break;
+				}
+				c.enqueue(decode(b.slice(i + 4, i + 4 + l)).plist);
+			}
+			buffer = b.slice(i);
+		},
+	});
+}
+
+function chunked(d: Uint8Array, size: number): Uint8Array[] {
+	const r = [];
+	for (let i = 0; i < d.length; i += size) {
+		r.push(d.subarray(i, i + size));
+	}
+	return r;
+}
+
+function concat(chunks: readonly Uint8Array[]): Uint8Array {
+	const r = new Uint8Array(chunks.reduce((n, c) => n + c.length, 0));
+	chunks.reduce((n, c) => (r.set(c, n), n + c.length), 0);
+	return r;
+}
+
+for (const [name, format] of formats) {
+	const framed = chunked(
+		concat(
+			records.map((plist) => {
+				const e = encode(plist, { format });
+				const r = new Uint8Array(5 + e.length);
+				r[0] = format === FORMAT_BINARY_V1_0 ? 0 : 1;
+				new DataView(r.buffer).setUint32(1, e.length);
+				r.set(e, 5);
+				return r;
+			}),
+		),
+		0x10000,
+	);
+	const plain = chunked(
+		concat(records.map((plist) => prefixed(plist, format))),
+		0x10000,
+	);
+
+	Deno.bench(
+		`PlistFrameEncoderStream: ${name}`,
+		{ group: `frame: encode: ${name}`, baseline: true },
+		async () => {
+			await drain(
+				source(records).pipeThrough(
+					new PlistFrameEncoderStream({ format }),
+				),
+			);
+		},
+	);
+
+	Deno.bench(
+		`prefix each record: ${name}`,
+		{ group: `frame: encode: ${name}` },
+		async () => {
+			await drain(
+				source(records).pipeThrough(
+					new TransformStream({
+						transform(plist, c): void {
+							c.enqueue(prefixed(plist, format));
+						},
+					}),
+				),
+			);
+		},
+	);
+
+	Deno.bench(
+		`PlistFrameDecoderStream: ${name}`,
+		{ group: `frame: decode: ${name}`, baseline: true },
+		async () => {
+			await drain(
+				source(framed).pipeThrough(new PlistFrameDecoderStream()),
+			);
+		},
+	);
+
+	Deno.bench(
+		`buffer and slice each record: ${name}`,
+		{ group: `frame: decode: ${name}` },
+		async () => {
+			await drain(source(plain).pipeThrough(unprefix()));
+		},
+	);
+}
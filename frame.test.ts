@@ -0,0 +1,245 @@
+import { assertEquals, assertRejects, assertThrows } from '@std/assert';
+import { PLArray } from './array.ts';
+import { BudgetError } from './budget.ts';
+import type { DecodeResult } from './decode/mod.ts';
+import { PLDictionary } from './dictionary.ts';
+import { encode } from './encode/mod.ts';
+import { deepEqual } from './fingerprint.ts';
+import {
+	type Format,
+	FORMAT_BINARY_V1_0,
+	FORMAT_OPENSTEP,
+	FORMAT_STRINGS,
+	FORMAT_XML_V0_9,
+	FORMAT_XML_V1_0,
+} from './format.ts';
+import {
+	PlistFrameDecoderStream,
+	PlistFrameEncoderStream,
+} from './frame.ts';
+import { PLInteger } from './integer.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+
+const FORMATS: Format[] = [
+	FORMAT_BINARY_V1_0,
+	FORMAT_XML_V1_0,
+	FORMAT_XML_V0_9,
+	FORMAT_OPENSTEP,
+	FORMAT_STRINGS,
+];
+
+function record(i: number, n = 1): PLType {
+	const list = new PLArray<PLType>();
+	for (let j = 0; j < n; j++) {
+		list.push(new PLString(`line ${j}`));
+	}
+	return new PLDictionary<PLType, PLType>([
+		[new PLString('id'), new PLString(`${i}`)],
+		[new PLString('lines'), list],
+	]);
+}
+
+function source<T>(chunks: T[]): ReadableStream<T> {
+	return new ReadableStream({
+		pull(c): void {
+			if (chunks.length) {
+				c.enqueue(chunks.shift()!);
+			} else {
+				c.close();
+			}
+		},
+	});
+}
+
+async function collect<T>(stream: ReadableStream<T>): Promise<T[]> {
+	const r = [];
+	for (const reader = stream.getReader();;) {
+		const { done, value } = await reader.read();
+		if (done) {
+			return r;
+		}
+		r.push(value);
+	}
+}
+
+function concat(chunks: Uint8Array[]): Uint8Array {
+	const r = new Uint8Array(chunks.reduce((n, c) => n + c.length, 0));
+	chunks.reduce((n, c) => (r.set(c, n), n + c.length), 0);
+	return r;
+}
+
+function split(d: Uint8Array, size: number): Uint8Array[] {
+	const r = [];
+	for (let i = 0; i < d.length; i += size) {
+		r.push(d.slice(i, i + size));
+	}
+	return r;
+}
+
+Deno.test('PlistFrameEncoderStream: frames', async () => {
+	for (const format of FORMATS) {
+		const plists = [record(0), record(1, 3)];
+		const chunks = await collect(
+			source(plists.slice()).pipeThrough(
+				new PlistFrameEncoderStream({ format }),
+			),
+		);
+		assertEquals(chunks.length, 1);
+		const expected = plists.flatMap((plist) => {
+			const e = encode(plist, { format });
+			const h = new Uint8Array(5);
+			h[0] = FORMATS.indexOf(format);
+			new DataView(h.buffer).setUint32(1, e.length);
+			return [h, e];
+		});
+		assertEquals(chunks[0], concat(expected));
+	}
+});
+
+Deno.test('PlistFrameEncoderStream: batch', async () => {
+	const format = FORMAT_BINARY_V1_0;
+	const plists = [];
+	for (let i = 0; i < 100; i++) {
+		plists.push(record(i, i % 10 ? 1 : 100));
+	}
+	const batched = await collect(
+		source(plists.slice()).pipeThrough(
+			new PlistFrameEncoderStream({ format, batch: 500 }),
+		),
+	);
+	const single = await collect(
+		source(plists.slice()).pipeThrough(
+			new PlistFrameEncoderStream({ format, batch: 0 }),
+		),
+	);
+	assertEquals(single.length, 200);
+	assertEquals(batched.length < 50, true);
+	assertEquals(concat(batched), concat(single));
+	const small = batched.filter((c) => c.length < 500);
+	assertEquals(small.length <= 1 + 10 * 2, true);
+
+	const sink = new PlistFrameEncoderStream({ format });
+	const writer = sink.writable.getWriter();
+	const reader = sink.readable.getReader();
+	writer.write(record(0));
+	const { value } = await reader.read();
+	assertEquals(value!.length, 5 + encode(record(0), { format }).length);
+	await writer.close();
+	assertEquals((await reader.read()).done, true);
+});
+
+Deno.test('PlistFrameDecoderStream: chunks', async () => {
+	for (const format of FORMATS) {
+		const plists = [];
+		for (let i = 0; i < 20; i++) {
+			plists.push(record(i, i));
+		}
+		const framed = concat(
+			await collect(
+				source(plists.slice()).pipeThrough(
+					new PlistFrameEncoderStream({ format }),
+				),
+			),
+		);
+		for (const size of [1, 4, 5, 7, 64, framed.length]) {
+			const decoded: DecodeResult[] = await collect(
+				source(split(framed, size)).pipeThrough(
+					new PlistFrameDecoderStream(),
+				),
+			);
+			assertEquals(decoded.length, plists.length);
+			for (let i = 0; i < plists.length; i++) {
+				assertEquals(decoded[i].format, format);
+				assertEquals(deepEqual(decoded[i].plist, plists[i]), true);
+			}
+		}
+	}
+});
+
+Deno.test('PlistFrameDecoderStream: incremental', async () => {
+	const format = FORMAT_BINARY_V1_0;
+	const framed = concat(
+		await collect(
+			source([new PLInteger(1), new PLInteger(2)]).pipeThrough(
+				new PlistFrameEncoderStream({ format }),
+			),
+		),
+	);
+	const stream = new PlistFrameDecoderStream();
+	const writer = stream.writable.getWriter();
+	const reader = stream.readable.getReader();
+	writer.write(framed.subarray(0, framed.length - 1));
+	const first = await reader.read();
+	assertEquals(first.value?.plist.valueOf(), 1n);
+	writer.write(framed.subarray(framed.length - 1));
+	const second = await reader.read();
+	assertEquals(second.value?.plist.valueOf(), 2n);
+	await writer.close();
+	assertEquals((await reader.read()).done, true);
+});
+
+Deno.test('PlistFrameDecoderStream: invalid', async () => {
+	assertThrows(
+		() => new PlistFrameEncoderStream({ format: 'X' as Format }),
+		RangeError,
+		'Invalid format',
+	);
+	assertThrows(
+		() =>
+			new PlistFrameEncoderStream({
+				format: FORMAT_BINARY_V1_0,
+				batch: -1,
+			}),
+		RangeError,
+		'Invalid batch',
+	);
+	assertThrows(
+		() => new PlistFrameDecoderStream({ maxFrame: NaN }),
+		RangeError,
+		'Invalid maxFrame',
+	);
+	const framed = concat(
+		await collect(
+			source([record(0), record(1)]).pipeThrough(
+				new PlistFrameEncoderStream({ format: FORMAT_XML_V1_0 }),
+			),
+		),
+	);
+	const decode = (
+		d: Uint8Array,
+		maxFrame?: number,
+	): Promise<DecodeResult[]> =>
+		collect(
+			source([d]).pipeThrough(new PlistFrameDecoderStream({ maxFrame })),
+		);
+	assertEquals((await decode(framed, framed.length)).length, 2);
+	await assertRejects(
+		() => decode(framed.subarray(0, -1)),
+		SyntaxError,
+		'Invalid binary data at 0x',
+	);
+	await assertRejects(
+		() => decode(framed.subarray(0, 3)),
+		SyntaxError,
+		'Invalid binary data at 0x0',
+	);
+	await assertRejects(
+		() => decode(framed, 100),
+		BudgetError,
+		'Exceeded maxFrame at 0x0',
+	);
+	const tagged = framed.slice();
+	tagged[0] = 255;
+	await assertRejects(
+		() => decode(tagged),
+		SyntaxError,
+		'Invalid binary data at 0x0',
+	);
+	tagged[0] = 0;
+	await assertRejects(
+		() => decode(tagged),
+		SyntaxError,
+		'Invalid binary data at 0x0',
+	);
+});
@@ -0,0 +1,224 @@
+/**
+ * @module
+ *
+ * Framed property list streams, for sequences of plists.
+ */
+
+import { BudgetError } from './budget.ts';
+import { decode, type DecodeOptions, type DecodeResult } from './decode/mod.ts';
+import { encode, type EncodeOptions } from './encode/mod.ts';
+import {
+	type Format,
+	FORMAT_BINARY_V1_0,
+	FORMAT_OPENSTEP,
+	FORMAT_STRINGS,
+	FORMAT_XML_V0_9,
+	FORMAT_XML_V1_0,
+} from './format.ts';
+import { binaryError, binaryErrorBudget, bytes } from './pri/data.ts';
+import type { PLType } from './type.ts';
+
+/**
+ * Frame format tags, by index.
+ */
+const TAGS: readonly Format[] = [
+	FORMAT_BINARY_V1_0,
+	FORMAT_XML_V1_0,
+	FORMAT_XML_V0_9,
+	FORMAT_OPENSTEP,
+	FORMAT_STRINGS,
+];
+
+/**
+ * Frame header size, a format tag then a big-endian 32-bit length.
+ */
+const HEADER = 5;
+
+/**
+ * Framed decode options.
+ */
+export interface DecodeFramesOptions extends DecodeOptions {
+	/**
+	 * Optional maximum encoded bytes of one frame, for untrusted input.
+	 *
+	 * @default Infinity
+	 */
+	maxFrame?: number;
+}
+
+/**
+ * Framed encode options.
+ */
+export type EncodeFramesOptions = EncodeOptions & {
+	/**
+	 * Bytes of frames to batch into one chunk.
+	 * Partial batches are written once the current task ends.
+	 *
+	 * @default 65536
+	 */
+	batch?: number;
+};
+
+/**
+ * Encode a stream of plists into frames, each a format tag and length then
+ * the encoded plist.
+ * Small frames are batched into larger chunks, large ones passed through.
+ */
+export class PlistFrameEncoderStream
+	extends TransformStream<PLType, Uint8Array<ArrayBuffer>> {
+	/**
+	 * Create framed encoder stream.
+	 *
+	 * @param options Encoding and batching options.
+	 */
+	constructor(options: Readonly<EncodeFramesOptions>) {
+		const { format, batch = 0x10000 } = options;
+		const tag = TAGS.indexOf(format);
+		if (tag < 0) {
+			throw new RangeError('Invalid format');
+		}
+		if (!(batch >= 0)) {
+			throw new RangeError('Invalid batch');
+		}
+		let pending: Uint8Array<ArrayBuffer>[] = [];
+		let size = 0;
+		let timer: ReturnType<typeof setTimeout> | undefined;
+		const write = (
+			c: TransformStreamDefaultController<Uint8Array<ArrayBuffer>>,
+		): void => {
+			clearTimeout(timer);
+			timer = undefined;
+			if (!size) {
+				return;
+			}
+			const r = new Uint8Array(size);
+			const v = new DataView(r.buffer);
+			let i = 0;
+			for (const e of pending) {
+				r[i] = tag;
+				v.setUint32(i + 1, e.length);
+				r.set(e, i += HEADER);
+				i += e.length;
+			}
+			pending = [];
+			size = 0;
+			c.enqueue(r);
+		};
+		super({
+			transform(plist, c): void {
+				const e = encode(plist, options);
+				const l = e.length;
+				if (l > 0xffffffff) {
+					throw new RangeError('Invalid frame');
+				}
+				if (HEADER + l < batch) {
+					pending.push(e);
+					if ((size += HEADER + l) >= batch) {
+						write(c);
+					} else {
+						timer ??= setTimeout(() => {
+							try {
+								write(c);
+							} catch {
+								// Stream closed or errored.
+							}
+						}, 0);
+					}
+					return;
+				}
+				write(c);
+				const h = new Uint8Array(HEADER);
+				h[0] = tag;
+				new DataView(h.buffer).setUint32(1, l);
+				c.enqueue(h);
+				c.enqueue(e);
+			},
+			flush(c): void {
+				write(c);
+			},
+		});
+	}
+}
+
+/**
+ * Decode a stream of frames into plists, each decoded once its frame is
+ * complete, without buffering more than one frame.
+ * Frames within a chunk are decoded in place, without copying.
+ */
+export class PlistFrameDecoderStream
+	extends TransformStream<ArrayBufferView | ArrayBufferLike, DecodeResult> {
+	/**
+	 * Create framed decoder stream.
+	 *
+	 * @param options Decoding options.
+	 */
+	constructor(options: Readonly<DecodeFramesOptions> = {}) {
+		const { maxFrame = Infinity } = options;
+		if (!(maxFrame >= 0)) {
+			throw new RangeError('Invalid maxFrame');
+		}
+		const head = new Uint8Array(HEADER);
+		const view = new DataView(head.buffer);
+		let h = 0;
+		let body: Uint8Array | null = null;
+		let f = 0;
+		let offset = 0;
+		let format: Format;
+		const emit = (
+			c: TransformStreamDefaultController<DecodeResult>,
+			d: Uint8Array,
+		): void => {
+			const r = decode(d, options);
+			if (r.format !== format) {
+				throw new SyntaxError(binaryError(offset));
+			}
+			c.enqueue(r);
+			offset += HEADER + d.length;
+		};
+		super({
+			transform(chunk, c): void {
+				const d = bytes(chunk);
+				const l = d.length;
+				for (let i = 0; i < l;) {
+					if (!body) {
+						const n = Math.min(HEADER - h, l - i);
+						head.set(d.subarray(i, i += n), h);
+						if ((h += n) < HEADER) {
+							return;
+						}
+						h = 0;
+						const t = TAGS[head[0]];
+						if (!t) {
+							throw new SyntaxError(binaryError(offset));
+						}
+						format = t;
+						const s = view.getUint32(1);
+						if (s > maxFrame) {
+							throw new BudgetError(
+								binaryErrorBudget(offset, 'maxFrame'),
+							);
+						}
+						if (l - i >= s) {
+							emit(c, d.subarray(i, i += s));
+							continue;
+						}
+						body = new Uint8Array(s);
+						f = 0;
+					}
+					const n = Math.min(body.length - f, l - i);
+					body.set(d.subarray(i, i += n), f);
+					if ((f += n) === body.length) {
+						const b = body;
+						body = null;
+						emit(c, b);
+					}
+				}
+			},
+			flush(): void {
+				if (h || body) {
+					throw new SyntaxError(binaryError(offset));
+				}
+			},
+		});
+	}
+}
@@ -0,0 +1,83 @@
+import { assertEquals, assertNotStrictEquals, assertThrows } from '@std/assert';
+import { PLArray } from './array.ts';
+import { PLBoolean } from './boolean.ts';
+import { PLData } from './data.ts';
+import { PLDate } from './date.ts';
+import { PLDictionary } from './dictionary.ts';
+import { freeze, isFrozen } from './freeze.ts';
+import { PLInteger } from './integer.ts';
+import { PLReal } from './real.ts';
+import { PLSet } from './set.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+import { PLUID } from './uid.ts';
+
+const MSG = 'Cannot modify frozen plist';
+
+Deno.test('freeze', () => {
+	const str = new PLString('a');
+	const int = new PLInteger(1);
+	const real = new PLReal(1);
+	const bool = new PLBoolean();
+	const date = new PLDate();
+	const uid = new PLUID();
+	const data = new PLData(new Uint8Array([1, 2]).buffer);
+	const array = new PLArray<PLType>([str, int]);
+	const set = new PLSet<PLType>([real]);
+	const dict = new PLDictionary<PLType, PLType>([
+		[str, array],
+		[int, set],
+		[new PLString('b'), new PLArray([bool, date, uid, data])],
+	]);
+	const free = new PLArray();
+	assertEquals(isFrozen(dict), false);
+	assertEquals(freeze(dict), dict);
+	for (const v of [dict, str, int, real, bool, date, uid, data, array, set]) {
+		assertEquals(isFrozen(v), true);
+	}
+	assertEquals(isFrozen(free), false);
+	free.push(str);
+
+	assertThrows(() => str.value = 'b', TypeError, MSG);
+	assertThrows(() => int.value = 2, TypeError, MSG);
+	assertThrows(() => int.bits = 128, TypeError, MSG);
+	assertThrows(() => real.value = 2, TypeError, MSG);
+	assertThrows(() => real.bits = 32, TypeError, MSG);
+	assertThrows(() => bool.value = true, TypeError, MSG);
+	assertThrows(() => date.time = 1, TypeError, MSG);
+	assertThrows(() => date.year = 1, TypeError, MSG);
+	assertThrows(() => uid.value = 1n, TypeError, MSG);
+	for (
+		const f of [
+			() => array.set(0, str),
+			() => array.push(str),
+			() => array.pop(),
+			() => array.unshift(str),
+			() => array.shift(),
+			() => array.splice(0, 1),
+			() => array.reverse(),
+			() => array.fill(str),
+			() => array.copyWithin(0, 1),
+			() => array.clear(),
+			() => set.add(str),
+			() => set.delete(real),
+			() => set.clear(),
+			() => dict.set(str, str),
+			() => dict.delete(str),
+			() => dict.clear(),
+			() => dict.getOrInsert(real, str),
+			() => dict.getOrInsertComputed(real, () => str),
+		]
+	) {
+		assertThrows(f, TypeError, MSG);
+	}
+	assertEquals(dict.getOrInsert(str, str), array);
+	assertEquals(array.length, 2);
+	assertEquals(set.size, 1);
+	assertEquals(dict.size, 3);
+
+	assertNotStrictEquals(data.buffer, data.buffer);
+	new Uint8Array(data.buffer)[0] = 9;
+	new Uint8Array(data.valueOf())[0] = 9;
+	assertEquals([...new Uint8Array(data.buffer)], [1, 2]);
+});
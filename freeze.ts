@@ -0,0 +1,39 @@
+/**
+ * @module
+ *
+ * Property list freezing.
+ */
+
+import { frozen } from './pri/mutate.ts';
+import type { PLType } from './type.ts';
+import { walk } from './walk.ts';
+
+/**
+ * Deep freeze a plist, so that modifying methods and setters throw.
+ * Frozen data returns a copy of the buffer for each access.
+ *
+ * @template T Plist type.
+ * @param plist Plist object.
+ * @returns Same plist object.
+ */
+export function freeze<T extends PLType>(plist: T): T {
+	walk(plist, {
+		default(v): boolean | void {
+			if (frozen.has(v)) {
+				return true;
+			}
+			frozen.add(v);
+		},
+	});
+	return plist;
+}
+
+/**
+ * Check if plist object is frozen.
+ *
+ * @param plist Plist object.
+ * @returns Is frozen.
+ */
+export function isFrozen(plist: PLType): boolean {
+	return frozen.has(plist);
+}
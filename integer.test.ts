@@ -1,4 +1,4 @@
-import { assertEquals, assertThrows } from '@std/assert';
+import { assertEquals, assertStrictEquals, assertThrows } from '@std/assert';
 import { PLInteger, PLTYPE_INTEGER } from './integer.ts';
 import { PLReal } from './real.ts';
 
@@ -93,6 +93,67 @@ Deno.test('value wrap', () => {
 	}
 });
 
+Deno.test('number value', () => {
+	const pl = new PLInteger(42);
+	assertEquals(pl.value, 42n);
+	assertStrictEquals(pl.compact, 42);
+	pl.value = -42;
+	assertEquals(pl.value, -42n);
+	assertStrictEquals(pl.compact, -42);
+	pl.value = -0;
+	assertStrictEquals(pl.compact, 0);
+	assertThrows(() => {
+		pl.value = 1.5;
+	}, RangeError);
+	assertStrictEquals(pl.compact, 0);
+	for (const bits of [8, 16, 32, 64, 128] as const) {
+		pl.bits = bits;
+		const max = (1n << BigInt(bits - 1)) - 1n;
+		const min = -(max + 1n);
+		for (
+			const [i, w] of [
+				[0n, 0n],
+				[max, max],
+				[max + 1n, min],
+				[min, min],
+				[min - 1n, max],
+			]
+		) {
+			const n = Number(i);
+			if (Number.isSafeInteger(n)) {
+				assertEquals(new PLInteger(n, bits).value, w, `${i} -> ${w}`);
+				pl.value = n;
+				assertEquals(pl.value, w, `${i} -> ${w}`);
+			}
+		}
+	}
+});
+
+Deno.test('compact', () => {
+	for (
+		const [i, w] of [
+			[0n, 0],
+			[1n, 1],
+			[-1n, -1],
+			[0x1fffffffffffffn, 0x1fffffffffffff],
+			[-0x1fffffffffffffn, -0x1fffffffffffff],
+			[0x20000000000000n, 0x20000000000000n],
+			[-0x20000000000000n, -0x20000000000000n],
+			[0x7fffffffffffffffn, 0x7fffffffffffffffn],
+		] as const
+	) {
+		assertStrictEquals(new PLInteger(i).compact, w, `${i}`);
+	}
+	const pl = new PLInteger(0x10000000000000001n, 128);
+	assertStrictEquals(pl.compact, 0x10000000000000001n);
+	pl.bits = 64;
+	assertStrictEquals(pl.compact, 1);
+	pl.value = Number.MAX_SAFE_INTEGER + 1;
+	assertStrictEquals(pl.compact, 0x20000000000000n);
+	pl.value = 0x20000000000000n - 1n;
+	assertStrictEquals(pl.compact, Number.MAX_SAFE_INTEGER);
+});
+
 Deno.test('valueOf', () => {
 	const pl = new PLInteger();
 	assertEquals(pl.valueOf(), 0n);
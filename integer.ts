@@ -4,6 +4,7 @@
  * Property list integer.
  */
 
+import { mutable } from './pri/mutate.ts';
 import type { PLType } from './type.ts';
 
 /**
@@ -11,9 +12,37 @@ import type { PLType } from './type.ts';
  */
 export type PLIntegerBits = 8 | 16 | 32 | 64 | 128;
 
-const values = new WeakMap<PLInteger, bigint>();
+const values = new WeakMap<PLInteger, number | bigint>();
 const bitses = new WeakMap<PLInteger, PLIntegerBits>();
 
+/**
+ * Wrap integer to bits, stored as number when a safe integer.
+ *
+ * @param value Integer value.
+ * @param bits Integer bits.
+ * @returns Integer value.
+ */
+function wrap(value: number | bigint, bits: PLIntegerBits): number | bigint {
+	if (typeof value === 'number' && Number.isSafeInteger(value)) {
+		switch (bits) {
+			case 8: {
+				return value << 24 >> 24;
+			}
+			case 16: {
+				return value << 16 >> 16;
+			}
+			case 32: {
+				return value | 0;
+			}
+		}
+		return value || 0;
+	}
+	value = BigInt.asIntN(bits, BigInt(value));
+	return value < -0x1fffffffffffffn || value > 0x1fffffffffffffn
+		? value
+		: Number(value);
+}
+
 /**
  * PLInteger type.
  */
@@ -36,31 +65,30 @@ export class PLInteger {
 	 * @param value Integer value.
 	 * @param bits Integer bits.
 	 */
-	constructor(value = 0n, bits: PLIntegerBits = 64) {
-		value = BigInt(value);
+	constructor(value: bigint | number = 0n, bits: PLIntegerBits = 64) {
 		switch ((+bits || 0) - (bits % 1 || 0)) {
 			case 8: {
-				values.set(this, BigInt.asIntN(8, value));
+				values.set(this, wrap(value, 8));
 				bitses.set(this, 8);
 				break;
 			}
 			case 16: {
-				values.set(this, BigInt.asIntN(16, value));
+				values.set(this, wrap(value, 16));
 				bitses.set(this, 16);
 				break;
 			}
 			case 32: {
-				values.set(this, BigInt.asIntN(32, value));
+				values.set(this, wrap(value, 32));
 				bitses.set(this, 32);
 				break;
 			}
 			case 64: {
-				values.set(this, BigInt.asIntN(64, value));
+				values.set(this, wrap(value, 64));
 				bitses.set(this, 64);
 				break;
 			}
 			case 128: {
-				values.set(this, BigInt.asIntN(128, value));
+				values.set(this, wrap(value, 128));
 				bitses.set(this, 128);
 				break;
 			}
@@ -76,7 +104,7 @@ export class PLInteger {
 	 * @returns Integer value.
 	 */
 	public get value(): bigint {
-		return values.get(this)!;
+		return BigInt(values.get(this)!);
 	}
 
 	/**
@@ -84,9 +112,18 @@ export class PLInteger {
 	 *
 	 * @param value Integer value.
 	 */
-	public set value(value: bigint) {
-		value = BigInt(value);
-		values.set(this, BigInt.asIntN(bitses.get(this)!, value));
+	public set value(value: bigint | number) {
+		mutable(this);
+		values.set(this, wrap(value, bitses.get(this)!));
+	}
+
+	/**
+	 * Get integer value, as a number when a safe integer.
+	 *
+	 * @returns Integer value.
+	 */
+	public get compact(): number | bigint {
+		return values.get(this)!;
 	}
 
 	/**
@@ -104,24 +141,25 @@ export class PLInteger {
 	 * @param bits Integer bits.
 	 */
 	public set bits(bits: PLIntegerBits) {
+		mutable(this);
 		switch ((+bits || 0) - (bits % 1 || 0)) {
 			case 8: {
-				values.set(this, BigInt.asIntN(8, values.get(this)!));
+				values.set(this, wrap(values.get(this)!, 8));
 				bitses.set(this, 8);
 				break;
 			}
 			case 16: {
-				values.set(this, BigInt.asIntN(16, values.get(this)!));
+				values.set(this, wrap(values.get(this)!, 16));
 				bitses.set(this, 16);
 				break;
 			}
 			case 32: {
-				values.set(this, BigInt.asIntN(32, values.get(this)!));
+				values.set(this, wrap(values.get(this)!, 32));
 				bitses.set(this, 32);
 				break;
 			}
 			case 64: {
-				values.set(this, BigInt.asIntN(64, values.get(this)!));
+				values.set(this, wrap(values.get(this)!, 64));
 				bitses.set(this, 64);
 				break;
 			}
@@ -141,7 +179,7 @@ export class PLInteger {
 	 * @returns Integer value.
 	 */
 	public valueOf(): bigint {
-		return values.get(this)!;
+		return BigInt(values.get(this)!);
 	}
 
 	/**
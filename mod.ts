@@ -4,19 +4,35 @@
  * Everything Plist.
  */
 
+export * from './archive.ts';
 export * from './array.ts';
+export * from './async.ts';
 export * from './boolean.ts';
+export * from './budget.ts';
+export * from './cache.ts';
+export * from './compress.ts';
 export * from './data.ts';
 export * from './date.ts';
 export * from './decode/mod.ts';
 export * from './dictionary.ts';
+export * from './diff.ts';
 export * from './encode/mod.ts';
+export * from './fingerprint.ts';
 export * from './format.ts';
+export * from './frame.ts';
+export * from './freeze.ts';
 export * from './integer.ts';
 export * from './null.ts';
+export * from './overlay.ts';
+export * from './pack.ts';
+export * from './query.ts';
 export * from './real.ts';
+export * from './retained.ts';
+export * from './schema.ts';
 export * from './set.ts';
 export * from './string.ts';
+export * from './trace.ts';
+export * from './transcode.ts';
 export * from './type.ts';
 export * from './uid.ts';
 export * from './walk.ts';
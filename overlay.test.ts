@@ -0,0 +1,153 @@
+import {
+	assertEquals,
+	assertInstanceOf,
+	assertNotStrictEquals,
+	assertStrictEquals,
+} from '@std/assert';
+import { PLArray } from './array.ts';
+import { PLDictionary } from './dictionary.ts';
+import { encodeXml } from './encode/xml.ts';
+import { deepEqual, fingerprint } from './fingerprint.ts';
+import { PLInteger } from './integer.ts';
+import { PlistOverlay } from './overlay.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+
+function dict(o: Record<string, PLType>): PLDictionary<PLString, PLType> {
+	return new PLDictionary(
+		Object.entries(o).map(([k, v]) => [new PLString(k), v]),
+	);
+}
+
+Deno.test('PlistOverlay: get', () => {
+	const a = new PLString('a');
+	const b = new PLString('b');
+	const base = dict({ name: a, size: new PLInteger(1) });
+	const top = dict({ name: b });
+	const overlay = new PlistOverlay([base, top]);
+	assertStrictEquals(overlay.get('name'), b);
+	assertStrictEquals(overlay.get(new PLString('name')), b);
+	assertEquals(overlay.get('size')?.valueOf(), 1n);
+	assertEquals(overlay.get('none'), undefined);
+	assertEquals(overlay.has('size'), true);
+	assertEquals(overlay.has('none'), false);
+	assertEquals(overlay.size, 2);
+	assertEquals(overlay.layers, [base, top]);
+	assertEquals(
+		[...overlay.keys()].map(String),
+		['name', 'size'],
+	);
+	assertEquals([...overlay.values()][0], b);
+});
+
+Deno.test('PlistOverlay: nested', () => {
+	const local = dict({
+		host: new PLString('localhost'),
+		port: new PLInteger(80),
+	});
+	const base = dict({
+		server: local,
+		list: new PLArray([new PLString('a')]),
+	});
+	const site = dict({ server: dict({ port: new PLInteger(8080) }) });
+	const host = dict({ list: new PLArray() });
+	const overlay = new PlistOverlay([base, site, host]);
+	const server = overlay.get('server');
+	assertInstanceOf(server, PlistOverlay);
+	assertStrictEquals(overlay.get('server'), server);
+	assertEquals(server.get('host')?.valueOf(), 'localhost');
+	assertEquals(server.get('port')?.valueOf(), 8080n);
+	assertEquals((overlay.get('list') as PLArray).length, 0);
+
+	const over = new PlistOverlay([base, dict({ server: new PLString('x') })]);
+	assertEquals(over.get('server')?.valueOf(), 'x');
+	const single = new PlistOverlay([base, host]);
+	assertStrictEquals(single.get('server'), local);
+	const under = new PlistOverlay([dict({ server: new PLString('x') }), site]);
+	assertInstanceOf(under.get('server'), PLDictionary);
+});
+
+Deno.test('PlistOverlay: changes', () => {
+	const inner = dict({});
+	const base = dict({ a: new PLString('a'), nest: inner });
+	const top = dict({ nest: dict({ x: new PLString('x') }) });
+	const overlay = new PlistOverlay([base, top]);
+	const nest = overlay.get('nest') as PlistOverlay;
+	assertEquals(overlay.size, 2);
+	assertEquals(nest.size, 1);
+
+	top.set(new PLString('b'), new PLString('b'));
+	assertEquals(overlay.size, 3);
+	assertEquals(overlay.get('b')?.valueOf(), 'b');
+	assertNotStrictEquals(overlay.get('nest'), nest);
+
+	const again = overlay.get('nest') as PlistOverlay;
+	inner.set(new PLString('y'), new PLString('y'));
+	assertStrictEquals(overlay.get('nest'), again);
+	assertEquals(again.get('y')?.valueOf(), 'y');
+	assertEquals(again.size, 2);
+
+	base.delete(base.findKey((_, k) => k.value === 'a')!);
+	assertEquals(overlay.has('a'), false);
+	assertEquals(overlay.size, 2);
+});
+
+Deno.test('PlistOverlay: rename key', () => {
+	const a = new PLString('a');
+	const base = dict({ b: new PLString('base') });
+	const top = new PLDictionary<PLString, PLType>([[a, new PLString('top')]]);
+	const overlay = new PlistOverlay([base, top]);
+	assertEquals(overlay.has('a'), true);
+	assertEquals(overlay.size, 2);
+
+	a.value = 'b';
+	assertEquals(overlay.has('a'), false);
+	assertEquals(overlay.get('b')?.valueOf(), 'top');
+	assertEquals([...overlay.keys()].map(String), ['b']);
+	assertEquals(overlay.size, 1);
+	assertEquals(new PlistOverlay([base, top]).has('a'), false);
+});
+
+Deno.test('PlistOverlay: fingerprint', () => {
+	const base = dict({ a: new PLString('a') });
+	const top = dict({ b: new PLString('b') });
+	const outer = new PLArray<PLType>([base]);
+	const print = fingerprint(outer);
+	const overlay = new PlistOverlay([base, top]);
+	assertEquals(overlay.size, 2);
+	base.set(new PLString('c'), new PLString('c'));
+	assertEquals(overlay.size, 3);
+	assertNotStrictEquals(fingerprint(outer), print);
+});
+
+Deno.test('PlistOverlay: materialize', () => {
+	const shared = new PLArray();
+	const base = dict({
+		a: new PLString('a'),
+		nest: dict({ x: new PLString('x'), y: new PLString('y') }),
+		shared,
+	});
+	const top = dict({
+		a: new PLString('A'),
+		nest: dict({ y: new PLString('Y'), z: new PLString('z') }),
+	});
+	const plist = new PlistOverlay([base, top]).materialize();
+	assertEquals(
+		deepEqual(
+			plist,
+			dict({
+				a: new PLString('A'),
+				nest: dict({
+					x: new PLString('x'),
+					y: new PLString('Y'),
+					z: new PLString('z'),
+				}),
+				shared,
+			}),
+			{ ordered: true },
+		),
+		true,
+	);
+	assertStrictEquals(plist.toValueMap().get('shared'), shared);
+	assertEquals(encodeXml(plist).length > 0, true);
+});
@@ -0,0 +1,275 @@
+/**
+ * @module
+ *
+ * Property list dictionary overlays.
+ */
+
+import { PLDictionary, PLTYPE_DICTIONARY } from './dictionary.ts';
+import { indexes, link, parents } from './pri/mutate.ts';
+import { type PLString, PLTYPE_STRING } from './string.ts';
+import type { PLType } from './type.ts';
+
+/**
+ * Overlay value, nested overlay where more than one layer has a dictionary.
+ */
+export type PlistOverlayValue = PLType | PlistOverlay;
+
+/**
+ * Overlay state.
+ */
+interface State {
+	/**
+	 * Layers, lowest first.
+	 */
+	l: PLDictionary[];
+
+	/**
+	 * Layer indexes resolved against.
+	 */
+	i: (Map<unknown, [PLType, PLType]> | null)[];
+
+	/**
+	 * Resolved values by key value.
+	 */
+	r: Map<unknown, PlistOverlayValue | undefined>;
+
+	/**
+	 * All keys by key value, highest layer key, or null until needed.
+	 */
+	k: Map<unknown, PLType> | null;
+}
+
+const states = new WeakMap<PlistOverlay, State>();
+
+/**
+ * Get key value, strings by value, others by identity.
+ *
+ * @param key Key.
+ * @returns Key value.
+ */
+function keyOf(key: PLType | string): unknown {
+	return typeof key === 'string'
+		? key
+		: key[Symbol.toStringTag] === PLTYPE_STRING
+		? (key as PLString).value
+		: key;
+}
+
+/**
+ * Get tracked dictionary index, by key value, last key wins.
+ *
+ * @param d Dictionary.
+ * @returns Index.
+ */
+function index(d: PLDictionary): Map<unknown, [PLType, PLType]> {
+	let m = indexes.get(d);
+	if (!m) {
+		m = new Map();
+		for (const e of d) {
+			m.set(keyOf(e[0]), e);
+			// Renaming a key changes the index.
+			link(e[0], d);
+		}
+		indexes.set(d, m);
+		if (!parents.has(d)) {
+			parents.set(d, null);
+		}
+	}
+	return m;
+}
+
+/**
+ * Get state, clearing resolved values if any layer changed.
+ *
+ * @param overlay Overlay.
+ * @returns State.
+ */
+function sync(overlay: PlistOverlay): State {
+	const s = states.get(overlay)!;
+	const { l, i } = s;
+	let changed = false;
+	for (let n = l.length; n--;) {
+		const m = index(l[n]);
+		if (i[n] !== m) {
+			i[n] = m;
+			changed = true;
+		}
+	}
+	if (changed) {
+		s.r.clear();
+		s.k = null;
+	}
+	return s;
+}
+
+/**
+ * Resolve value, merging dictionaries from more than one layer.
+ *
+ * @param s State.
+ * @param k Key value.
+ * @returns Value or undefined.
+ */
+function resolve(s: State, k: unknown): PlistOverlayValue | undefined {
+	const { r, i } = s;
+	if (r.has(k)) {
+		return r.get(k);
+	}
+	let v: PlistOverlayValue | undefined;
+	const d: PLDictionary[] = [];
+	for (let n = i.length; n--;) {
+		const e = i[n]!.get(k);
+		if (e) {
+			if (e[1][Symbol.toStringTag] !== PLTYPE_DICTIONARY) {
+				if (!d.length) {
+					v = e[1];
+				}
+				break;
+			}
+			d.push(e[1] as PLDictionary);
+		}
+	}
+	if (d.length) {
+		v = d.length > 1 ? new PlistOverlay(d.reverse()) : d[0];
+	}
+	r.set(k, v);
+	return v;
+}
+
+/**
+ * Get all keys, by key value.
+ *
+ * @param s State.
+ * @returns Keys.
+ */
+function keys(s: State): Map<unknown, PLType> {
+	let k = s.k;
+	if (!k) {
+		s.k = k = new Map();
+		for (const m of s.i) {
+			for (const [x, e] of m!) {
+				k.set(x, e[0]);
+			}
+		}
+	}
+	return k;
+}
+
+/**
+ * Overlay view of dictionary layers, higher layers overriding lower ones.
+ * Dictionaries in more than one layer are merged as nested overlays.
+ * String keys match by value, other keys by identity.
+ * Layers are indexed once until changed, so changing layers only reindexes
+ * those changed, and resolved values are cached until any layer changes.
+ * Changes to nested dictionaries are seen by their nested overlays.
+ */
+export class PlistOverlay {
+	/**
+	 * Create overlay.
+	 *
+	 * @param layers Dictionary layers, lowest first.
+	 */
+	constructor(layers: Iterable<PLDictionary>) {
+		const l = [...layers];
+		states.set(this, {
+			l,
+			i: l.map(() => null),
+			r: new Map(),
+			k: null,
+		});
+	}
+
+	/**
+	 * Get layers.
+	 *
+	 * @returns Dictionary layers, lowest first.
+	 */
+	public get layers(): PLDictionary[] {
+		return [...states.get(this)!.l];
+	}
+
+	/**
+	 * Get size.
+	 *
+	 * @returns Number of keys in any layer.
+	 */
+	public get size(): number {
+		return keys(sync(this)).size;
+	}
+
+	/**
+	 * Check if any layer has key.
+	 *
+	 * @param key Key or string key value.
+	 * @returns Has.
+	 */
+	public has(key: PLType | string): boolean {
+		return resolve(sync(this), keyOf(key)) !== undefined;
+	}
+
+	/**
+	 * Get value for key, from the highest layer with key.
+	 *
+	 * @param key Key or string key value.
+	 * @returns Value or undefined.
+	 */
+	public get(key: PLType | string): PlistOverlayValue | undefined {
+		return resolve(sync(this), keyOf(key));
+	}
+
+	/**
+	 * Get overlay entries, in order keys were first seen from the lowest layer.
+	 *
+	 * @yields Overlay entries, with keys from the highest layer.
+	 */
+	public *entries(): Generator<[PLType, PlistOverlayValue]> {
+		const s = sync(this);
+		for (const [x, k] of keys(s)) {
+			yield [k, resolve(s, x)!];
+		}
+	}
+
+	/**
+	 * Get overlay keys.
+	 *
+	 * @yields Overlay keys, from the highest layer.
+	 */
+	public *keys(): Generator<PLType> {
+		for (const e of this.entries()) {
+			yield e[0];
+		}
+	}
+
+	/**
+	 * Get overlay values.
+	 *
+	 * @yields Overlay values.
+	 */
+	public *values(): Generator<PlistOverlayValue> {
+		for (const e of this.entries()) {
+			yield e[1];
+		}
+	}
+
+	/**
+	 * Get overlay iterator.
+	 *
+	 * @returns Overlay entries.
+	 */
+	public [Symbol.iterator](): Generator<[PLType, PlistOverlayValue]> {
+		return this.entries();
+	}
+
+	/**
+	 * Materialize as a new dictionary, nested overlays included.
+	 * Other values are shared with the layers, not copied.
+	 *
+	 * @returns Dictionary.
+	 */
+	public materialize(): PLDictionary {
+		const r = new PLDictionary();
+		for (const [k, v] of this) {
+			r.set(k, v instanceof PlistOverlay ? v.materialize() : v);
+		}
+		return r;
+	}
+}
@@ -0,0 +1,154 @@
+import { assertEquals, assertThrows } from '@std/assert';
+import { PLArray } from './array.ts';
+import { PLBoolean } from './boolean.ts';
+import { PLData } from './data.ts';
+import { PLDate } from './date.ts';
+import { decodeBinary } from './decode/binary.ts';
+import { PLDictionary } from './dictionary.ts';
+import { encodeBinary } from './encode/binary.ts';
+import { deepEqual } from './fingerprint.ts';
+import { PLInteger } from './integer.ts';
+import { PLNull } from './null.ts';
+import { PlistPack } from './pack.ts';
+import { PLReal } from './real.ts';
+import { PLSet } from './set.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+import { PLUID } from './uid.ts';
+
+function doc(i: number): PLType {
+	const list = new PLArray<PLType>();
+	for (let j = 0; j < 20; j++) {
+		list.push(new PLString(`item ${j % 5}`));
+	}
+	return new PLDictionary<PLType, PLType>([
+		[new PLString('CFBundleName'), new PLString(`App ${i % 10}`)],
+		[new PLString('CFBundleVersion'), new PLInteger(i % 3)],
+		[new PLString('LSRequiresIPhoneOS'), new PLBoolean(true)],
+		[new PLString('Items'), list],
+	]);
+}
+
+function mixed(): PLType {
+	return new PLDictionary<PLType, PLType>([
+		[new PLString('null'), new PLNull()],
+		[new PLString('bool'), new PLBoolean(false)],
+		[new PLString('int'), new PLInteger(-1n << 100n, 128)],
+		[new PLString('real'), new PLReal(1.5, 32)],
+		[new PLString('date'), new PLDate(12.5)],
+		[new PLString('data'), new PLData(new Uint8Array(300).buffer)],
+		[new PLString('uid'), new PLUID(7n)],
+		[new PLString('unicode'), new PLString('\u00e9\u4e16')],
+		[new PLString('set'), new PLSet([new PLString('a')])],
+		[new PLString('empty'), new PLArray()],
+		[new PLArray(), new PLDictionary()],
+		[new PLString('long'), new PLArray(new Array(300).fill(new PLNull()))],
+	]);
+}
+
+Deno.test('PlistPack: append and decode', () => {
+	const pack = new PlistPack();
+	assertEquals(pack.size, 0);
+	assertEquals(pack.bytes().length, 8);
+	const docs = [doc(0), mixed(), new PLString('leaf'), doc(1)];
+	const appended = [
+		pack.append(docs.slice(0, 2)),
+		pack.append(docs.slice(2)),
+	];
+	assertEquals(pack.size, 4);
+	assertEquals(pack.byteLength, 8 + appended[0].length + appended[1].length);
+	for (let i = 0; i < docs.length; i++) {
+		const { plist } = pack.decode(i);
+		assertEquals(deepEqual(plist, docs[i], { ordered: true }), true);
+		assertEquals(
+			deepEqual(decodeBinary(pack.binary(i)).plist, docs[i]),
+			true,
+		);
+	}
+	const { plist } = pack.decode(0, { query: 'CFBundleName' });
+	assertEquals((plist as PLArray).at(0)?.valueOf(), 'App 0');
+});
+
+Deno.test('PlistPack: shared pool', () => {
+	const pack = new PlistPack();
+	let separate = 0;
+	for (let i = 0; i < 100; i++) {
+		const plist = doc(i);
+		separate += encodeBinary(plist).length;
+		pack.append([plist]);
+	}
+	assertEquals(pack.size, 100);
+	assertEquals(pack.byteLength * 4 < separate, true);
+	const objects = pack.objects;
+	pack.append([doc(0), doc(1)]);
+	assertEquals(pack.objects, objects);
+});
+
+Deno.test('PlistPack: open and append', () => {
+	const pack = new PlistPack();
+	const parts = [pack.bytes(), pack.append([doc(0), doc(1)])];
+	const opened = new PlistPack(pack.bytes());
+	assertEquals(opened.size, 2);
+	assertEquals(opened.objects, pack.objects);
+	const objects = opened.objects;
+	parts.push(opened.append([doc(1), doc(5), mixed()]));
+	assertEquals(opened.objects > objects, true);
+	assertEquals(opened.objects < objects * 3, true);
+	const file = new Uint8Array(parts.reduce((n, p) => n + p.length, 0));
+	parts.reduce((n, p) => (file.set(p, n), n + p.length), 0);
+	assertEquals(opened.bytes(), file);
+	const reopened = new PlistPack(file);
+	assertEquals(reopened.size, 5);
+	const docs = [doc(0), doc(1), doc(1), doc(5), mixed()];
+	for (let i = 0; i < docs.length; i++) {
+		assertEquals(deepEqual(reopened.decode(i).plist, docs[i]), true);
+	}
+	reopened.append([]);
+	assertEquals(new PlistPack(reopened.bytes()).size, 5);
+});
+
+Deno.test('PlistPack: shared objects', () => {
+	const shared = new PLString('shared');
+	const plist = new PLArray([shared, shared, new PLString('shared')]);
+	const pack = new PlistPack();
+	pack.append([plist]);
+	assertEquals(pack.objects, 2);
+	const decoded = pack.decode(0).plist as PLArray;
+	assertEquals(decoded.at(0) === decoded.at(2), true);
+});
+
+Deno.test('PlistPack: invalid', () => {
+	const pack = new PlistPack();
+	const circular = new PLArray<PLType>();
+	circular.push(circular);
+	assertThrows(
+		() => pack.append([doc(0), circular]),
+		TypeError,
+		'Circular reference',
+	);
+	assertEquals(pack.size, 0);
+	assertEquals(pack.objects, 0);
+	const duplicate = new PLDictionary<PLType, PLType>([
+		[new PLString('a'), new PLInteger(1n)],
+		[new PLString('a'), new PLInteger(2n)],
+	]);
+	assertEquals(
+		(decodeBinary(encodeBinary(duplicate)).plist as PLDictionary).size,
+		2,
+	);
+	assertThrows(
+		() => pack.append([new PLArray([duplicate])]),
+		TypeError,
+		'Duplicate dictionary key',
+	);
+	assertEquals(pack.size, 0);
+	assertEquals(pack.objects, 0);
+	pack.append([doc(0)]);
+	for (const i of [-1, 1, 0.5, NaN]) {
+		assertThrows(() => pack.binary(i), RangeError, 'Invalid index');
+	}
+	const d = pack.bytes();
+	assertThrows(() => new PlistPack(d.slice(1)), SyntaxError);
+	assertThrows(() => new PlistPack(d.slice(0, -1)), SyntaxError);
+	assertThrows(() => new PlistPack(new Uint8Array(4)), SyntaxError);
+});
@@ -0,0 +1,671 @@
+/**
+ * @module
+ *
+ * Property list pack files.
+ */
+
+import { type PLArray, PLTYPE_ARRAY } from './array.ts';
+import {
+	decodeBinary,
+	type DecodeBinaryOptions,
+	type DecodeBinaryResult,
+} from './decode/binary.ts';
+import { type PLDictionary, PLTYPE_DICTIONARY } from './dictionary.ts';
+import { encodeBinary } from './encode/binary.ts';
+import { binaryError, bytes } from './pri/data.ts';
+import { type PLSet, PLTYPE_SET } from './set.ts';
+import type { PLType } from './type.ts';
+
+/**
+ * Pack segment.
+ */
+interface Segment {
+	/**
+	 * Segment bytes, or pack bytes containing it.
+	 */
+	d: Uint8Array;
+
+	/**
+	 * File offset of d.
+	 */
+	o: number;
+
+	/**
+	 * First object number.
+	 */
+	b: number;
+
+	/**
+	 * Object count.
+	 */
+	n: number;
+
+	/**
+	 * Offset table offset.
+	 */
+	t: number;
+
+	/**
+	 * Offset integer size.
+	 */
+	i: number;
+
+	/**
+	 * Reference integer size.
+	 */
+	r: number;
+}
+
+/**
+ * Pack state.
+ */
+interface State {
+	/**
+	 * Segments, in file order.
+	 */
+	s: Segment[];
+
+	/**
+	 * Document roots.
+	 */
+	r: number[];
+
+	/**
+	 * Object count.
+	 */
+	n: number;
+
+	/**
+	 * Byte length.
+	 */
+	l: number;
+
+	/**
+	 * Object numbers by key, or null until first append.
+	 */
+	u: Map<string, number> | null;
+}
+
+const states = new WeakMap<PlistPack, State>();
+
+/**
+ * Pack header.
+ */
+const HEADER = [112, 108, 112, 97, 99, 107, 48, 48];
+
+/**
+ * Number of bytes needed to encode integer.
+ *
+ * @param v Unsigned integer.
+ * @returns Byte count.
+ */
+const byteCount = (v: number): 1 | 2 | 4 | 8 =>
+	v > 65535 ? (v > 4294967295 ? 8 : 4) : (v > 255 ? 2 : 1);
+
+/**
+ * Get unsigned integer by byte count.
+ *
+ * @param d Data.
+ * @param i Offset.
+ * @param c Byte count.
+ * @returns Unsigned integer.
+ */
+function getInt(d: Uint8Array, i: number, c: number): number {
+	let r = 0;
+	for (; c--; r = r * 256 + d[i++]);
+	return r;
+}
+
+/**
+ * Set unsigned integer by byte count.
+ *
+ * @param d Data.
+ * @param i Offset.
+ * @param c Byte count.
+ * @param v Unsigned integer.
+ */
+function setInt(d: Uint8Array, i: number, c: number, v: number): void {
+	for (i += c; c--; v = Math.floor(v / 256)) {
+		d[--i] = v % 256;
+	}
+}
+
+/**
+ * Collection header.
+ */
+type Collection = [type: number, refs: number, offset: number];
+
+/**
+ * Get collection header.
+ *
+ * @param d Data.
+ * @param i Offset.
+ * @returns Marker type, reference count, and references offset,
+ * or null if not a collection.
+ */
+function collection(d: Uint8Array, i: number): Collection | null {
+	const m = d[i++];
+	const t = m >> 4;
+	if (t !== 10 && t !== 12 && t !== 13) {
+		return null;
+	}
+	let n = m & 15;
+	if (n === 15) {
+		const c = 1 << (d[i++] & 15);
+		n = getInt(d, i, c);
+		i += c;
+	}
+	return [t, t === 13 ? n + n : n, i];
+}
+
+/**
+ * Entry count of collection.
+ *
+ * @param c Collection header.
+ * @returns Entry count.
+ */
+const entries = (c: Collection): number => c[0] === 13 ? c[1] / 2 : c[1];
+
+/**
+ * Size of collection header.
+ *
+ * @param n Entry count.
+ * @returns Byte size.
+ */
+const headerSize = (n: number): number => n < 15 ? 1 : 2 + byteCount(n);
+
+/**
+ * Write collection header.
+ *
+ * @param d Data.
+ * @param i Offset.
+ * @param t Marker type.
+ * @param n Entry count.
+ * @returns Offset after header.
+ */
+function setHeader(d: Uint8Array, i: number, t: number, n: number): number {
+	if (n < 15) {
+		d[i++] = t << 4 | n;
+	} else {
+		const c = byteCount(n);
+		d[i++] = t << 4 | 15;
+		d[i++] = 16 | 31 - Math.clz32(c);
+		setInt(d, i, c, n);
+		i += c;
+	}
+	return i;
+}
+
+/**
+ * Key of collection, by marker type and references,
+ * never the same as a leaf key of byte characters.
+ *
+ * @param t Marker type.
+ * @param refs References.
+ * @returns Key.
+ */
+const collectionKey = (t: number, refs: number[]): string =>
+	`\u0100${t}:${refs}`;
+
+/**
+ * Key of leaf, by encoded bytes.
+ *
+ * @param d Encoded bytes.
+ * @returns Key.
+ */
+function leafKey(d: Uint8Array): string {
+	let r = '';
+	for (let i = 0, l = d.length; i < l; i += 0x1000) {
+		r += String.fromCharCode(...d.subarray(i, i + 0x1000));
+	}
+	return r;
+}
+
+/**
+ * Find segment of object.
+ *
+ * @param s Segments.
+ * @param ref Object number.
+ * @returns Segment.
+ */
+function segment(s: Segment[], ref: number): Segment {
+	let a = 0;
+	let b = s.length - 1;
+	while (a < b) {
+		const m = (a + b + 1) >> 1;
+		if (s[m].b > ref) {
+			b = m - 1;
+		} else {
+			a = m;
+		}
+	}
+	return s[a];
+}
+
+/**
+ * Get object bytes, relative to segment bytes.
+ *
+ * @param g Segment.
+ * @param ref Object number.
+ * @returns Start and end.
+ */
+function extent(g: Segment, ref: number): [number, number] {
+	const { d, o, b, n, t, i } = g;
+	const x = t - o + (ref - b) * i;
+	return [
+		getInt(d, x, i) - o,
+		ref - b + 1 < n ? getInt(d, x + i, i) - o : t - o,
+	];
+}
+
+/**
+ * Read segments and roots from pack bytes.
+ *
+ * @param d Pack bytes.
+ * @returns State.
+ */
+function open(d: Uint8Array): State {
+	const l = d.length;
+	const s: Segment[] = [];
+	const roots: number[][] = [];
+	if (l < 8 || HEADER.some((c, i) => d[i] !== c)) {
+		throw new SyntaxError(binaryError(0));
+	}
+	for (let e = l; e > 8;) {
+		let x = e - 32;
+		if (x < 8) {
+			throw new SyntaxError(binaryError(e));
+		}
+		const i = d[x + 6];
+		const r = d[x + 7];
+		const n = getInt(d, x + 8, 8);
+		const m = getInt(d, x + 16, 8);
+		const t = getInt(d, x + 24, 8);
+		if (
+			(i !== 1 && i !== 2 && i !== 4 && i !== 8) ||
+			(r !== 1 && r !== 2 && r !== 4 && r !== 8) ||
+			t < 8 ||
+			t + n * i + m * r !== x
+		) {
+			throw new SyntaxError(binaryError(x));
+		}
+		const start = n ? getInt(d, t, i) : t;
+		if (start < 8 || start > t) {
+			throw new SyntaxError(binaryError(t));
+		}
+		const rs: number[] = [];
+		for (x = t + n * i; m > rs.length; x += r) {
+			rs.push(getInt(d, x, r));
+		}
+		s.push({ d, o: 0, b: 0, n, t, i, r });
+		roots.push(rs);
+		e = start;
+	}
+	s.reverse();
+	roots.reverse();
+	let b = 0;
+	for (const g of s) {
+		g.b = b;
+		b += g.n;
+	}
+	const r = roots.flat();
+	for (const ref of r) {
+		if (ref >= b) {
+			throw new SyntaxError(binaryError(l));
+		}
+	}
+	return { s, r, n: b, l, u: null };
+}
+
+/**
+ * Object numbers by key, for all objects in the pack.
+ *
+ * @param s State.
+ * @returns Object numbers by key.
+ */
+function uniques(s: State): Map<string, number> {
+	let u = s.u;
+	if (!u) {
+		s.u = u = new Map();
+		for (const g of s.s) {
+			for (let ref = g.b, e = g.b + g.n; ref < e; ref++) {
+				const [a, z] = extent(g, ref);
+				const c = collection(g.d, a);
+				if (c) {
+					const refs = [];
+					for (let j = c[2], k = c[1]; k--; j += g.r) {
+						refs.push(getInt(g.d, j, g.r));
+					}
+					u.set(collectionKey(c[0], refs), ref);
+				} else {
+					u.set(leafKey(g.d.subarray(a, z)), ref);
+				}
+			}
+		}
+	}
+	return u;
+}
+
+/**
+ * Added leaf bytes, or collection marker type and references.
+ */
+type Added = Uint8Array | [type: number, refs: number[]];
+
+/**
+ * Add plist objects to pool, children first, uniqued by key.
+ *
+ * @param plist Plist object.
+ * @param u Object numbers by key.
+ * @param base First added object number.
+ * @param added Added objects.
+ * @param refs Object numbers by plist object.
+ * @returns Object number.
+ */
+function pool(
+	plist: PLType,
+	u: Map<string, number>,
+	base: number,
+	added: Added[],
+	refs: Map<PLType, number>,
+): number {
+	const add = (k: string, o: Added): number => {
+		let ref = u.get(k);
+		if (ref === undefined) {
+			u.set(k, ref = base + added.length);
+			added.push(o);
+		}
+		return ref;
+	};
+	const stack: [PLType, Iterator<PLType>, number[]][] = [];
+	const ancestors = new Set<PLType>();
+	let ref = -1;
+	for (let v: PLType | null = plist;;) {
+		if (!v) {
+			const [c, , a] = stack.pop()!;
+			ancestors.delete(c);
+			const t = c[Symbol.toStringTag] === PLTYPE_ARRAY
+				? 10
+				: c[Symbol.toStringTag] === PLTYPE_SET
+				? 12
+				: 13;
+			// Equal keys would pool into one, and decode as fewer entries.
+			const keys = a.length / 2;
+			if (t === 13 && new Set(a.slice(0, keys)).size < keys) {
+				throw new TypeError('Duplicate dictionary key');
+			}
+			refs.set(c, ref = add(collectionKey(t, a), [t, a]));
+		} else if ((ref = refs.get(v) ?? -1) < 0) {
+			let items: Iterable<PLType> | null = null;
+			switch (v[Symbol.toStringTag]) {
+				case PLTYPE_ARRAY:
+				case PLTYPE_SET: {
+					items = v as PLArray | PLSet;
+					break;
+				}
+				case PLTYPE_DICTIONARY: {
+					const d = v as PLDictionary;
+					items = [...d.keys(), ...d.values()];
+					break;
+				}
+			}
+			if (items) {
+				if (ancestors.has(v)) {
+					throw new TypeError('Circular reference');
+				}
+				ancestors.add(v);
+				const it = items[Symbol.iterator]();
+				stack.push([v, it, []]);
+				const next = it.next();
+				v = next.done ? null : next.value;
+				continue;
+			}
+			const e = encodeBinary(v);
+			const leaf = e.subarray(8, getInt(e, e.length - 8, 8));
+			refs.set(v, ref = add(leafKey(leaf), leaf));
+		}
+		const top = stack[stack.length - 1];
+		if (!top) {
+			return ref;
+		}
+		top[2].push(ref);
+		const next = top[1].next();
+		v = next.done ? null : next.value;
+	}
+}
+
+/**
+ * Write segment.
+ *
+ * @param s State.
+ * @param added Added leaf bytes or collections.
+ * @param roots Document roots.
+ * @returns Segment bytes.
+ */
+function write(
+	s: State,
+	added: Added[],
+	roots: number[],
+): Uint8Array<ArrayBuffer> {
+	const o = s.l;
+	const n = s.n + added.length;
+	const refC = byteCount(n);
+	let size = 0;
+	for (const v of added) {
+		size += v instanceof Uint8Array
+			? v.length
+			: headerSize(v[0] === 13 ? v[1].length / 2 : v[1].length) +
+				v[1].length * refC;
+	}
+	const intC = byteCount(o + size);
+	const t = size + added.length * intC;
+	const d = new Uint8Array(t + roots.length * refC + 32);
+	let i = 0;
+	let x = size;
+	for (const v of added) {
+		setInt(d, x, intC, o + i);
+		x += intC;
+		if (v instanceof Uint8Array) {
+			d.set(v, i);
+			i += v.length;
+		} else {
+			const [c, a] = v;
+			i = setHeader(d, i, c, c === 13 ? a.length / 2 : a.length);
+			for (const ref of a) {
+				setInt(d, i, refC, ref);
+				i += refC;
+			}
+		}
+	}
+	for (const ref of roots) {
+		setInt(d, x, refC, ref);
+		x += refC;
+	}
+	d[x + 6] = intC;
+	d[x + 7] = refC;
+	setInt(d, x + 8, 8, added.length);
+	setInt(d, x + 16, 8, roots.length);
+	setInt(d, x + 24, 8, o + size);
+	s.s.push({ d, o, b: s.n, n: added.length, t: o + size, i: intC, r: refC });
+	for (const ref of roots) {
+		s.r.push(ref);
+	}
+	s.n = n;
+	s.l = o + d.length;
+	return d;
+}
+
+/**
+ * Pack of many binary plists, sharing one pool of uniqued objects.
+ * Equal values and collections are stored once, across all documents,
+ * so decoded documents may share objects where the originals did not.
+ * Dictionaries with equal keys, that are distinct objects, are rejected,
+ * as their keys would be stored once.
+ * Appends write a segment of new objects and roots, so a pack file can
+ * be appended to without rewriting it.
+ * Reading a document collects only the objects it references.
+ */
+export class PlistPack {
+	/**
+	 * Open pack, or create an empty pack.
+	 *
+	 * @param data Pack bytes.
+	 */
+	constructor(data?: ArrayBufferView | ArrayBufferLike) {
+		states.set(
+			this,
+			data
+				? open(bytes(data))
+				: { s: [], r: [], n: 0, l: HEADER.length, u: null },
+		);
+	}
+
+	/**
+	 * Get number of documents.
+	 *
+	 * @returns Document count.
+	 */
+	public get size(): number {
+		return states.get(this)!.r.length;
+	}
+
+	/**
+	 * Get number of pooled objects.
+	 *
+	 * @returns Object count.
+	 */
+	public get objects(): number {
+		return states.get(this)!.n;
+	}
+
+	/**
+	 * Get byte length of pack.
+	 *
+	 * @returns Byte length.
+	 */
+	public get byteLength(): number {
+		return states.get(this)!.l;
+	}
+
+	/**
+	 * Append documents, in one segment.
+	 * Opening a pack indexes its objects on the first append.
+	 *
+	 * @param plists Plist objects.
+	 * @returns Segment bytes, to append to the pack file.
+	 */
+	public append(plists: Iterable<PLType>): Uint8Array<ArrayBuffer> {
+		const s = states.get(this)!;
+		const u = uniques(s);
+		const added: Added[] = [];
+		const refs = new Map<PLType, number>();
+		const roots: number[] = [];
+		try {
+			for (const plist of plists) {
+				roots.push(pool(plist, u, s.n, added, refs));
+			}
+		} catch (e) {
+			for (const [k, ref] of u) {
+				if (ref >= s.n) {
+					u.delete(k);
+				}
+			}
+			throw e;
+		}
+		return write(s, added, roots);
+	}
+
+	/**
+	 * Encode document as a standalone binary plist.
+	 *
+	 * @param index Document index.
+	 * @returns Binary plist.
+	 */
+	public binary(index: number): Uint8Array<ArrayBuffer> {
+		const { s, r, n } = states.get(this)!;
+		if (!(index >= 0 && index < r.length) || index % 1) {
+			throw new RangeError('Invalid index');
+		}
+		const local = new Map<number, number>([[r[index], 0]]);
+		const list: [Segment, number, number, Collection | null][] = [];
+		let size = 0;
+		for (let q = 0, refs = [r[index]]; q < refs.length; q++) {
+			const ref = refs[q];
+			const g = segment(s, ref);
+			const [a, z] = extent(g, ref);
+			const c = collection(g.d, a);
+			if (c) {
+				for (let j = c[2], k = c[1]; k--; j += g.r) {
+					const x = getInt(g.d, j, g.r);
+					if (!(x < n)) {
+						throw new SyntaxError(binaryError(g.o + j));
+					}
+					if (!local.has(x)) {
+						local.set(x, refs.length);
+						refs.push(x);
+					}
+				}
+			}
+			list.push([g, a, z, c]);
+		}
+		const refC = byteCount(list.length);
+		for (const [, a, z, c] of list) {
+			size += c ? headerSize(entries(c)) + c[1] * refC : z - a;
+		}
+		const intC = byteCount(size + 8);
+		const l = 8 + size + list.length * intC + 32;
+		const d = new Uint8Array(l);
+		d.set([98, 112, 108, 105, 115, 116, 48, 48]);
+		let i = 8;
+		let t = 8 + size;
+		for (const [g, a, z, c] of list) {
+			setInt(d, t, intC, i);
+			t += intC;
+			if (c) {
+				i = setHeader(d, i, c[0], entries(c));
+				for (let j = c[2], k = c[1]; k--; j += g.r, i += refC) {
+					setInt(d, i, refC, local.get(getInt(g.d, j, g.r))!);
+				}
+			} else {
+				d.set(g.d.subarray(a, z), i);
+				i += z - a;
+			}
+		}
+		d[t + 6] = intC;
+		d[t + 7] = refC;
+		setInt(d, t + 8, 8, list.length);
+		setInt(d, t + 24, 8, i);
+		return d;
+	}
+
+	/**
+	 * Decode document.
+	 *
+	 * @param index Document index.
+	 * @param options Decoding options.
+	 * @returns Decode result.
+	 */
+	public decode(
+		index: number,
+		options?: Readonly<DecodeBinaryOptions>,
+	): DecodeBinaryResult {
+		return decodeBinary(this.binary(index), options);
+	}
+
+	/**
+	 * Get pack bytes.
+	 *
+	 * @returns Pack bytes.
+	 */
+	public bytes(): Uint8Array<ArrayBuffer> {
+		const { s, l } = states.get(this)!;
+		const r = new Uint8Array(l);
+		r.set(HEADER);
+		let seen: Uint8Array | null = null;
+		for (const { d, o } of s) {
+			if (d !== seen) {
+				r.set(seen = d, o);
+			}
+		}
+		return r;
+	}
+}
@@ -0,0 +1,13 @@
+/**
+ * @module
+ *
+ * Array utils.
+ */
+
+import type { PLArray } from '../array.ts';
+import type { PLType } from '../type.ts';
+
+/**
+ * Array values, shared for direct iteration.
+ */
+export const arrays = new WeakMap<PLArray, Array<PLType>>();
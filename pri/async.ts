@@ -0,0 +1,63 @@
+/**
+ * @module
+ *
+ * Async utils.
+ */
+
+import type { AsyncOptions } from '../async.ts';
+
+/**
+ * Run steps to completion.
+ *
+ * @param steps Steps that never yield.
+ * @returns Result.
+ */
+export function sync<T>(steps: Generator<number, T, void>): T {
+	return steps.next().value as T;
+}
+
+/**
+ * Run steps, yielding to the event loop every time slice.
+ *
+ * @param start Start steps, with objects per step.
+ * @param options Async options.
+ * @returns Result.
+ */
+export async function sliced<T>(
+	start: (step: number) => Generator<number, T, void>,
+	{ signal, progress, step = 1024, slice = 10 }: Readonly<AsyncOptions>,
+): Promise<T> {
+	if (!(step >= 1)) {
+		throw new RangeError('Invalid step');
+	}
+	if (!(slice >= 0)) {
+		throw new RangeError('Invalid slice');
+	}
+	signal?.throwIfAborted();
+
+	const g = start(Math.floor(step));
+
+	// Message events are tasks, without the clamping of nested timers.
+	const { port1, port2 } = new MessageChannel();
+	let r;
+	try {
+		for (let t = Date.now(); !(r = g.next()).done;) {
+			progress?.(r.value);
+			signal?.throwIfAborted();
+			if (Date.now() - t >= slice) {
+				// deno-lint-ignore no-await-in-loop
+				await new Promise((resolve) => {
+					port1.onmessage = resolve;
+					port2.postMessage(null);
+				});
+				signal?.throwIfAborted();
+				t = Date.now();
+			}
+		}
+	} finally {
+		port1.close();
+		// Finish steps left by a throw, as aborting does.
+		g.return(undefined as T);
+	}
+	return r.value as T;
+}
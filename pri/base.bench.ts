@@ -0,0 +1,17 @@
+import { b64Decode } from './base.ts';
+
+const data = new Uint8Array(30000).map((_, i) => i * 31);
+const size = data.length * 32;
+const text = btoa(String.fromCharCode(...data)).repeat(32);
+const encoded = new TextEncoder().encode(text);
+const wrapped = new TextEncoder().encode(
+	text.replace(/.{76}/g, '$&\n\t\t'),
+);
+
+Deno.bench('b64Decode', { group: 'b64Decode', baseline: true }, () => {
+	b64Decode(encoded, 0, encoded.length, size);
+});
+
+Deno.bench('b64Decode: wrapped', { group: 'b64Decode' }, () => {
+	b64Decode(wrapped, 0, wrapped.length, size);
+});
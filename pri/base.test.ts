@@ -1,5 +1,5 @@
 import { assertEquals, assertLess } from '@std/assert';
-import { b16d, b64d, b64e } from './base.ts';
+import { b16d, b64d, b64Decode, b64e } from './base.ts';
 
 const b16 = '0123456789abcdef';
 const b64 = 'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/';
@@ -35,3 +35,24 @@ Deno.test('b64d', () => {
 		}
 	}
 });
+
+Deno.test('b64Decode', () => {
+	const te = new TextEncoder();
+	for (
+		const [s, e] of [
+			['', []],
+			['YQ==', [97]],
+			['YWI=', [97, 98]],
+			['YWJj', [97, 98, 99]],
+			[' YW\nJj\t', [97, 98, 99]],
+			['YW-Jj', [97, 98, 99]],
+		] as const
+	) {
+		const d = te.encode(`<${s}>`);
+		assertEquals(
+			new Uint8Array(b64Decode(d, 1, d.length - 1, e.length)),
+			new Uint8Array(e),
+			s,
+		);
+	}
+});
@@ -168,3 +168,53 @@ export const b64d = [
 	9,
 	9,
 ];
+
+/**
+ * Decode base64 range, skipping invalid characters like official decoders.
+ *
+ * @param d Encoded data.
+ * @param i Encoded start offset.
+ * @param l Encoded end offset.
+ * @param s Decoded size.
+ * @returns Decoded buffer.
+ */
+export function b64Decode(
+	d: Uint8Array,
+	i: number,
+	l: number,
+	s: number,
+): ArrayBuffer {
+	const r = new ArrayBuffer(s);
+	const o = new Uint8Array(r);
+	s = 0;
+	for (let a = 0, e = 0, t = 0, b, c; i < l; i++) {
+		c = d[i];
+		if (c > 42 && c < 123) {
+			b = b64d[c - 43] + c - 80;
+			if (b < 0) {
+				if (c !== 61) {
+					e = 0;
+					continue;
+				}
+				e++;
+				b = 0;
+			} else {
+				e = 0;
+			}
+			a = a << 6 | b;
+			if (++t & 4) {
+				o[s++] = a >> 16 & 255;
+				if (e < 2) {
+					o[s++] = a >> 8 & 255;
+					if (!e) {
+						o[s++] = a & 255;
+					}
+				}
+				t = 0;
+			}
+		} else if (c !== 9 && c !== 10 && c !== 13 && c !== 32) {
+			e = 0;
+		}
+	}
+	return r;
+}
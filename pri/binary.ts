@@ -0,0 +1,43 @@
+/**
+ * @module
+ *
+ * Binary utils.
+ */
+
+const U64_MAX = 0xffffffffffffffffn;
+
+/**
+ * Get uint of size.
+ *
+ * @param d Data.
+ * @param i Offset.
+ * @param c Byte count.
+ * @param m Max.
+ * @returns Integer.
+ */
+export function getU(d: Uint8Array, i: number, c: number, m = U64_MAX): bigint {
+	let r = 0n;
+	for (; c--;) {
+		r = r << 8n & m | BigInt(d[i++]);
+	}
+	return r;
+}
+
+/**
+ * Get uint of size, as number when small enough to be exact.
+ *
+ * @param d Data.
+ * @param i Offset.
+ * @param c Byte count.
+ * @returns Integer.
+ */
+export function getN(d: Uint8Array, i: number, c: number): number {
+	if (c > 6) {
+		return Number(getU(d, i, c));
+	}
+	let r = 0;
+	for (; c--;) {
+		r = r * 256 + d[i++];
+	}
+	return r;
+}
@@ -0,0 +1,50 @@
+/**
+ * @module
+ *
+ * Budget utils.
+ */
+
+import type { BudgetOptions } from '../budget.ts';
+
+/**
+ * Budget option names.
+ */
+const BUDGETS = ['maxDepth', 'maxObjects', 'maxBytes', 'maxLength'] as const;
+
+/**
+ * Get budgets from options.
+ *
+ * @param options Budget options.
+ * @returns Maximum depth, objects, bytes, and length.
+ */
+export function budget(
+	options: Readonly<BudgetOptions>,
+): [depth: number, objects: number, bytes: number, length: number] {
+	const r = [] as unknown as [number, number, number, number];
+	for (const k of BUDGETS) {
+		const v = options[k] ?? Infinity;
+		if (!(v >= 0)) {
+			throw new RangeError(`Invalid ${k}`);
+		}
+		r.push(v);
+	}
+	return r;
+}
+
+/**
+ * Budget options that are set, for options that nest per format options.
+ *
+ * @param options Budget options.
+ * @returns Budget options that are set, or null if none.
+ */
+export function budgets(
+	options: Readonly<BudgetOptions>,
+): BudgetOptions | null {
+	let r: BudgetOptions | null = null;
+	for (const k of BUDGETS) {
+		if (options[k] !== undefined) {
+			(r ??= {})[k] = options[k];
+		}
+	}
+	return r;
+}
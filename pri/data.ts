@@ -4,6 +4,8 @@
  * Data utils.
  */
 
+import type { PLData } from '../data.ts';
+
 /**
  * Get buffer or view as bytes.
  *
@@ -25,3 +27,92 @@ export function bytes(buffer: ArrayBufferView | ArrayBufferLike): Uint8Array {
 export function binaryError(offset: number): string {
 	return `Invalid binary data at 0x${offset.toString(16).toUpperCase()}`;
 }
+
+/**
+ * Error message for exceeded budget in binary.
+ *
+ * @param offset Offset.
+ * @param name Budget name.
+ * @returns Error message.
+ */
+export function binaryErrorBudget(offset: number, name: string): string {
+	return `Exceeded ${name} at 0x${offset.toString(16).toUpperCase()}`;
+}
+
+/**
+ * Lazy data source.
+ */
+export interface DataLazy {
+	/**
+	 * Encoded data.
+	 */
+	d: Uint8Array;
+
+	/**
+	 * Encoded start offset.
+	 */
+	i: number;
+
+	/**
+	 * Encoded end offset.
+	 */
+	e: number;
+
+	/**
+	 * Decoded size.
+	 */
+	s: number;
+
+	/**
+	 * Encoding is canonical and could be reused as is.
+	 */
+	c: boolean;
+
+	/**
+	 * Decoder.
+	 *
+	 * @param d Encoded data.
+	 * @param i Encoded start offset.
+	 * @param e Encoded end offset.
+	 * @param s Decoded size.
+	 * @returns Decoded buffer.
+	 */
+	f: (d: Uint8Array, i: number, e: number, s: number) => ArrayBuffer;
+}
+
+/**
+ * Lazy data sources, deleted when decoded.
+ */
+export const lazies = new WeakMap<object, DataLazy>();
+
+/**
+ * Data buffers, empty while a lazy source is set.
+ */
+export const buffers = new WeakMap<object, ArrayBufferLike>();
+
+/**
+ * Get data buffer, decoding any lazy source first.
+ * Never copied, even if frozen, so only for reading.
+ *
+ * @param data Data.
+ * @returns Data buffer.
+ */
+export function dataBuffer(data: PLData): ArrayBufferLike {
+	const lazy = lazies.get(data);
+	if (lazy) {
+		buffers.set(data, lazy.f(lazy.d, lazy.i, lazy.e, lazy.s));
+		lazies.delete(data);
+	}
+	return buffers.get(data)!;
+}
+
+/**
+ * Get data as bytes, never copied, so only for reading.
+ *
+ * @param data Data.
+ * @returns Bytes.
+ */
+export function dataBytes(data: PLData): Uint8Array {
+	const b = dataBuffer(data);
+	return new Uint8Array(b, data.byteOffset, data.byteLength);
+}
@@ -0,0 +1,25 @@
+import { getISO, getYMD, parseISO } from './date.ts';
+
+const times: number[] = [];
+for (let i = 0; i < 10000; i++) {
+	times.push((i - 5000) * 86400 * 37.3);
+}
+const isos = times.map((t) => getISO(t));
+
+Deno.bench('getYMD', () => {
+	for (const t of times) {
+		getYMD(t);
+	}
+});
+
+Deno.bench('getISO', () => {
+	for (const t of times) {
+		getISO(t);
+	}
+});
+
+Deno.bench('parseISO', () => {
+	for (const s of isos) {
+		parseISO(s);
+	}
+});
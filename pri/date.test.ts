@@ -1,13 +1,16 @@
 import { assertEquals } from '@std/assert';
 import {
 	getDay,
+	getFields,
 	getHour,
 	getISO,
 	getMinute,
 	getMonth,
 	getSecond,
 	getTime,
+	getTimes,
 	getYear,
+	getYMD,
 	parseISO,
 	setDay,
 	setHour,
@@ -39,6 +42,46 @@ Deno.test('getISO', () => {
 	assertEquals(getISO(0), '2001-01-01T00:00:00.000Z');
 });
 
+Deno.test('getYMD', () => {
+	for (let d = -146097 * 2; d < 146097 * 2; d += 13) {
+		const time = d * 86400 + 3600;
+		const date = new Date((time - UNIX_EPOCH) * 1000);
+		assertEquals(
+			getYMD(time),
+			[date.getUTCFullYear(), date.getUTCMonth() + 1, date.getUTCDate()],
+			`${time}`,
+		);
+	}
+	for (const time of [-1e14, 1e14, -1e14 - 86400, 1e14 + 86400]) {
+		assertEquals(
+			getYMD(time),
+			[getYear(time), getMonth(time), getDay(time)],
+			`${time}`,
+		);
+	}
+});
+
+Deno.test('getFields + getTimes', () => {
+	const times = startTimes.map((t) => t + 3723.5);
+	const fields = getFields(times, new Array<number>());
+	assertEquals(fields.slice(0, 12), [
+		2001,
+		1,
+		1,
+		1,
+		2,
+		3.5,
+		2004,
+		1,
+		1,
+		1,
+		2,
+		3.5,
+	]);
+	assertEquals(getTimes(fields, new Array<number>()), times);
+	assertEquals(getTimes(fields.slice(0, -1), []), times.slice(0, -1));
+});
+
 Deno.test('getTime: normal', () => {
 	assertEquals(
 		getTime(1970, 1, 1, 0, 0, 0),
@@ -35,39 +35,64 @@ function getDate(
 	month?: [number] | 0,
 	day?: [number] | 0,
 ): void {
-	// Convert time to days.
-	let z: bigint | number = time < 0
-		? (time === -Infinity
-			? -0x8000000000000000n
-			: BigInt.asIntN(64, BigInt(Math.floor(time / 86400))))
-		: (time === Infinity
-			? 0x7fffffffffffffffn
-			: BigInt.asIntN(64, BigInt(Math.floor(time / 86400 || 0))));
-
-	// Years of full 400 year cycles, and the remaining days.
-	let x: bigint | number = z / 146097n;
-	let y: bigint | number = x * 400n;
+	let x: bigint | number;
+	let y: bigint | number;
+	let z: bigint | number;
 	let m = 0;
-	z -= x * 146097n;
+	if (time > -1e14 && time < 1e14) {
+		// Convert time to days, small enough to not need 64-bit limits.
+		z = Math.floor(time / 86400);
+
+		// Years of full 400 year cycles, and the remaining days.
+		y = (x = Math.floor(z / 146097)) * 400;
+		z -= x * 146097;
 
-	// Turn the remaining years of days into years.
-	if (z < 0) {
-		do {
-			x = -(y--) % 400n;
-			m = +!(x & 3n || (x && !(x % 100n)));
-			z += m ? 366n : 365n;
-		} while (z < 0);
+		// Cycles from 2001 like from 1, last century, quad, and year can leap.
+		z -= (m = (x = z / 36524 | 0) > 3 ? 3 : x) * 36524;
+		y += m * 100;
+		z -= (x = z / 1461 | 0) * 1461;
+		y += x * 4;
+		m = +(x !== 24 || m === 3);
+		z -= (x = (x = z / 365 | 0) > 3 ? 3 : x) * 365;
+		y += x;
+		m &= +(x === 3);
+		if (year) {
+			year[0] = y + 2001;
+		}
 	} else {
-		for (let d = 365n; z >= d; d = m ? 366n : 365n) {
-			z -= d;
-			x = (++y + 1n) % 400n;
-			m = +!(x & 3n || (x && !(x % 100n)));
+		// Convert time to days.
+		z = time < 0
+			? (time === -Infinity
+				? -0x8000000000000000n
+				: BigInt.asIntN(64, BigInt(Math.floor(time / 86400))))
+			: (time === Infinity
+				? 0x7fffffffffffffffn
+				: BigInt.asIntN(64, BigInt(Math.floor(time / 86400 || 0))));
+
+		// Years of full 400 year cycles, and the remaining days.
+		x = z / 146097n;
+		y = x * 400n;
+		z -= x * 146097n;
+
+		// Turn the remaining years of days into years.
+		if (z < 0) {
+			do {
+				x = -(y--) % 400n;
+				m = +!(x & 3n || (x && !(x % 100n)));
+				z += m ? 366n : 365n;
+			} while (z < 0);
+		} else {
+			for (let d = 365n; z >= d; d = m ? 366n : 365n) {
+				z -= d;
+				x = (++y + 1n) % 400n;
+				m = +!(x & 3n || (x && !(x % 100n)));
+			}
+		}
+		if (year) {
+			year[0] = (y > 0x7fffffff - 2001)
+				? 0x7fffffff
+				: Number(BigInt.asIntN(32, y + 2001n));
 		}
-	}
-	if (year) {
-		year[0] = (y > 0x7fffffff - 2001)
-			? 0x7fffffff
-			: Number(BigInt.asIntN(32, y + 2001n));
 	}
 
 	if (month || day) {
@@ -284,25 +309,15 @@ export function getTime(
 	minute: number,
 	second: number,
 ): number {
-	let r;
-	let x;
 	let y = year - 2001 | 0;
 
 	// Years of full 400 year cycles, and the remaining days.
-	let z = (y / 400) | 0;
-	r = z * 146097;
+	const z = Math.floor(y / 400);
+	let r = z * 146097;
 	y -= z * 400;
 
-	// Remaining years of days.
-	if (y < 0) {
-		for (z = y; z; r -= x & 3 || (x && !(x % 100)) ? 365 : 366) {
-			x = -(++z) % 400;
-		}
-	} else {
-		for (z = 0; z < y; r += x & 3 || (x && !(x % 100)) ? 365 : 366) {
-			x = ++z % 400;
-		}
-	}
+	// Remaining years of days, plus leap days, like years from year 1.
+	r += y * 365 + (y >> 2) - (y / 100 | 0);
 
 	// Remaining months of days and add all together.
 	r += (month > 13 ? 0 : (DBM[month] +
@@ -317,16 +332,20 @@ export function getTime(
  * Encode date time to ISO format.
  *
  * @param time Date time.
+ * @param date Year, month, day, if already known.
  * @returns ISO string.
  */
-export function getISO(time: number): string {
-	getDate(time, Y, M, D);
-	let [x] = Y;
+export function getISO(time: number, date?: ArrayLike<number>): string {
+	if (!date) {
+		getDate(time, Y, M, D);
+		date = [Y[0], M[0], D[0]];
+	}
+	let x = date[0];
 	const YY = x < 0
 		? '-' + `${-x}`.padStart(6, '0')
 		: (x > 9999 ? '+' + `${x}`.padStart(6, '0') : `${x}`.padStart(4, '0'));
-	const MM = `${M[0]}`.padStart(2, '0');
-	const DD = `${D[0]}`.padStart(2, '0');
+	const MM = `${date[1]}`.padStart(2, '0');
+	const DD = `${date[2]}`.padStart(2, '0');
 	const hh = `${getHour(time)}`.padStart(2, '0');
 	const mm = `${getMinute(time)}`.padStart(2, '0');
 	const ss = `${time = (x = getSecond(time)) | 0}`.padStart(2, '0');
@@ -334,6 +353,64 @@ export function getISO(time: number): string {
 	return `${YY}-${MM}-${DD}T${hh}:${mm}:${ss}.${f}Z`;
 }
 
+/**
+ * Get year, month, day.
+ *
+ * @param time Date time.
+ * @returns Year, month, day.
+ */
+export function getYMD(time: number): [number, number, number] {
+	getDate(time, Y, M, D);
+	return [Y[0], M[0], D[0]];
+}
+
+/**
+ * Break down date times into year, month, day, hour, minute, second fields.
+ *
+ * @param times Date times.
+ * @param fields Fields, 6 per date time.
+ * @returns Fields.
+ */
+export function getFields<T extends { [index: number]: number }>(
+	times: ArrayLike<number>,
+	fields: T,
+): T {
+	for (let i = 0, j = 0, l = times.length, t; i < l;) {
+		getDate(t = times[i++], Y, M, D);
+		fields[j++] = Y[0];
+		fields[j++] = M[0];
+		fields[j++] = D[0];
+		fields[j++] = getHour(t);
+		fields[j++] = getMinute(t);
+		fields[j++] = getSecond(t);
+	}
+	return fields;
+}
+
+/**
+ * Create date times from year, month, day, hour, minute, second fields.
+ *
+ * @param fields Fields, 6 per date time.
+ * @param times Date times.
+ * @returns Date times.
+ */
+export function getTimes<T extends { [index: number]: number }>(
+	fields: ArrayLike<number>,
+	times: T,
+): T {
+	for (let i = 0, j = 0, l = fields.length - 5; j < l; j += 6) {
+		times[i++] = getTime(
+			fields[j],
+			fields[j + 1],
+			fields[j + 2],
+			fields[j + 3],
+			fields[j + 4],
+			fields[j + 5],
+		);
+	}
+	return times;
+}
+
 /**
  * Parse ISO format to date time.
  *
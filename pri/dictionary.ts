@@ -0,0 +1,13 @@
+/**
+ * @module
+ *
+ * Dictionary utils.
+ */
+
+import type { PLDictionary } from '../dictionary.ts';
+import type { PLType } from '../type.ts';
+
+/**
+ * Dictionary maps, shared for filling fresh dictionaries directly.
+ */
+export const maps = new WeakMap<PLDictionary, Map<PLType, PLType>>();
@@ -0,0 +1,114 @@
+import { assertEquals, assertNotEquals } from '@std/assert';
+import { PLArray } from '../array.ts';
+import { PLBoolean } from '../boolean.ts';
+import { PLData } from '../data.ts';
+import { PLDate } from '../date.ts';
+import { PLDictionary } from '../dictionary.ts';
+import { PLInteger } from '../integer.ts';
+import { PLNull } from '../null.ts';
+import { PLReal } from '../real.ts';
+import { PLSet } from '../set.ts';
+import { PLString } from '../string.ts';
+import type { PLType } from '../type.ts';
+import { PLUID } from '../uid.ts';
+import { digest, equal, hash, pairs } from './hash.ts';
+
+const str = (s: string) => new PLString(s);
+
+const tree = (): PLType =>
+	new PLDictionary<PLType, PLType>([
+		[str('a'), new PLArray([new PLInteger(1), new PLReal(1.5)])],
+		[str('b'), new PLSet([str('x'), str('y')])],
+		[str('c'), new PLData(new Uint8Array([1, 2, 3]).buffer)],
+		[str('d'), new PLDate(1)],
+		[new PLInteger(1), new PLBoolean(true)],
+		[str('n'), new PLNull()],
+		[str('u'), new PLUID(2n)],
+	]);
+
+Deno.test('hash', () => {
+	const c = new WeakMap();
+	const a = tree();
+	const b = tree();
+	assertEquals(hash(a, c), hash(b, c));
+	assertEquals(c.has(a), true);
+	assertNotEquals(hash(str('a'), c), hash(str('b'), c));
+	assertNotEquals(hash(str('1'), c), hash(new PLInteger(1), c));
+	assertNotEquals(
+		hash(new PLArray([str('a'), str('b')]), c),
+		hash(new PLArray([str('b'), str('a')]), c),
+	);
+	assertEquals(
+		hash(new PLSet([str('a'), str('b')]), c),
+		hash(new PLSet([str('b'), str('a')]), c),
+	);
+});
+
+Deno.test('equal', () => {
+	const c = new WeakMap();
+	assertEquals(equal(tree(), tree(), c), true);
+	assertEquals(
+		equal(
+			new PLDictionary([[str('a'), str('1')], [str('b'), str('2')]]),
+			new PLDictionary([[str('b'), str('2')], [str('a'), str('1')]]),
+			c,
+		),
+		true,
+	);
+	assertEquals(
+		equal(
+			new PLDictionary([[str('a'), str('1')], [str('b'), str('2')]]),
+			new PLDictionary([[str('a'), str('2')], [str('b'), str('1')]]),
+			c,
+		),
+		false,
+	);
+	assertEquals(equal(new PLInteger(1), new PLInteger(1, 128), c), false);
+	assertEquals(equal(new PLReal(0), new PLReal(-0), c), false);
+	assertEquals(equal(new PLReal(NaN), new PLReal(NaN), c), true);
+	assertEquals(equal(new PLReal(1), new PLReal(1, 32), c), false);
+	assertEquals(
+		equal(
+			new PLData(new Uint8Array([1, 2]).buffer),
+			new PLData(new Uint8Array([1, 3]).buffer),
+			c,
+		),
+		false,
+	);
+	assertEquals(
+		equal(new PLArray([str('a')]), new PLArray([str('a'), str('a')]), c),
+		false,
+	);
+});
+
+Deno.test('pairs', () => {
+	const c = new WeakMap();
+	assertEquals(
+		pairs(
+			[str('a'), str('b'), str('a'), str('c')],
+			[str('a'), str('a'), str('b')],
+			c,
+		),
+		[0, 2, 1, -1],
+	);
+});
+
+Deno.test('digest', () => {
+	const d = new Uint8Array(64 + 8);
+	for (let i = 0; i < d.length; i++) {
+		d[i] = i * 7;
+	}
+	for (let l = 0; l <= 64; l++) {
+		const h = digest(d.subarray(0, l));
+		for (let i = 1; i < 8; i++) {
+			const a = new Uint8Array(l + i);
+			a.set(d.subarray(0, l), i);
+			assertEquals(digest(a.subarray(i)), h, `${l}:${i}`);
+		}
+		if (l) {
+			const a = d.slice(0, l);
+			a[l - 1]++;
+			assertNotEquals(digest(a), h, `${l}`);
+		}
+	}
+});
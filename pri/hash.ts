@@ -0,0 +1,349 @@
+/**
+ * @module
+ *
+ * Hash utils.
+ */
+
+import { type PLArray, PLTYPE_ARRAY } from '../array.ts';
+import { type PLData, PLTYPE_DATA } from '../data.ts';
+import { type PLDate, PLTYPE_DATE } from '../date.ts';
+import { type PLDictionary, PLTYPE_DICTIONARY } from '../dictionary.ts';
+import { type PLInteger, PLTYPE_INTEGER } from '../integer.ts';
+import { type PLReal, PLTYPE_REAL } from '../real.ts';
+import { type PLSet, PLTYPE_SET } from '../set.ts';
+import type { PLType } from '../type.ts';
+import { walk } from '../walk.ts';
+import { arrays } from './array.ts';
+import { dataBytes } from './data.ts';
+import { link, parents } from './mutate.ts';
+
+/**
+ * Platform is little endian.
+ */
+const LE = new Uint8Array(new Uint32Array([1]).buffer)[0] === 1;
+
+/**
+ * Hash cache, only valid while hashed values are unchanged.
+ */
+export type Hashes = WeakMap<PLType, number>;
+
+/**
+ * Mix string into hash.
+ *
+ * @param h Hash.
+ * @param s String.
+ * @returns Hash.
+ */
+function mix(h: number, s: string): number {
+	for (let l = s.length, i = 0; i < l; i++) {
+		h = Math.imul(h ^ s.charCodeAt(i), 0x01000193);
+	}
+	return h;
+}
+
+/**
+ * Finalize hash.
+ *
+ * @param h Hash.
+ * @returns Hash.
+ */
+function fin(h: number): number {
+	h = Math.imul(h ^ h >>> 16, 0x85ebca6b);
+	h = Math.imul(h ^ h >>> 13, 0xc2b2ae35);
+	return h ^ h >>> 16;
+}
+
+/**
+ * Hash bytes, independent of alignment and platform endianness.
+ *
+ * @param d Bytes.
+ * @returns Hash.
+ */
+export function digest(d: Uint8Array): number {
+	const l = d.length;
+	let h = l ^ 0x811c9dc5;
+	let i = 0;
+	if (LE && !(d.byteOffset & 3)) {
+		for (
+			let w = new Int32Array(d.buffer, d.byteOffset, l >> 2),
+				n = w.length;
+			i < n;
+			i++
+		) {
+			h = Math.imul(h ^ w[i], 0x5bd1e995);
+			h ^= h >>> 15;
+		}
+		i <<= 2;
+	} else {
+		for (; i + 3 < l; i += 4) {
+			h = Math.imul(
+				h ^ (d[i] | d[i + 1] << 8 | d[i + 2] << 16 | d[i + 3] << 24),
+				0x5bd1e995,
+			);
+			h ^= h >>> 15;
+		}
+	}
+	for (; i < l; i++) {
+		h = Math.imul(h ^ d[i], 0x01000193);
+	}
+	return fin(h);
+}
+
+/**
+ * Hash values, optionally ignoring dictionary and set order.
+ * Equal values have equal hashes, unequal values usually do not.
+ *
+ * @param plist Plist object.
+ * @param c Hash cache.
+ * @param o Keep dictionary and set order.
+ * @param t Track hashes, for clearing on change.
+ * @returns Hash.
+ */
+export function hash(plist: PLType, c: Hashes, o = false, t = false): number {
+	let h = c.get(plist);
+	if (h !== undefined) {
+		return h;
+	}
+	walk(plist, {
+		default(v): boolean | void {
+			if (c.has(v)) {
+				return true;
+			}
+			const y = v[Symbol.toStringTag];
+			h = mix(0x811c9dc5, y);
+			switch (y) {
+				case PLTYPE_ARRAY:
+				case PLTYPE_DICTIONARY:
+				case PLTYPE_SET: {
+					return;
+				}
+				case PLTYPE_DATA: {
+					h = Math.imul(
+						h ^ digest(dataBytes(v as PLData)),
+						0x01000193,
+					);
+					break;
+				}
+				case PLTYPE_DATE: {
+					h = mix(h, `${(v as PLDate).time}`);
+					break;
+				}
+				case PLTYPE_INTEGER: {
+					h = mix(h, `${(v as PLInteger).bits}:${v.valueOf()}`);
+					break;
+				}
+				case PLTYPE_REAL: {
+					const x = (v as PLReal).value;
+					h = mix(
+						h,
+						`${(v as PLReal).bits}:${Object.is(x, -0) ? '-0' : x}`,
+					);
+					break;
+				}
+				default: {
+					h = mix(h, `${v.valueOf()}`);
+				}
+			}
+			c.set(v, fin(h));
+		},
+	}, {
+		default(v): void {
+			const y = v[Symbol.toStringTag];
+			let s = 0;
+			let x;
+			h = mix(0x811c9dc5, y);
+			switch (y) {
+				case PLTYPE_ARRAY: {
+					for (const e of arrays.get(v as PLArray)!) {
+						h = Math.imul(h ^ c.get(e)!, 0x01000193);
+						if (t) {
+							link(e, v);
+						}
+					}
+					break;
+				}
+				case PLTYPE_SET: {
+					for (const e of v as PLSet) {
+						x = c.get(e)!;
+						if (o) {
+							h = Math.imul(h ^ x, 0x01000193);
+						} else {
+							s = s + fin(x) | 0;
+						}
+						if (t) {
+							link(e, v);
+						}
+					}
+					break;
+				}
+				default: {
+					for (const [k, e] of v as PLDictionary) {
+						x = fin(Math.imul(c.get(k)!, 31) ^ c.get(e)!);
+						if (o) {
+							h = Math.imul(h ^ x, 0x01000193);
+						} else {
+							s = s + x | 0;
+						}
+						if (t) {
+							link(k, v);
+							link(e, v);
+						}
+					}
+				}
+			}
+			c.set(v, fin(h ^ s));
+		},
+	});
+	if (t && !parents.has(plist)) {
+		parents.set(plist, null);
+	}
+	return c.get(plist)!;
+}
+
+/**
+ * Match values to equal values, each one at most once.
+ *
+ * @param a Values to match.
+ * @param b Values to match against.
+ * @param c Hash cache.
+ * @param t Track hashes, for clearing on change.
+ * @returns Index of matched value in b for each value in a, or -1.
+ */
+export function pairs(
+	a: readonly PLType[],
+	b: readonly PLType[],
+	c: Hashes,
+	t = false,
+): number[] {
+	const m = new Map<number, number[]>();
+	const r: number[] = [];
+	let h;
+	let l;
+	for (let j = b.length; j--;) {
+		h = hash(b[j], c, false, t);
+		if ((l = m.get(h))) {
+			l.push(j);
+		} else {
+			m.set(h, [j]);
+		}
+	}
+	for (let n = a.length, i = 0, j, x; i < n; i++) {
+		r[i] = -1;
+		if ((l = m.get(hash(x = a[i], c, false, t)))) {
+			for (j = l.length; j--;) {
+				if (equal(x, b[l[j]], c, false, t)) {
+					r[i] = l[j];
+					l.splice(j, 1);
+					break;
+				}
+			}
+		}
+	}
+	return r;
+}
+
+/**
+ * Check if values are equal, optionally ignoring dictionary and set order.
+ *
+ * @param a Plist object.
+ * @param b Plist object.
+ * @param c Hash cache.
+ * @param o Keep dictionary and set order.
+ * @param t Track hashes, for clearing on change.
+ * @returns Is equal.
+ */
+export function equal(
+	a: PLType,
+	b: PLType,
+	c: Hashes,
+	o = false,
+	t = false,
+): boolean {
+	for (const s = [a, b]; s.length;) {
+		b = s.pop()!;
+		a = s.pop()!;
+		if (a === b) {
+			continue;
+		}
+		const y = a[Symbol.toStringTag];
+		if (
+			y !== b[Symbol.toStringTag] ||
+			hash(a, c, o, t) !== hash(b, c, o, t)
+		) {
+			return false;
+		}
+		switch (y) {
+			case PLTYPE_ARRAY: {
+				const x = arrays.get(a as PLArray)!;
+				const z = arrays.get(b as PLArray)!;
+				if (x.length !== z.length) {
+					return false;
+				}
+				for (let i = x.length; i--;) {
+					s.push(x[i], z[i]);
+				}
+				break;
+			}
+			case PLTYPE_DICTIONARY:
+			case PLTYPE_SET: {
+				if ((a as PLSet).size !== (b as PLSet).size) {
+					return false;
+				}
+				const x = [...(a as PLSet | PLDictionary).keys()];
+				const z = [...(b as PLSet | PLDictionary).keys()];
+				const m = o ? x.map((_, i) => i) : pairs(x, z, c, t);
+				for (let i = x.length; i--;) {
+					if (m[i] < 0) {
+						return false;
+					}
+					if (o) {
+						s.push(x[i], z[i]);
+					}
+					if (y === PLTYPE_DICTIONARY) {
+						s.push(
+							(a as PLDictionary).get(x[i])!,
+							(b as PLDictionary).get(z[m[i]])!,
+						);
+					}
+				}
+				break;
+			}
+			case PLTYPE_DATA: {
+				const x = dataBytes(a as PLData);
+				const y = dataBytes(b as PLData);
+				if (x.length !== y.length) {
+					return false;
+				}
+				for (let i = x.length; i--;) {
+					if (x[i] !== y[i]) {
+						return false;
+					}
+				}
+				break;
+			}
+			case PLTYPE_DATE: {
+				if (!Object.is((a as PLDate).time, (b as PLDate).time)) {
+					return false;
+				}
+				break;
+			}
+			case PLTYPE_INTEGER:
+			case PLTYPE_REAL: {
+				if (
+					(a as PLInteger | PLReal).bits !==
+						(b as PLInteger | PLReal).bits ||
+					!Object.is(a.valueOf(), b.valueOf())
+				) {
+					return false;
+				}
+				break;
+			}
+			default: {
+				if (a.valueOf() !== b.valueOf()) {
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
@@ -0,0 +1,164 @@
+/**
+ * @module
+ *
+ * Mutation utils.
+ */
+
+import type { PLType } from '../type.ts';
+import type { Hashes } from './hash.ts';
+
+/**
+ * Frozen plist objects.
+ */
+export const frozen = new WeakSet<object>();
+
+/**
+ * Parents of tracked plist objects, one or a set, null for none.
+ */
+export const parents = new WeakMap<object, object | Set<object> | null>();
+
+/**
+ * Tracked hashes, ignoring and keeping order, cleared on change.
+ */
+export const tracked: readonly [Hashes, Hashes] = [
+	new WeakMap(),
+	new WeakMap(),
+];
+
+/**
+ * Tracked dictionary entries by key value, cleared on change.
+ */
+export const indexes = new WeakMap<object, Map<unknown, [PLType, PLType]>>();
+
+/**
+ * Link tracked plist object to a parent.
+ *
+ * @param v Plist object.
+ * @param p Parent plist object, or watcher.
+ */
+export function link(v: object, p: object): void {
+	const x = parents.get(v);
+	if (!x) {
+		parents.set(v, p);
+	} else if (x !== p) {
+		if (x instanceof Set) {
+			x.add(p);
+		} else {
+			parents.set(v, new Set([x, p]));
+		}
+	}
+}
+
+/**
+ * Clear tracked hashes and indexes of changed plist object and its parents.
+ *
+ * @param v Plist object.
+ */
+function changed(v: object): void {
+	for (const s = [v]; s.length;) {
+		const p = parents.get(v = s.pop()!);
+		if (p !== undefined) {
+			parents.delete(v);
+			tracked[0].delete(v as PLType);
+			tracked[1].delete(v as PLType);
+			indexes.delete(v);
+			if (p instanceof Set) {
+				s.push(...p);
+			} else if (p) {
+				s.push(p);
+			}
+		}
+	}
+}
+
+/**
+ * Throw if plist object is frozen, else clear any tracked hashes and indexes.
+ *
+ * @param v Plist object.
+ */
+export function mutable(v: object): void {
+	if (frozen.has(v)) {
+		throw new TypeError('Cannot modify frozen plist');
+	}
+	if (parents.has(v)) {
+		changed(v);
+	}
+}
+
+/**
+ * Watch of plist objects, through a watcher linked as their parent,
+ * untracked when any of them change.
+ */
+export interface Watch {
+	/**
+	 * Watcher.
+	 */
+	w: object;
+
+	/**
+	 * Watched objects, untracked or with parents before watching.
+	 */
+	u: object[];
+
+	/**
+	 * Watched objects, tracked without a parent before watching.
+	 */
+	n: object[];
+}
+
+/**
+ * Watch plist object for changes.
+ *
+ * @param s Watch.
+ * @param v Plist object.
+ */
+export function watched(s: Watch, v: object): void {
+	const x = parents.get(v);
+	if (x !== s.w) {
+		(x === null ? s.n : s.u).push(v);
+		link(v, s.w);
+	}
+}
+
+/**
+ * Throw if any watched plist object changed.
+ *
+ * @param s Watch.
+ */
+export function unchanged(s: Watch): void {
+	if (!parents.has(s.w)) {
+		throw new TypeError('Plist changed while encoding');
+	}
+}
+
+/**
+ * Watch plist objects while running steps, unlinking the watcher after.
+ *
+ * @param start Start steps, with a watch.
+ * @yields Steps.
+ * @returns Result.
+ */
+export function* watching<T>(
+	start: (s: Watch) => Generator<number, T, void>,
+): Generator<number, T, void> {
+	const w = {};
+	parents.set(w, null);
+	const s: Watch = { w, u: [], n: [] };
+	try {
+		return yield* start(s);
+	} finally {
+		for (const v of s.n) {
+			if (parents.get(v) === w) {
+				parents.set(v, null);
+			}
+		}
+		for (const v of s.u) {
+			const x = parents.get(v);
+			if (x === w) {
+				parents.delete(v);
+			} else if (x instanceof Set) {
+				x.delete(w);
+			}
+		}
+	}
+}
@@ -0,0 +1,155 @@
+/**
+ * @module
+ *
+ * Query utils.
+ */
+
+import type { Query } from '../query.ts';
+import { PLTYPE_STRING, type PLString } from '../string.ts';
+import type { PLType } from '../type.ts';
+
+/**
+ * Maximum number of path segments, one state bit each plus the match bit.
+ */
+const MAX = 30;
+
+/**
+ * Compiled query.
+ */
+export interface Compiled {
+	/**
+	 * Segment types, 0 for name, 1 for any child, 2 for any descendants.
+	 */
+	t: number[];
+
+	/**
+	 * Segment names.
+	 */
+	s: string[];
+
+	/**
+	 * Segment array indexes, negative if not an index.
+	 */
+	x: number[];
+
+	/**
+	 * Match state bit, set when every segment is matched.
+	 */
+	e: number;
+
+	/**
+	 * Root state.
+	 */
+	r: number;
+}
+
+/**
+ * Compiled queries.
+ */
+export const compiled = new WeakMap<Query, Compiled>();
+
+/**
+ * Add the states reachable by matching zero descendants.
+ *
+ * @param q Compiled query.
+ * @param m State.
+ * @returns State.
+ */
+function close(q: Compiled, m: number): number {
+	for (let t = q.t, l = t.length, i = 0; i < l; i++) {
+		if (t[i] === 2 && m & 1 << i) {
+			m |= 1 << i + 1;
+		}
+	}
+	return m;
+}
+
+/**
+ * Compile query path.
+ *
+ * @param path Query path.
+ * @returns Compiled query.
+ */
+export function queryCompile(path: string): Compiled {
+	const t: number[] = [];
+	const s: string[] = [];
+	const x: number[] = [];
+	if (path) {
+		for (let l = path.length, i = 0, e = 0, n = '', c; i <= l;) {
+			if ((c = path[i++]) === '\\') {
+				if (i === l) {
+					throw new RangeError(`Invalid query escape: ${path}`);
+				}
+				n += path[i++];
+				e = 1;
+			} else if (c === '/' || c === undefined) {
+				if (t.length === MAX) {
+					throw new RangeError(`Invalid query length: ${path}`);
+				}
+				t.push(e ? 0 : n === '*' ? 1 : n === '**' ? 2 : 0);
+				s.push(n);
+				x.push(/^(0|[1-9]\d*)$/.test(n) ? +n : -1);
+				n = '';
+				e = 0;
+			} else {
+				n += c;
+			}
+		}
+	}
+	const q = { t, s, x, e: 1 << t.length, r: 1 };
+	q.r = close(q, 1);
+	return q;
+}
+
+/**
+ * Get state of child from state of parent.
+ *
+ * @param q Compiled query.
+ * @param m Parent state.
+ * @param key Child key, index, or null for set member.
+ * @returns Child state, zero if no match possible.
+ */
+export function queryStep(
+	q: Compiled,
+	m: number,
+	key: PLType | number | null,
+): number {
+	let r = 0;
+	for (let { t, s, x } = q, l = t.length, i = 0, b = 1; i < l; b = 1 << ++i) {
+		if (m & b) {
+			switch (t[i]) {
+				case 0: {
+					if (
+						typeof key === 'number'
+							? key === x[i]
+							: key?.[Symbol.toStringTag] === PLTYPE_STRING &&
+								(key as PLString).value === s[i]
+					) {
+						r |= b << 1;
+					}
+					break;
+				}
+				case 1: {
+					r |= b << 1;
+					break;
+				}
+				default: {
+					r |= b;
+				}
+			}
+		}
+	}
+	return r && close(q, r);
+}
+
+/**
+ * Get compiled query, compiling paths as needed.
+ *
+ * @param query Query or path.
+ * @returns Compiled query.
+ */
+export function queryCompiled(query: Query | string): Compiled {
+	return typeof query === 'string'
+		? queryCompile(query)
+		: compiled.get(query) ?? queryCompile(query.path);
+}
@@ -0,0 +1,13 @@
+/**
+ * @module
+ *
+ * Set utils.
+ */
+
+import type { PLSet } from '../set.ts';
+import type { PLType } from '../type.ts';
+
+/**
+ * Set values, shared for filling fresh sets directly.
+ */
+export const sets = new WeakMap<PLSet, Set<PLType>>();
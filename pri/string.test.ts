@@ -0,0 +1,56 @@
+import { assertEquals, assertStrictEquals } from '@std/assert';
+import { PLString } from '../string.ts';
+import { metas, stringMeta, stringSizes } from './string.ts';
+import { utf8Size } from './utf8.ts';
+
+Deno.test('stringMeta', () => {
+	const s = new PLString('test');
+	assertEquals(metas.has(s), false);
+	const m = stringMeta(s);
+	assertStrictEquals(stringMeta(s), m);
+	assertEquals(m.u, -1);
+	assertEquals(m.q, 0);
+});
+
+Deno.test('stringSizes', () => {
+	for (
+		const str of [
+			'',
+			'ascii',
+			'a & b',
+			'<tag>',
+			'&<>&<>',
+			'\x7F',
+			'\x80',
+			'café',
+			'€ & €',
+			'😀',
+			'\uD83D',
+			'\uDE00',
+			'\uDE00\uD83D',
+		]
+	) {
+		const tag = JSON.stringify(str);
+		const m = stringSizes(new PLString(str));
+		assertEquals(m.u, utf8Size(str), tag);
+		assertEquals(
+			m.u + m.x,
+			utf8Size(str.replace(/&/g, '&amp;').replace(/[<>]/g, '&gt;')),
+			tag,
+		);
+		assertEquals(m.a, !/[^\0-\x7F]/.test(str), tag);
+	}
+});
+
+Deno.test('invalidate on set', () => {
+	const s = new PLString('ascii');
+	let m = stringSizes(s);
+	assertEquals(m.a, true);
+	assertEquals(m.u, 5);
+	s.value = 'é&';
+	assertEquals(metas.has(s), false);
+	m = stringSizes(s);
+	assertEquals(m.a, false);
+	assertEquals(m.u, 3);
+	assertEquals(m.x, 4);
+});
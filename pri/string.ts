@@ -0,0 +1,113 @@
+/**
+ * @module
+ *
+ * String utils.
+ */
+
+import type { PLString } from '../string.ts';
+
+/**
+ * String metadata, computed lazily by encoders.
+ */
+export interface StringMeta {
+	/**
+	 * UTF-8 size, negative if not computed.
+	 */
+	u: number;
+
+	/**
+	 * Extra UTF-8 size of XML escapes.
+	 */
+	x: number;
+
+	/**
+	 * ASCII only flag.
+	 */
+	a: boolean;
+
+	/**
+	 * OpenStep quote character, zero if not computed.
+	 */
+	q: number;
+
+	/**
+	 * OpenStep encode size, without surrounding quotes.
+	 */
+	o: number;
+
+	/**
+	 * OpenStep requires quotes flag.
+	 */
+	n: boolean;
+}
+
+/**
+ * String metadata, deleted when the string value is set.
+ */
+export const metas = new WeakMap<PLString, StringMeta>();
+
+/**
+ * Get string metadata, creating it if necessary.
+ *
+ * @param s String.
+ * @returns String metadata.
+ */
+export function stringMeta(s: PLString): StringMeta {
+	let m = metas.get(s);
+	if (!m) {
+		metas.set(s, m = { u: -1, x: 0, a: true, q: 0, o: 0, n: false });
+	}
+	return m;
+}
+
+/**
+ * Get string metadata, computing the UTF-8 fields if necessary.
+ *
+ * @param s String.
+ * @returns String metadata.
+ */
+export function stringSizes(s: PLString): StringMeta {
+	const m = stringMeta(s);
+	if (m.u < 0) {
+		const str = s.value;
+		let len = 0;
+		let x = 0;
+		let a = 0;
+		for (let l = str.length, i = 0, hi = 0, chr; i < l;) {
+			if ((chr = str.charCodeAt(i++)) < 128) {
+				len++;
+				hi = 0;
+				if (chr === 38) {
+					x += 4;
+				} else if (chr === 60 || chr === 62) {
+					x += 3;
+				}
+				continue;
+			}
+			a = 1;
+			if (chr < 2048) {
+				len += 2;
+				hi = 0;
+			} else if (chr > 55295) {
+				if (chr < 57344) {
+					if (chr < 56320) {
+						hi = 4;
+					} else {
+						len += hi;
+						hi = 0;
+					}
+				} else {
+					len += 3;
+					hi = 0;
+				}
+			} else {
+				len += 3;
+				hi = 0;
+			}
+		}
+		m.u = len;
+		m.x = x;
+		m.a = !a;
+	}
+	return m;
+}
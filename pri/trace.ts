@@ -0,0 +1,159 @@
+/**
+ * @module
+ *
+ * Trace utils.
+ */
+
+import { PLTYPE_ARRAY } from '../array.ts';
+import { type PLData, PLTYPE_DATA } from '../data.ts';
+import { PLTYPE_DICTIONARY } from '../dictionary.ts';
+import type { Format } from '../format.ts';
+import { PLTYPE_SET } from '../set.ts';
+import { type PLString, PLTYPE_STRING } from '../string.ts';
+import type { Trace, TraceOptions } from '../trace.ts';
+import type { PLType } from '../type.ts';
+import { utf8Size } from './utf8.ts';
+import { walker } from './walk.ts';
+
+/**
+ * Trace plist, counting objects, shared references, depth, and bytes.
+ *
+ * @param plist Plist object.
+ * @returns Trace counts.
+ */
+function counts(
+	plist: PLType,
+): Pick<Trace, 'objects' | 'shared' | 'depth' | 'strings' | 'data'> {
+	const seen = new Set<PLType>();
+	const objects: Trace['objects'] = {
+		PLArray: 0,
+		PLBoolean: 0,
+		PLData: 0,
+		PLDate: 0,
+		PLDictionary: 0,
+		PLInteger: 0,
+		PLNull: 0,
+		PLReal: 0,
+		PLSet: 0,
+		PLString: 0,
+		PLUID: 0,
+	};
+	let shared = 0;
+	let depth = 0;
+	let strings = 0;
+	let data = 0;
+	walker(
+		plist,
+		{
+			default(v, d): boolean | void {
+				if (seen.has(v)) {
+					shared++;
+					return true;
+				}
+				seen.add(v);
+				objects[v[Symbol.toStringTag]]++;
+				switch (v[Symbol.toStringTag]) {
+					case PLTYPE_ARRAY:
+					case PLTYPE_DICTIONARY:
+					case PLTYPE_SET: {
+						depth = Math.max(depth, d + 1);
+						break;
+					}
+					case PLTYPE_STRING: {
+						strings += utf8Size((v as PLString).value);
+						break;
+					}
+					case PLTYPE_DATA: {
+						data += (v as PLData).byteLength;
+						break;
+					}
+				}
+			},
+		},
+		{},
+		{},
+		0,
+		0,
+	).next();
+	return { objects, shared, depth, strings, data };
+}
+
+/**
+ * Generator that reports a trace once done.
+ * Phase start times after the first are pushed by the generator.
+ * Phases without a start time are reported as taking no time.
+ *
+ * @template T Result type.
+ * @param trace Trace callback.
+ * @param phases Phase names.
+ * @param run Create generator, with phase times.
+ * @param done Format, plist, and encoded size, from the result.
+ * @yields Generator yields.
+ * @returns Generator result.
+ */
+function* traced<T>(
+	trace: (trace: Trace) => void,
+	phases: readonly string[],
+	run: (t: number[]) => Generator<number, T, void>,
+	done: (r: T) => [format: Format, plist: PLType, bytes: number],
+): Generator<number, T, void> {
+	const t = [performance.now()];
+	const r = yield* run(t);
+	t.push(performance.now());
+	const [format, plist, bytes] = done(r);
+	const p: Trace['phases'] = {};
+	for (let i = 0; i < phases.length; i++) {
+		p[phases[i]] = i + 1 < t.length ? t[i + 1] - t[i] : 0;
+	}
+	trace({ format, bytes, phases: p, ...counts(plist) });
+	return r;
+}
+
+/**
+ * Decoding generator, traced if there is a trace callback.
+ *
+ * @template T Result type.
+ * @param options Trace options.
+ * @param phases Phase names.
+ * @param encoded Encoded plist.
+ * @param run Create generator, with phase times or null to not trace.
+ * @returns Generator.
+ */
+export function traceDecode<T extends { format: Format; plist: PLType }>(
+	{ trace }: Readonly<TraceOptions>,
+	phases: readonly string[],
+	encoded: ArrayBufferView | ArrayBufferLike,
+	run: (t: number[] | null) => Generator<number, T, void>,
+): Generator<number, T, void> {
+	return trace
+		? traced(trace, phases, run, (r) => [
+			r.format,
+			r.plist,
+			encoded.byteLength,
+		])
+		: run(null);
+}
+
+/**
+ * Encoding generator, traced if there is a trace callback.
+ *
+ * @param options Trace options.
+ * @param phases Phase names.
+ * @param plist Plist object.
+ * @param format Encoded format.
+ * @param run Create generator, with phase times or null to not trace.
+ * @returns Generator.
+ */
+export function traceEncode(
+	{ trace }: Readonly<TraceOptions>,
+	phases: readonly string[],
+	plist: PLType,
+	format: Format,
+	run: (
+		t: number[] | null,
+	) => Generator<number, Uint8Array<ArrayBuffer>, void>,
+): Generator<number, Uint8Array<ArrayBuffer>, void> {
+	return trace
+		? traced(trace, phases, run, (r) => [format, plist, r.length])
+		: run(null);
+}
@@ -0,0 +1,27 @@
+import { utf8Decode, utf8Encode, utf8Length, utf8Size } from './utf8.ts';
+
+for (
+	const [name, str] of [
+		['ascii', 'ascii text '],
+		['unicode', 'unicode \u00e9\u4e16 \u{1f916} '],
+	].map(([name, s]) => [name, s.repeat(100000)])
+) {
+	const encoded = new TextEncoder().encode(str);
+	const dest = new Uint8Array(encoded.length);
+
+	Deno.bench(`utf8Size: ${name}`, { group: name }, () => {
+		utf8Size(str);
+	});
+
+	Deno.bench(`utf8Encode: ${name}`, { group: name }, () => {
+		utf8Encode(str, dest, 0);
+	});
+
+	Deno.bench(`utf8Length: ${name}`, { group: name }, () => {
+		utf8Length(encoded);
+	});
+
+	Deno.bench(`utf8Decode: ${name}`, { group: name }, () => {
+		utf8Decode(encoded);
+	});
+}
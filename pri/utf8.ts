@@ -439,3 +439,19 @@ export function utf8ErrorEnd(data: Uint8Array): string {
 export function utf8ErrorXML(data: Uint8Array, offset: number): string {
 	return `Invalid XML on line ${lineNumber(data, offset)}`;
 }
+
+/**
+ * Error message for exceeded budget.
+ *
+ * @param data Data.
+ * @param offset Offset.
+ * @param name Budget name.
+ * @returns Error message.
+ */
+export function utf8ErrorBudget(
+	data: Uint8Array,
+	offset: number,
+	name: string,
+): string {
+	return `Exceeded ${name} on line ${lineNumber(data, offset)}`;
+}
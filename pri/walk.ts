@@ -0,0 +1,194 @@
+/**
+ * @module
+ *
+ * Walk utils.
+ */
+
+import { type PLArray, PLTYPE_ARRAY } from '../array.ts';
+import { type PLDictionary, PLTYPE_DICTIONARY } from '../dictionary.ts';
+import { type PLSet, PLTYPE_SET } from '../set.ts';
+import type { PLType } from '../type.ts';
+import type {
+	WalkOptions,
+	WalkParent,
+	WalkVisit,
+	WalkVisitor,
+} from '../walk.ts';
+import { arrays } from './array.ts';
+import { unchanged, type Watch, watched } from './mutate.ts';
+
+const noop = () => {};
+
+/**
+ * Walk through a plist, yielding visit count every step visits.
+ *
+ * @param plist Plist object.
+ * @param visit Visit callbacks.
+ * @param leave Leave callbacks.
+ * @param options Walk options.
+ * @param step Visits between yields, 0 for none.
+ * @param o Initial visit count.
+ * @param s Watch of visited objects, to throw if changed between yields.
+ * @yields Visit count.
+ * @returns Visit count.
+ */
+export function* walker(
+	plist: PLType,
+	visit: Readonly<WalkVisit>,
+	leave: Readonly<WalkVisit>,
+	{ max = -1, min = 0, keysFirst = false }: Readonly<WalkOptions>,
+	step: number,
+	o: number,
+	s: Watch | null = null,
+): Generator<number, number, void> {
+	let y = step ? o + step : -1;
+	const vd = visit.default ?? noop;
+	const ld = leave.default ?? noop;
+
+	// Stack of parents, their keys, values or key iterators, and positions.
+	const ps: (PLArray | PLDictionary | PLSet)[] = [];
+	const ks: (PLType | number | null)[] = [];
+	const is: (PLType[] | Iterator<PLType> | null)[] = [];
+	const ns: number[] = [];
+
+	// Dictionary keys still waiting for their values to be visited.
+	const q: PLType[] = [];
+
+	let depth = 0;
+	let k: PLType | number | null = null;
+	let v: PLType | null | undefined = plist;
+	let p: WalkParent = null;
+	let c: PLArray | PLDictionary | PLSet;
+	let wv: WalkVisitor;
+	let t: string | null;
+	let d;
+	let i;
+	let n;
+	let r;
+	let x;
+	for (;;) {
+		if (v) {
+			if (++o === y) {
+				yield o;
+				y += step;
+				if (s) {
+					unchanged(s);
+				}
+			}
+			if (s) {
+				watched(s, v);
+			}
+			t = v[Symbol.toStringTag];
+			if (!(depth < min)) {
+				wv = (visit[t] ?? vd) as WalkVisitor;
+				r = wv(v, depth, k, p);
+				if (r === false) {
+					return o;
+				}
+				if (r === true) {
+					t = null;
+				}
+			}
+			switch (t) {
+				case PLTYPE_DICTIONARY:
+				case PLTYPE_ARRAY:
+				case PLTYPE_SET: {
+					ps[depth] = p = v as PLArray | PLDictionary | PLSet;
+					ks[depth] = k;
+					if (max < 0 || depth < max) {
+						is[depth] = t === PLTYPE_ARRAY
+							? arrays.get(v as PLArray)!
+							: t === PLTYPE_SET
+							? (v as PLSet).values()
+							: (v as PLDictionary).keys();
+						ns[depth] = 0;
+					} else {
+						is[depth] = null;
+						ns[depth] = -1;
+					}
+					depth++;
+				}
+			}
+		}
+		if (!depth) {
+			return o;
+		}
+		c = p!;
+		if ((n = ns[d = depth - 1]) >= 0) {
+			i = is[d];
+			switch (c[Symbol.toStringTag]) {
+				case PLTYPE_ARRAY: {
+					if (n < (i as PLType[]).length) {
+						v = (i as PLType[])[k = n];
+						ns[d] = n + 1;
+						continue;
+					}
+					break;
+				}
+				case PLTYPE_SET: {
+					if (!(r = (i as Iterator<PLType>).next()).done) {
+						k = v = r.value;
+						continue;
+					}
+					break;
+				}
+				default: {
+					if (keysFirst) {
+						// Queue all the keys, then reverse to pop in order.
+						if (i) {
+							if (!(r = (i as Iterator<PLType>).next()).done) {
+								q.push(v = r.value);
+								ns[d] = n + 1;
+								k = null;
+								continue;
+							}
+							is[d] = null;
+							for (let a = q.length - n, b = a + n - 1; a < b;) {
+								x = q[a];
+								q[a++] = q[b];
+								q[b--] = x;
+							}
+						}
+						for (
+							;
+							n && !(v = (c as PLDictionary).get(x = q.pop()!));
+							n--
+						);
+						if (n) {
+							ns[d] = n - 1;
+							k = x!;
+							continue;
+						}
+					} else {
+						// Value of the pending key, then the next key.
+						if (n) {
+							ns[d] = 0;
+							if ((v = (c as PLDictionary).get(x = q.pop()!))) {
+								k = x;
+								continue;
+							}
+						}
+						if (!(r = (i as Iterator<PLType>).next()).done) {
+							q.push(v = r.value);
+							ns[d] = 1;
+							k = null;
+							continue;
+						}
+					}
+				}
+			}
+		}
+
+		// Leave parent once out of children.
+		v = null;
+		is[d] = null;
+		k = ks[d];
+		p = (depth = d) ? ps[d - 1] : null;
+		if (!(depth < min)) {
+			wv = (leave[c[Symbol.toStringTag]] ?? ld) as WalkVisitor;
+			if (wv(c, depth, k, p) === false) {
+				return o;
+			}
+		}
+	}
+}
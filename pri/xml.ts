@@ -0,0 +1,162 @@
+/**
+ * @module
+ *
+ * XML utils.
+ */
+
+import { FORMAT_XML_V0_9, FORMAT_XML_V1_0 } from '../format.ts';
+import { b64e } from './base.ts';
+
+const rDateY4 = /^(-)0*(\d{3}-)|\+?0*(\d{4,}-)/;
+const rRealTrim = /\.?0+$/;
+const rEnt = /[&<>]/g;
+const ents = { '&': '&amp;', '<': '&lt;', '>': '&gt;' } as const;
+const ent = (s: string) => ents[s as keyof typeof ents];
+
+/**
+ * Get XML declaration, doctype, and plist open tag, each on a line.
+ *
+ * @param format XML format.
+ * @returns Head.
+ */
+export function head(format: string): string {
+	let doctype;
+	let version;
+	switch (format) {
+		case FORMAT_XML_V1_0: {
+			doctype =
+				'<!DOCTYPE plist PUBLIC "-//Apple//DTD PLIST 1.0//EN" "http://www.apple.com/DTDs/PropertyList-1.0.dtd">';
+			version = '1.0';
+			break;
+		}
+		case FORMAT_XML_V0_9: {
+			doctype =
+				'<!DOCTYPE plist SYSTEM "file://localhost/System/Library/DTDs/PropertyList.dtd">';
+			version = '0.9';
+			break;
+		}
+		default: {
+			throw new RangeError('Invalid format');
+		}
+	}
+	return `<?xml version="1.0" encoding="UTF-8"?>\n${doctype}\n` +
+		`<plist version="${version}">\n`;
+}
+
+/**
+ * Escape string for XML text.
+ *
+ * @param s String.
+ * @returns Escaped string.
+ */
+export function escape(s: string): string {
+	return s.replace(rEnt, ent);
+}
+
+/**
+ * Encode integer to string.
+ *
+ * @param i Integer value.
+ * @param mz Encode smallest 128-bit integer as -0.
+ * @returns Integer string.
+ */
+export function integer(i: number | bigint, mz: boolean): string {
+	// Format issue encodes smallest 128-bit as negative zero.
+	return mz && i === -0x80000000000000000000000000000000n
+		? '-0'
+		: i.toString();
+}
+
+/**
+ * Encode real to string.
+ *
+ * @param real Real value.
+ * @param uz Unsign zero.
+ * @returns Real string.
+ */
+export function real(real: number, uz: boolean): string {
+	// No trailing zeros except on 0.
+	switch (real) {
+		case 0:
+			return uz || 1 / real === Infinity ? '0.0' : '-0.0';
+		case Infinity:
+			return '+infinity';
+		case -Infinity:
+			return '-infinity';
+	}
+	// deno-lint-ignore no-self-compare
+	return real === real ? real.toPrecision(17).replace(rRealTrim, '') : 'nan';
+}
+
+/**
+ * Convert date to string.
+ *
+ * @param date Date.
+ * @returns Date string.
+ */
+export function date(date: { toISOString: () => string }): string {
+	// No decimal seconds, 4+ characters for year, no leading plus.
+	return `${date.toISOString().slice(0, -5).replace(rDateY4, '$1$2$3')}Z`;
+}
+
+/**
+ * Get size of data base64 lines, with tags, indented to depth.
+ *
+ * @param l Data length.
+ * @param inl Indent length.
+ * @param d Depth.
+ * @returns Size, without the newline after the close tag.
+ */
+export function dataSize(l: number, inl: number, d: number): number {
+	const x = ((l - (l % 3 || 3)) / 3 + 1) * 4;
+	return 13 + x + (d * inl + 1) * ((x - (x % 76 || 76)) / 76 + 2);
+}
+
+/**
+ * Write data as base64 lines of 76 characters, indented to depth.
+ *
+ * @param u Data.
+ * @param r Output.
+ * @param i Output offset.
+ * @param ind Indent.
+ * @param d Depth.
+ * @returns Output offset.
+ */
+export function dataLines(
+	u: Uint8Array,
+	r: Uint8Array,
+	i: number,
+	ind: Uint8Array,
+	d: number,
+): number {
+	const inl = ind.length;
+	for (let l = u.length, l3 = l - (l % 3), b = 0, c, e, x; b < l;) {
+		for (x = d; x--; i += inl) {
+			r.set(ind, i);
+		}
+		for (x = 20; b < l3 && --x;) {
+			e = u[b++];
+			r[i++] = b64e[c = e >> 2] + c - 19;
+			e = e << 8 | u[b++];
+			r[i++] = b64e[c = e >> 4 & 63] + c - 19;
+			e = e << 8 | u[b++];
+			r[i++] = b64e[c = e >> 6 & 63] + c - 19;
+			r[i++] = b64e[c = e & 63] + c - 19;
+		}
+		if (x > 1 && b < l) {
+			e = u[b++];
+			r[i++] = b64e[c = e >> 2] + c - 19;
+			if (b < l) {
+				e = e << 8 | u[b++];
+				r[i++] = b64e[c = e >> 4 & 63] + c - 19;
+				r[i++] = b64e[c = e << 2 & 63] + c - 19;
+			} else {
+				r[i++] = b64e[c = e << 4 & 63] + c - 19;
+				r[i++] = 61;
+			}
+			r[i++] = 61;
+		}
+		r[i++] = 10;
+	}
+	return i;
+}
@@ -0,0 +1,82 @@
+import { assertEquals, assertStrictEquals, assertThrows } from '@std/assert';
+import { PLArray } from './array.ts';
+import { PLDictionary } from './dictionary.ts';
+import { PLInteger } from './integer.ts';
+import { compileQuery, query } from './query.ts';
+import { PLSet } from './set.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+
+const str = (s: string) => new PLString(s);
+const values = (list: PLType[]) => list.map((v) => `${v}`);
+
+const plist = new PLDictionary<PLType, PLType>([
+	[
+		str('Objects'),
+		new PLArray([
+			new PLDictionary([[str('Name'), str('A')]]),
+			new PLDictionary<PLType, PLType>([
+				[str('Name'), str('B')],
+				[str('Child'), new PLDictionary([[str('Name'), str('C')]])],
+			]),
+			new PLSet([str('Name'), new PLInteger(1)]),
+		]),
+	],
+	[str('*'), str('star')],
+	[str('a/b'), str('slash')],
+	[str('1'), str('one')],
+	[new PLInteger(1), str('int')],
+]);
+
+Deno.test('query: names', () => {
+	assertEquals(values(query(plist, 'Objects/*/Name')), ['A', 'B']);
+	assertEquals(values(query(plist, 'Objects/1/Name')), ['B']);
+	assertEquals(values(query(plist, 'Objects/1/Child/Name')), ['C']);
+	assertEquals(values(query(plist, 'Objects/3/Name')), []);
+	assertEquals(values(query(plist, 'Missing/*')), []);
+	assertEquals(values(query(plist, '1')), ['one']);
+});
+
+Deno.test('query: root', () => {
+	const r = query(plist, '');
+	assertEquals(r.length, 1);
+	assertStrictEquals(r[0], plist);
+	assertEquals(query(str('value'), '*'), []);
+});
+
+Deno.test('query: descendants', () => {
+	assertEquals(values(query(plist, '**/Name')), ['A', 'B', 'C']);
+	assertEquals(values(query(plist, 'Objects/**/Name')), ['A', 'B', 'C']);
+	assertEquals(values(query(plist, 'Objects/*/**/Name')), ['A', 'B', 'C']);
+	assertEquals(values(query(plist, 'Objects/*/*/**/Name')), ['C']);
+	assertEquals(values(query(plist, 'Objects/2/*')), ['Name', '1']);
+	assertEquals(query(plist, '**').length, 15);
+});
+
+Deno.test('query: escapes', () => {
+	assertEquals(values(query(plist, '\\*')), ['star']);
+	assertEquals(values(query(plist, 'a\\/b')), ['slash']);
+	assertEquals(values(query(plist, 'Obj\\ects/0/Name')), ['A']);
+	assertThrows(
+		() => query(plist, 'Objects\\'),
+		RangeError,
+		'Invalid query escape: Objects\\',
+	);
+});
+
+Deno.test('query: length', () => {
+	const path = new Array(30).fill('*').join('/');
+	assertEquals(query(plist, path), []);
+	assertThrows(
+		() => compileQuery(`${path}/*`),
+		RangeError,
+		'Invalid query length',
+	);
+});
+
+Deno.test('compileQuery', () => {
+	const q = compileQuery('Objects/*/Name');
+	assertEquals(q.path, 'Objects/*/Name');
+	assertEquals(values(query(plist, q)), ['A', 'B']);
+	assertEquals(values(query(plist, { path: 'Objects/0/Name' })), ['A']);
+});
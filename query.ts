@@ -0,0 +1,86 @@
+/**
+ * @module
+ *
+ * Property list path queries.
+ */
+
+import { PLTYPE_DICTIONARY } from './dictionary.ts';
+import {
+	compiled,
+	queryCompile,
+	queryCompiled,
+	queryStep,
+} from './pri/query.ts';
+import { PLTYPE_SET } from './set.ts';
+import type { PLType } from './type.ts';
+import { walk } from './walk.ts';
+
+/**
+ * Compiled path query.
+ */
+export interface Query {
+	/**
+	 * Query path.
+	 */
+	readonly path: string;
+}
+
+/**
+ * Compile a path query for reuse.
+ *
+ * Paths are segments separated by `/`, each one matching a child:
+ * - `*` matches any child of an array, dictionary, or set.
+ * - `**` matches any number of descendants, including none.
+ * - Anything else matches a dictionary string key, or an array index.
+ * - A `\` escapes the next character, for keys like `*` or `a/b`.
+ *
+ * An empty path matches the root.
+ *
+ * @param path Query path.
+ * @returns Compiled query.
+ */
+export function compileQuery(path: string): Query {
+	const query = Object.freeze({ path });
+	compiled.set(query, queryCompile(path));
+	return query;
+}
+
+/**
+ * Find values matching a path query, in walk order.
+ * Subtrees that cannot match are skipped.
+ *
+ * @param plist Plist object.
+ * @param path Query or path.
+ * @returns Matched values.
+ */
+export function query(plist: PLType, path: Query | string): PLType[] {
+	const q = queryCompiled(path);
+	const { e } = q;
+	const r: PLType[] = [];
+	const ms: number[] = [];
+	walk(plist, {
+		default(v, d, k, p): boolean | void {
+			let m;
+			if (p) {
+				if (k === null && p[Symbol.toStringTag] === PLTYPE_DICTIONARY) {
+					return true;
+				}
+				m = queryStep(
+					q,
+					ms[d - 1],
+					p[Symbol.toStringTag] === PLTYPE_SET ? null : k,
+				);
+			} else {
+				m = q.r;
+			}
+			if (m & e) {
+				r.push(v);
+			}
+			if (!(m & e - 1)) {
+				return true;
+			}
+			ms[d] = m;
+		},
+	});
+	return r;
+}
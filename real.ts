@@ -4,6 +4,7 @@
  * Property list real.
  */
 
+import { mutable } from './pri/mutate.ts';
 import type { PLType } from './type.ts';
 
 /**
@@ -70,6 +71,7 @@ export class PLReal {
 	 * @param value Real value.
 	 */
 	public set value(value: number) {
+		mutable(this);
 		value = +value;
 		values.set(this, bitses.get(this) === 32 ? Math.fround(value) : value);
 	}
@@ -89,6 +91,7 @@ export class PLReal {
 	 * @param bits Real bits.
 	 */
 	public set bits(bits: PLRealBits) {
+		mutable(this);
 		switch ((+bits || 0) - (bits % 1 || 0)) {
 			case 32: {
 				values.set(this, Math.fround(values.get(this)!));
@@ -0,0 +1,144 @@
+import { assert, assertEquals, assertGreater } from '@std/assert';
+import { PLArray } from './array.ts';
+import { PLBoolean } from './boolean.ts';
+import { PLData } from './data.ts';
+import { PLDate } from './date.ts';
+import { decodeXml } from './decode/xml.ts';
+import { PLDictionary } from './dictionary.ts';
+import { encodeXml } from './encode/xml.ts';
+import { freeze } from './freeze.ts';
+import { PLInteger } from './integer.ts';
+import { PLNull } from './null.ts';
+import { PLReal } from './real.ts';
+import { retainedSize, retainedSizes } from './retained.ts';
+import { PLSet } from './set.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+import { PLUID } from './uid.ts';
+
+const tree = (i: number): PLType =>
+	new PLDictionary<PLType, PLType>([
+		[
+			new PLString(`integers ${i}`),
+			new PLArray([
+				new PLInteger(i),
+				new PLInteger(0x10000000000n + BigInt(i)),
+				new PLInteger(-1n << 100n, 128),
+			]),
+		],
+		[new PLString(`real ${i}`), new PLReal(i + 0.5)],
+		[new PLString(`date ${i}`), new PLDate(i + 0.25)],
+		[new PLString(`data ${i}`), new PLData(new ArrayBuffer(100))],
+		[
+			new PLString(`set ${i}`),
+			new PLSet([new PLString(`a ${i}`), new PLString(`b ${i}`)]),
+		],
+		[new PLString(`uid ${i}`), new PLUID(BigInt(i))],
+		[new PLString(`bool ${i}`), new PLBoolean(true)],
+		[new PLString(`null ${i}`), new PLNull()],
+		[new PLString(`text ${i}`), new PLString(`caf\u00e9 \u4e16 ${i}`)],
+	]);
+
+Deno.test('retainedSize: shared once', () => {
+	const s = new PLString('shared string');
+	const one = retainedSize(new PLArray([s]));
+	assertEquals(retainedSize(new PLArray([s, s])), one + 8);
+	const b = new ArrayBuffer(1000);
+	const d = retainedSize(new PLData(b));
+	const a = retainedSize(new PLArray([new PLData(b), new PLData(b)]));
+	assertEquals(a, retainedSize(new PLArray([new PLData(b)])) + d - 1080);
+	assertEquals(retainedSize(new PLData(b), [b]), d - 1088);
+});
+
+Deno.test('retainedSize: types', () => {
+	assertEquals(retainedSize(new PLNull()), 24);
+	assertEquals(retainedSize(new PLBoolean()), 56);
+	assertEquals(retainedSize(new PLInteger(1)), 88);
+	assertEquals(retainedSize(new PLInteger(0x100000000)), 104);
+	assertEquals(retainedSize(new PLInteger(-1n << 100n, 128)), 120);
+	assertEquals(retainedSize(new PLReal(1)), 88);
+	assertEquals(retainedSize(new PLReal(1.5)), 104);
+	assertEquals(retainedSize(new PLReal(-0)), 104);
+	assertEquals(retainedSize(new PLString('')), 56);
+	assertEquals(retainedSize(new PLString('abcdefgh')), 80);
+	assertEquals(retainedSize(new PLString('abcdefghi')), 88);
+	assertEquals(retainedSize(new PLString('\u4e16\u754c')), 80);
+	assertEquals(retainedSize(new PLArray()), 88);
+	assertEquals(retainedSize(new PLDictionary()), 240);
+	assertEquals(retainedSize(new PLSet()), 288);
+	assertEquals(retainedSize(new PLData(new ArrayBuffer(10))), 218);
+	assertGreater(retainedSize(freeze(new PLNull())), 24);
+});
+
+Deno.test('retainedSize: lazy data', () => {
+	const encoded = encodeXml(
+		new PLArray([
+			new PLData(new Uint8Array(100).buffer),
+			new PLData(new Uint8Array(100).buffer),
+		]),
+	);
+	const { plist } = decodeXml(encoded, { lazy: true });
+	const lazy = retainedSize(plist);
+	assertGreater(lazy, encoded.length);
+	for (const d of plist as PLArray<PLData>) {
+		assertEquals(d.buffer.byteLength, 100);
+	}
+	assert(retainedSize(plist) < lazy);
+});
+
+Deno.test('retainedSizes', () => {
+	const shared = new PLString('shared string');
+	const a = new PLArray([shared, new PLString('a string')]);
+	const b = new PLArray([shared]);
+	const plist = new PLArray([a, b]);
+	const sizes = retainedSizes(plist);
+	assertEquals(sizes.get(plist), retainedSize(plist));
+	assertEquals(
+		sizes.get(a),
+		retainedSize(new PLArray()) + 32 + sizes.get(shared)! +
+			retainedSize(new PLString('a string')),
+	);
+	assertEquals(sizes.get(b), retainedSize(new PLArray()) + 24);
+	assertEquals(
+		sizes.get(plist),
+		retainedSize(new PLArray()) + 32 + sizes.get(a)! + sizes.get(b)!,
+	);
+});
+
+Deno.test('retainedSize: heap', () => {
+	// A process of its own, so tests before cannot have grown the tables.
+	const { success, stdout } = new Deno.Command(Deno.execPath(), {
+		args: [
+			'run',
+			'--v8-flags=--expose-gc',
+			import.meta.filename!,
+			'--heap',
+		],
+		stdin: 'null',
+		stderr: 'inherit',
+	}).outputSync();
+	assert(success);
+	const ratio = +new TextDecoder().decode(stdout);
+	assert(ratio > 0.75 && ratio < 1.25, `${ratio}`);
+});
+
+if (Deno.args[0] === '--heap') {
+	const gc = (globalThis as { gc: () => void }).gc;
+	const n = 10000;
+	const keep: PLType[] = new Array(n).fill(null);
+	gc();
+	const before = Deno.memoryUsage();
+	for (let i = 0; i < n; i++) {
+		keep[i] = tree(i);
+	}
+	gc();
+	const after = Deno.memoryUsage();
+	const measured = after.heapUsed - before.heapUsed +
+		after.external - before.external;
+	let estimated = 0;
+	for (const plist of keep) {
+		estimated += retainedSize(plist);
+	}
+	// deno-lint-ignore no-console
+	console.log(estimated / measured);
+}
@@ -0,0 +1,180 @@
+import { assertEquals, assertThrows } from '@std/assert';
+import { PLArray } from './array.ts';
+import { PLBoolean } from './boolean.ts';
+import { PLData } from './data.ts';
+import { PLDate } from './date.ts';
+import { decode } from './decode/mod.ts';
+import { PLDictionary } from './dictionary.ts';
+import { PLInteger } from './integer.ts';
+import { PLNull } from './null.ts';
+import { PLReal } from './real.ts';
+import { compileSchema, extract, type Schema } from './schema.ts';
+import { PLSet } from './set.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+import { PLUID } from './uid.ts';
+
+const str = (s: string) => new PLString(s);
+
+Deno.test('extract: info', () => {
+	const { plist } = decode(
+		new TextEncoder().encode(`{
+			CFBundleIdentifier = com.example;
+			CFBundleVersion = 1;
+			LSRequiresIPhoneOS = <>;
+			CFBundleURLTypes = (
+				{ CFBundleURLSchemes = (a, b); },
+				{ CFBundleURLSchemes = (); CFBundleURLName = c; }
+			);
+			Other = { Deep = (1, 2, 3); };
+			Env = { A = 1; B = 2; };
+		}`),
+	);
+	const info = compileSchema({
+		type: 'dictionary',
+		required: {
+			CFBundleIdentifier: 'string',
+			CFBundleURLTypes: {
+				type: 'array',
+				items: {
+					type: 'dictionary',
+					required: {
+						CFBundleURLSchemes: { type: 'array', items: 'string' },
+					},
+					optional: { CFBundleURLName: 'string' },
+				},
+			},
+			Env: { type: 'dictionary', values: 'string' },
+		},
+		optional: {
+			CFBundleVersion: 'string',
+			CFBundleName: 'string',
+		},
+	});
+	const r = info(plist);
+	assertEquals(r, {
+		CFBundleIdentifier: 'com.example',
+		CFBundleVersion: '1',
+		CFBundleURLTypes: [
+			{ CFBundleURLSchemes: ['a', 'b'] },
+			{ CFBundleURLSchemes: [], CFBundleURLName: 'c' },
+		],
+		Env: { A: '1', B: '2' },
+	});
+	const id: string = r.CFBundleIdentifier;
+	const name: string | undefined = r.CFBundleName;
+	const env: string = r.Env.A;
+	assertEquals([id, name, env], ['com.example', undefined, '1']);
+});
+
+Deno.test('extract: types', () => {
+	const data = new Uint8Array([1, 2]);
+	const any = new PLArray();
+	const plist = new PLArray<PLType>([
+		new PLBoolean(true),
+		new PLData(data.buffer),
+		new PLDate(0),
+		new PLInteger(1),
+		new PLNull(),
+		new PLReal(1.5),
+		str('a'),
+		new PLUID(2n),
+		any,
+		new PLSet([str('b')]),
+	]);
+	const schemas: Schema[] = [
+		'boolean',
+		'data',
+		'date',
+		'integer',
+		'null',
+		'real',
+		'string',
+		'uid',
+		'any',
+		{ type: 'set', items: 'string' },
+	];
+	const values = [
+		true,
+		data,
+		new Date(Date.UTC(2001, 0, 1)),
+		1n,
+		null,
+		1.5,
+		'a',
+		2n,
+		any,
+		['b'],
+	];
+	for (let i = 0; i < schemas.length; i++) {
+		const v = plist.get(i)!;
+		assertEquals(extract(v, schemas[i]), values[i], `${i}`);
+		for (let j = 0; j < schemas.length; j++) {
+			if (j !== i && schemas[j] !== 'any') {
+				assertThrows(
+					() => extract(v, schemas[j]),
+					TypeError,
+					'Expected',
+				);
+			}
+		}
+	}
+});
+
+Deno.test('extract: errors', () => {
+	const plist = new PLDictionary<PLType, PLType>([
+		[str('a/b'), new PLArray([str('x'), new PLInteger(1)])],
+		[str('*'), new PLDictionary()],
+	]);
+	assertThrows(
+		() =>
+			extract(plist, {
+				type: 'dictionary',
+				required: { 'a/b': { type: 'array', items: 'string' } },
+			}),
+		TypeError,
+		'Expected string: a\\/b/1',
+	);
+	assertThrows(
+		() =>
+			extract(plist, {
+				type: 'dictionary',
+				required: {
+					'*': { type: 'dictionary', required: { c: 'string' } },
+				},
+			}),
+		TypeError,
+		'Missing key: \\*/c',
+	);
+	assertThrows(
+		() => extract(plist, { type: 'array', items: 'any' }),
+		TypeError,
+		'Expected array: ',
+	);
+	assertThrows(
+		() => extract(plist, 'text' as Schema),
+		RangeError,
+		'Invalid schema: text',
+	);
+	assertThrows(
+		() => extract(plist, { type: 'list' } as unknown as Schema),
+		RangeError,
+		'Invalid schema: list',
+	);
+});
+
+Deno.test('extract: skipped', () => {
+	const plist = new PLDictionary<PLType, PLType>([
+		[str('a'), str('1')],
+		[str('b'), new PLInteger(2)],
+		[new PLInteger(3), str('3')],
+		[str('__proto__'), str('p')],
+	]);
+	assertEquals(
+		extract(plist, { type: 'dictionary', optional: { a: 'string' } }),
+		{ a: '1' },
+	);
+	const r = extract(plist, { type: 'dictionary', values: 'any' });
+	assertEquals(Object.keys(r), ['a', 'b', '__proto__']);
+	assertEquals(Object.getPrototypeOf(r), Object.prototype);
+});
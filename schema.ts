@@ -0,0 +1,380 @@
+/**
+ * @module
+ *
+ * Property list schema extraction.
+ */
+
+import { type PLArray, PLTYPE_ARRAY } from './array.ts';
+import { type PLBoolean, PLTYPE_BOOLEAN } from './boolean.ts';
+import { type PLData, PLTYPE_DATA } from './data.ts';
+import { type PLDate, PLTYPE_DATE } from './date.ts';
+import { type PLDictionary, PLTYPE_DICTIONARY } from './dictionary.ts';
+import { type PLInteger, PLTYPE_INTEGER } from './integer.ts';
+import { PLTYPE_NULL } from './null.ts';
+import { arrays } from './pri/array.ts';
+import { bytes } from './pri/data.ts';
+import { type PLReal, PLTYPE_REAL } from './real.ts';
+import { type PLSet, PLTYPE_SET } from './set.ts';
+import { type PLString, PLTYPE_STRING } from './string.ts';
+import type { PLType } from './type.ts';
+import { PLTYPE_UID, type PLUID } from './uid.ts';
+
+/**
+ * Schema primitive types, and the extracted types.
+ */
+export interface SchemaPrimitives {
+	/**
+	 * Any plist value, unchanged.
+	 */
+	any: PLType;
+
+	/**
+	 * PLBoolean value.
+	 */
+	boolean: boolean;
+
+	/**
+	 * PLData bytes, not copied.
+	 */
+	data: Uint8Array;
+
+	/**
+	 * PLDate as date.
+	 */
+	date: Date;
+
+	/**
+	 * PLInteger value.
+	 */
+	integer: bigint;
+
+	/**
+	 * PLNull as null.
+	 */
+	null: null;
+
+	/**
+	 * PLReal value.
+	 */
+	real: number;
+
+	/**
+	 * PLString value.
+	 */
+	string: string;
+
+	/**
+	 * PLUID value.
+	 */
+	uid: bigint;
+}
+
+/**
+ * Schema primitive type.
+ */
+export type SchemaPrimitive = keyof SchemaPrimitives;
+
+/**
+ * Schema for PLArray or PLSet, extracted as array.
+ */
+export interface SchemaArray {
+	/**
+	 * Collection type.
+	 */
+	readonly type: 'array' | 'set';
+
+	/**
+	 * Schema for each item.
+	 */
+	readonly items: Schema;
+}
+
+/**
+ * Schema for PLDictionary with string keys, extracted as object.
+ * Keys not in the schema are skipped, unless values has a schema.
+ */
+export interface SchemaDictionary {
+	/**
+	 * Dictionary type.
+	 */
+	readonly type: 'dictionary';
+
+	/**
+	 * Schemas for required keys.
+	 */
+	readonly required?: { readonly [key: string]: Schema };
+
+	/**
+	 * Schemas for optional keys.
+	 */
+	readonly optional?: { readonly [key: string]: Schema };
+
+	/**
+	 * Schema for other keys.
+	 */
+	readonly values?: Schema;
+}
+
+/**
+ * Extraction schema.
+ */
+export type Schema = SchemaPrimitive | SchemaArray | SchemaDictionary;
+
+/**
+ * Extracted type for a schema.
+ *
+ * @template S Schema type.
+ */
+export type SchemaOutput<S> = S extends SchemaPrimitive ? SchemaPrimitives[S]
+	: S extends SchemaArray ? SchemaOutput<S['items']>[]
+	: S extends SchemaDictionary ?
+			& (S extends { readonly required: infer R } ? {
+					-readonly [K in keyof R]: SchemaOutput<R[K]>;
+				}
+				: unknown)
+			& (S extends { readonly optional: infer O } ? {
+					-readonly [K in keyof O]?: SchemaOutput<O[K]>;
+				}
+				: unknown)
+			& (S extends { readonly values: infer V } ? {
+					[key: string]: SchemaOutput<V>;
+				}
+				: unknown)
+	: never;
+
+/**
+ * Compiled schema extractor.
+ *
+ * @template S Schema type.
+ * @param plist Plist object.
+ * @returns Extracted value.
+ */
+export type SchemaExtractor<S extends Schema> = (
+	plist: PLType,
+) => SchemaOutput<S>;
+
+/**
+ * Compiled extractor, with path stack for errors.
+ */
+type Extract = (v: PLType, p: (string | number)[]) => unknown;
+
+/**
+ * Compiled extractors by schema.
+ */
+const compiled = new WeakMap<object, Extract>();
+
+/**
+ * Format path as a query path.
+ *
+ * @param p Path stack.
+ * @returns Query path.
+ */
+function path(p: (string | number)[]): string {
+	return p.map((s) =>
+		typeof s === 'number'
+			? s
+			: /^\**$/.test(s)
+			? `\\${s}`
+			: s.replace(/[\\/]/g, '\\$&')
+	).join('/');
+}
+
+/**
+ * Throw type error.
+ *
+ * @param type Expected type.
+ * @param p Path stack.
+ */
+function expected(type: string, p: (string | number)[]): never {
+	throw new TypeError(`Expected ${type}: ${path(p)}`);
+}
+
+/**
+ * Set own property, even if __proto__.
+ *
+ * @param o Object.
+ * @param k Key.
+ * @param v Value.
+ */
+function set(o: Record<string, unknown>, k: string, v: unknown): void {
+	if (k === '__proto__') {
+		Object.defineProperty(o, k, {
+			value: v,
+			configurable: true,
+			enumerable: true,
+			writable: true,
+		});
+	} else {
+		o[k] = v;
+	}
+}
+
+/**
+ * Primitive extractors.
+ */
+const primitives: { [S in SchemaPrimitive]: Extract } = {
+	any: (v) => v,
+	boolean: (v, p) =>
+		v[Symbol.toStringTag] === PLTYPE_BOOLEAN
+			? (v as PLBoolean).value
+			: expected('boolean', p),
+	data: (v, p) =>
+		v[Symbol.toStringTag] === PLTYPE_DATA
+			? bytes(v as PLData)
+			: expected('data', p),
+	date: (v, p) =>
+		v[Symbol.toStringTag] === PLTYPE_DATE
+			? (v as PLDate).toDate()
+			: expected('date', p),
+	integer: (v, p) =>
+		v[Symbol.toStringTag] === PLTYPE_INTEGER
+			? (v as PLInteger).value
+			: expected('integer', p),
+	null: (v, p) =>
+		v[Symbol.toStringTag] === PLTYPE_NULL ? null : expected('null', p),
+	real: (v, p) =>
+		v[Symbol.toStringTag] === PLTYPE_REAL
+			? (v as PLReal).value
+			: expected('real', p),
+	string: (v, p) =>
+		v[Symbol.toStringTag] === PLTYPE_STRING
+			? (v as PLString).value
+			: expected('string', p),
+	uid: (v, p) =>
+		v[Symbol.toStringTag] === PLTYPE_UID
+			? (v as PLUID).value
+			: expected('uid', p),
+};
+
+/**
+ * Compile schema, reusing compiled extractors.
+ *
+ * @param schema Schema.
+ * @returns Compiled extractor.
+ */
+function compile(schema: Schema): Extract {
+	if (typeof schema === 'string') {
+		if (Object.hasOwn(primitives, schema)) {
+			return primitives[schema];
+		}
+		throw new RangeError(`Invalid schema: ${schema}`);
+	}
+	let e = compiled.get(schema);
+	if (e) {
+		return e;
+	}
+	switch (schema.type) {
+		case 'array': {
+			const x = compile(schema.items);
+			e = (v, p) => {
+				if (v[Symbol.toStringTag] !== PLTYPE_ARRAY) {
+					expected('array', p);
+				}
+				const a = arrays.get(v as PLArray)!;
+				const l = a.length;
+				const r = new Array(l);
+				for (let i = 0; i < l; i++) {
+					p.push(i);
+					r[i] = x(a[i], p);
+					p.pop();
+				}
+				return r;
+			};
+			break;
+		}
+		case 'set': {
+			const x = compile(schema.items);
+			e = (v, p) => {
+				if (v[Symbol.toStringTag] !== PLTYPE_SET) {
+					expected('set', p);
+				}
+				const r: unknown[] = [];
+				let i = 0;
+				for (const c of v as PLSet) {
+					p.push(i++);
+					r.push(x(c, p));
+					p.pop();
+				}
+				return r;
+			};
+			break;
+		}
+		case 'dictionary': {
+			const { required = {}, optional = {}, values } = schema;
+			const m = new Map<string, Extract>();
+			for (const k of Object.keys(optional)) {
+				m.set(k, compile(optional[k]));
+			}
+			for (const k of Object.keys(required)) {
+				m.set(k, compile(required[k]));
+			}
+			const o = values === undefined ? null : compile(values);
+			const q = Object.keys(required);
+			e = (v, p) => {
+				if (v[Symbol.toStringTag] !== PLTYPE_DICTIONARY) {
+					expected('dictionary', p);
+				}
+				const r: Record<string, unknown> = {};
+				for (const [k, c] of v as PLDictionary) {
+					if (k[Symbol.toStringTag] === PLTYPE_STRING) {
+						const s = (k as PLString).value;
+						const x = m.get(s) ?? o;
+						if (x) {
+							p.push(s);
+							set(r, s, x(c, p));
+							p.pop();
+						}
+					}
+				}
+				for (const k of q) {
+					if (!Object.hasOwn(r, k)) {
+						p.push(k);
+						throw new TypeError(`Missing key: ${path(p)}`);
+					}
+				}
+				return r;
+			};
+			break;
+		}
+		default: {
+			throw new RangeError(
+				`Invalid schema: ${(schema as { type: unknown }).type}`,
+			);
+		}
+	}
+	compiled.set(schema, e);
+	return e;
+}
+
+/**
+ * Compile schema into an extractor, cached for each schema object.
+ * Schemas declared separately need `as const` for literal types.
+ *
+ * @template S Schema type.
+ * @param schema Schema.
+ * @returns Extractor.
+ */
+export function compileSchema<const S extends Schema>(
+	schema: S,
+): SchemaExtractor<S> {
+	const e = compile(schema);
+	return (plist) => e(plist, []) as SchemaOutput<S>;
+}
+
+/**
+ * Extract typed values from plist, as described by schema.
+ * Only values in the schema are visited, others are skipped.
+ * Mismatched types and missing required keys throw a type error,
+ * with the query path of the value.
+ *
+ * @template S Schema type.
+ * @param plist Plist object.
+ * @param schema Schema.
+ * @returns Extracted value.
+ */
+export function extract<const S extends Schema>(
+	plist: PLType,
+	schema: S,
+): SchemaOutput<S> {
+	return compile(schema)(plist, []) as SchemaOutput<S>;
+}
@@ -0,0 +1,32 @@
+// deno-lint-ignore-file no-console
+
+if (Deno.args.length !== 2) {
+	console.error('Args: before.json after.json');
+	Deno.exit(1);
+}
+
+interface Bench {
+	origin: string;
+	name: string;
+	results: { ok?: { avg: number } }[];
+}
+
+const read = (f: string): Map<string, number> =>
+	new Map(
+		(JSON.parse(Deno.readTextFileSync(f)).benches as Bench[])
+			.filter((b) => b.results[0]?.ok)
+			.map((b) => [
+				`${b.origin.replace(/^.*\//, '')}: ${b.name}`,
+				b.results[0].ok!.avg,
+			]),
+	);
+
+const [before, after] = Deno.args.map(read);
+const ms = (ns: number): string => (ns / 1e6).toFixed(3).padStart(10);
+for (const [name, b] of before) {
+	const a = after.get(name);
+	if (a !== undefined) {
+		const r = ((a / b - 1) * 100).toFixed(1);
+		console.log(`${ms(b)} ${ms(a)} ${r.padStart(7)}% ${name}`);
+	}
+}
@@ -0,0 +1,176 @@
+// deno-lint-ignore-file no-console no-top-level-await
+
+import { decodeCompressed, encodeCompressed } from '../compress.ts';
+import { decode } from '../decode/mod.ts';
+import { encode } from '../encode/mod.ts';
+import { FORMAT_BINARY_V1_0 } from '../format.ts';
+import { benchPlist, type BenchShape, benchShapes } from '../spec/bench.ts';
+import type { PLType } from '../type.ts';
+
+type Approach = 'stream' | 'buffer';
+
+type Codec = 'decode' | 'encode';
+
+interface Sample {
+	// Compressed bytes.
+	size: number;
+	// Milliseconds per run, after the first.
+	time: number;
+	// Peak RSS growth in bytes, during the first run.
+	peak: number;
+}
+
+const approaches: readonly Approach[] = ['stream', 'buffer'];
+
+const codecs: readonly Codec[] = ['decode', 'encode'];
+
+const format = FORMAT_BINARY_V1_0;
+
+const flags = [
+	'--allow-read',
+	'--allow-write=/proc/self/clear_refs',
+	'--v8-flags=--expose-gc',
+];
+
+function hwm(): number {
+	const s = Deno.readTextFileSync('/proc/self/status');
+	return +(s.match(/^VmHWM:\s*(\d+)/m)?.[1] ?? 0) * 1024;
+}
+
+async function buffered(
+	data: Uint8Array<ArrayBuffer>,
+	transform: CompressionStream | DecompressionStream,
+): Promise<Uint8Array<ArrayBuffer>> {
+	return new Uint8Array(
+		await new Response(new Blob([data]).stream().pipeThrough(transform))
+			.arrayBuffer(),
+	);
+}
+
+async function sink(stream: ReadableStream<Uint8Array>): Promise<number> {
+	let n = 0;
+	for (const reader = stream.getReader();;) {
+		const { done, value } = await reader.read();
+		if (done) {
+			return n;
+		}
+		n += value.length;
+	}
+}
+
+async function sample(
+	shape: BenchShape,
+	approach: Approach,
+	codec: Codec,
+	size: number,
+): Promise<Sample> {
+	let plist: PLType | null = benchPlist(shape, size);
+	const compressed = await buffered(
+		encode(plist, { format }),
+		new CompressionStream('gzip'),
+	);
+	let run: () => Promise<unknown>;
+	if (codec === 'decode') {
+		plist = null;
+		run = approach === 'stream'
+			? () => decodeCompressed(compressed)
+			: async () => {
+				const gunzip = new DecompressionStream('gzip');
+				return decode(await buffered(compressed, gunzip));
+			};
+	} else {
+		const p = plist;
+		run = approach === 'stream'
+			? () => sink(encodeCompressed(p, { format }))
+			: () => {
+				const gzip = new CompressionStream('gzip');
+				return buffered(encode(p, { format }), gzip);
+			};
+	}
+	(globalThis as { gc?: () => void }).gc?.();
+	Deno.writeTextFileSync('/proc/self/clear_refs', '5');
+	const rss = Deno.memoryUsage().rss;
+	await run();
+	const peak = hwm() - rss;
+	const start = performance.now();
+	let time = 0;
+	let i = 0;
+	while (time < 100) {
+		await run();
+		time = performance.now() - start;
+		i++;
+	}
+	return { size: compressed.length, time: time / i, peak: Math.max(peak, 0) };
+}
+
+function spawn(
+	shape: BenchShape,
+	approach: Approach,
+	codec: Codec,
+	size: number,
+): Sample | null {
+	const { success, stdout } = new Deno.Command(Deno.execPath(), {
+		args: [
+			'run',
+			...flags,
+			import.meta.filename!,
+			'--child',
+			shape,
+			approach,
+			codec,
+			`${size}`,
+		],
+		stdin: 'null',
+		stderr: 'null',
+	}).outputSync();
+	return success ? JSON.parse(new TextDecoder().decode(stdout)) : null;
+}
+
+if (Deno.args[0] === '--child') {
+	const [, shape, approach, codec, size] = Deno.args;
+	console.log(JSON.stringify(
+		await sample(
+			shape as BenchShape,
+			approach as Approach,
+			codec as Codec,
+			+size,
+		),
+	));
+	Deno.exit(0);
+}
+
+const scale = +(Deno.args.find((a) => /^--scale=/.test(a))?.slice(8) ?? 10);
+const json = Deno.args.includes('--json');
+const sizes: { [S in BenchShape]: number } = {
+	wide: 10000,
+	deep: 1000,
+	strings: 10000,
+	blobs: 0x10000,
+	integers: 100000,
+};
+
+const results = [];
+for (const shape of benchShapes) {
+	for (const codec of codecs) {
+		for (const approach of approaches) {
+			const size = Math.round(sizes[shape] * scale);
+			const s = spawn(shape, approach, codec, size);
+			results.push({ shape, codec, approach, ...s });
+			if (!json) {
+				console.log(
+					s
+						? [
+							`${shape} ${codec} ${approach}:`,
+							`${s.size}B`,
+							`${s.time.toFixed(2)}ms`,
+							`peak ${(s.peak / 1048576).toFixed(1)}MiB`,
+						].join(' ')
+						: `${shape} ${codec} ${approach}: failed`,
+				);
+			}
+		}
+	}
+}
+if (json) {
+	console.log(JSON.stringify(results));
+}
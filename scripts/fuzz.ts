@@ -0,0 +1,380 @@
+// deno-lint-ignore-file no-console
+
+import { decodeBinary } from '../decode/binary.ts';
+import { decodeOpenStep } from '../decode/openstep.ts';
+import { decodeXml } from '../decode/xml.ts';
+import { benchFixtures, benchFuzzed } from '../spec/bench.ts';
+import type { Trace } from '../trace.ts';
+
+type Format = 'binary' | 'xml' | 'openstep';
+
+interface Case {
+	// Encoded input.
+	data: Uint8Array;
+	// Microseconds per byte.
+	time: number;
+	// Heap bytes allocated per byte.
+	alloc: number;
+	// From fixtures, not saved again.
+	fixture?: boolean;
+}
+
+const formats: readonly Format[] = ['binary', 'xml', 'openstep'];
+
+const decoders: {
+	[F in Format]: (
+		d: Uint8Array,
+		o: { trace: (t: Trace) => void },
+	) => unknown;
+} = {
+	binary: decodeBinary,
+	xml: decodeXml,
+	openstep: decodeOpenStep,
+};
+
+const tokens: { [F in Format]: string[] } = {
+	binary: [
+		'bplist00',
+		'\x0f',
+		'\x10\xff',
+		'\x13\x7f\xff\xff\xff\xff\xff\xff\xff',
+		'\x4f\x10\xff',
+		'\x5f\x10\xff',
+		'\x6f\x11\xff\xff',
+		'\xaf\x10\xff',
+		'\xdf\x10\xff',
+		'\x80\x00',
+		'\x00\x00\x00\x00\x00\x00\x00\x00',
+		'\xff\xff\xff\xff\xff\xff\xff\xff',
+	],
+	xml: [
+		'<array>',
+		'</array>',
+		'<dict>',
+		'</dict>',
+		'<key>a</key>',
+		'<string>',
+		'</string>',
+		'<data>',
+		'</data>',
+		'<integer>',
+		'<real>',
+		'<date>',
+		'<true/>',
+		'<!-- ',
+		' -->',
+		'<?xml ?>',
+		'<!DOCTYPE plist>',
+		'<![CDATA[',
+		']]>',
+		'&#x10FFFF;',
+		'&#99999999999999999999;',
+		'&#x',
+		'&amp;',
+		'&lt;',
+		'9999999999999999999999',
+	],
+	openstep: [
+		'(',
+		')',
+		'{',
+		'}',
+		'<',
+		'>',
+		'"',
+		"'",
+		'\\',
+		'\\U0000',
+		'\\377',
+		'/*',
+		'*/',
+		'//',
+		'\n',
+		'=',
+		';',
+		',',
+		'<*I1>',
+		'<*D2000-01-01 00:00:00 +0000>',
+		'<*BY>',
+		'<*R1>',
+	],
+};
+
+const interesting = [0, 1, 0x7f, 0x80, 0xff, 0x0a, 0x20, 0x22, 0x26, 0x3c];
+
+function hash(d: Uint8Array): string {
+	let h = 0x811c9dc5;
+	for (const b of d) {
+		h = Math.imul(h ^ b, 0x01000193);
+	}
+	return (h >>> 0).toString(16).padStart(8, '0');
+}
+
+function random(seed: number): (n: number) => number {
+	let s = seed >>> 0;
+	return (n: number): number => {
+		s = (s + 0x6d2b79f5) >>> 0;
+		let t = s;
+		t = Math.imul(t ^ (t >>> 15), t | 1);
+		t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+		return (((t ^ (t >>> 14)) >>> 0) % n);
+	};
+}
+
+function splice(
+	d: Uint8Array,
+	i: number,
+	remove: number,
+	insert: Uint8Array,
+): Uint8Array {
+	const r = new Uint8Array(d.length - remove + insert.length);
+	r.set(d.subarray(0, i));
+	r.set(insert, i);
+	r.set(d.subarray(i + remove), i + insert.length);
+	return r;
+}
+
+function latin1(s: string): Uint8Array {
+	return Uint8Array.from(s, (c) => c.charCodeAt(0));
+}
+
+function mutate(
+	d: Uint8Array,
+	format: Format,
+	other: Uint8Array,
+	rand: (n: number) => number,
+): Uint8Array {
+	const l = d.length;
+	const i = rand(l + 1);
+	switch (rand(l ? 8 : 1)) {
+		case 0: {
+			const t = tokens[format];
+			return splice(d, i, 0, latin1(t[rand(t.length)]));
+		}
+		case 1: {
+			// Repeat a slice, for deep nesting and long runs.
+			const j = i + rand(Math.min(l - i, 64) + 1);
+			const s = d.subarray(i, j);
+			const n = 2 + rand(256);
+			const r = new Uint8Array(s.length * n);
+			for (let k = 0; k < n; k++) {
+				r.set(s, k * s.length);
+			}
+			return splice(d, i, 0, r);
+		}
+		case 2: {
+			const r = d.slice();
+			r[rand(l)] ^= 1 << rand(8);
+			return r;
+		}
+		case 3: {
+			const r = d.slice();
+			r[rand(l)] = interesting[rand(interesting.length)];
+			return r;
+		}
+		case 4: {
+			const n = rand(Math.min(l - i, 64) + 1);
+			return splice(d, i, n, new Uint8Array());
+		}
+		case 5: {
+			// Copy a slice of another input, for crossing structures.
+			const a = rand(other.length + 1);
+			const b = a + rand(Math.min(other.length - a, 256) + 1);
+			return splice(d, i, 0, other.subarray(a, b));
+		}
+		case 6: {
+			// Trailer and header fields of binary, and numbers of text.
+			const r = d.slice();
+			const j = rand(2) ? rand(l) : Math.max(0, l - 1 - rand(32));
+			r[j] = rand(2) ? r[j] + 1 - rand(3) : rand(256);
+			return r;
+		}
+		default: {
+			// Duplicate a byte run, for reference fan-out.
+			const a = rand(l);
+			const n = 1 + rand(Math.min(l - a, 8));
+			const r = d.slice();
+			r.copyWithin(rand(l - n + 1), a, a + n);
+			return r;
+		}
+	}
+}
+
+function measure(
+	format: Format,
+	data: Uint8Array,
+	min: number,
+	repeat: number,
+): [Case, string] {
+	const decode = decoders[format];
+	let signature = '';
+	const trace = (t: Trace): void => {
+		const o = t.objects;
+		signature = [
+			...Object.keys(o).map((k) =>
+				`${k}${Math.ceil(Math.log2(o[k as keyof typeof o] + 1))}`
+			),
+			`d${Math.ceil(Math.log2(t.depth + 1))}`,
+			`s${Math.ceil(Math.log2(t.shared + 1))}`,
+		].join(',');
+	};
+	const run = (): void => {
+		try {
+			decode(data, { trace });
+		} catch (e) {
+			// Message without offsets or quoted input.
+			const { name, message } = e as Error;
+			signature = `${name}: ${message.replace(/:.*|\s\S*\d.*/s, '')}`;
+		}
+	};
+	const heap = Deno.memoryUsage().heapUsed;
+	run();
+	const alloc = Math.max(Deno.memoryUsage().heapUsed - heap, 0);
+	// Fastest of the runs, as collection and compilation only add time.
+	let time = Infinity;
+	for (let i = 0; i < repeat; i++) {
+		const start = performance.now();
+		run();
+		time = Math.min(time, performance.now() - start);
+	}
+	const size = Math.max(data.length, min);
+	return [
+		{ data, time: time * 1000 / size, alloc: alloc / size },
+		signature,
+	];
+}
+
+function fuzz(
+	format: Format,
+	runs: number,
+	size: number,
+	min: number,
+	rand: (n: number) => number,
+): Case[] {
+	const corpus: Case[] = [];
+	const seen = new Set<string>();
+	const tiers = new Set<string>();
+	// Keep inputs with new behavior, by outcome and cost tier.
+	const add = (d: Uint8Array, seed = false, fixture = false): void => {
+		const data = d.length > size ? d.slice(0, size) : d;
+		const [c, s] = measure(format, data, min, 3);
+		const t = `${s}|${Math.round(Math.log2(c.time))}` +
+			`|${Math.round(Math.log2(c.alloc + 1))}`;
+		const k = hash(data);
+		if (!seen.has(k) && (!tiers.has(t) || seed)) {
+			tiers.add(t);
+			seen.add(k);
+			c.fixture = fixture;
+			corpus.push(c);
+		}
+	};
+	for (const d of benchFixtures(format, () => {})) {
+		add(d, true, true);
+	}
+	for (const [, d] of benchFuzzed(format)) {
+		add(d, true);
+	}
+	for (let r = 0; r < runs; r++) {
+		// Favor the slowest inputs as parents.
+		const parent = rand(2)
+			? corpus.reduce((a, b) =>
+				rand(4) && b.time + b.alloc / 64 > a.time + a.alloc / 64 ? b : a
+			)
+			: corpus[rand(corpus.length)];
+		let d = parent.data;
+		for (let m = 1 + rand(4); m--;) {
+			d = mutate(d, format, corpus[rand(corpus.length)].data, rand);
+		}
+		add(d);
+	}
+	return corpus;
+}
+
+function worst(corpus: Case[], count: number): Case[] {
+	const r = new Set([
+		...corpus.toSorted((a, b) => b.time - a.time).slice(0, count),
+		...corpus.toSorted((a, b) => b.alloc - a.alloc).slice(0, count),
+	]);
+	return [...r];
+}
+
+const args = new Map(
+	Deno.args.map((a) => {
+		const m = a.match(/^--([^=]+)(?:=(.*))?$/);
+		if (!m) {
+			console.error(
+				'Args: [--format=...] [--runs=10000] [--seed=1]' +
+					' [--size=4096] [--min=256] [--time=1] [--alloc=Infinity]' +
+					' [--worst=4] [--save] [--json]',
+			);
+			Deno.exit(1);
+		}
+		return [m[1], m[2] ?? ''];
+	}),
+);
+const num = (k: string, d: number): number => +(args.get(k) ?? d);
+const runs = num('runs', 10000);
+const size = num('size', 4096);
+const min = num('min', 256);
+const limitTime = num('time', 1);
+const limitAlloc = num('alloc', Infinity);
+const count = num('worst', 4);
+const save = args.has('save');
+const json = args.has('json');
+const rand = random(num('seed', 1));
+const selected = (args.get('format')?.split(',') ?? formats) as Format[];
+for (const format of selected) {
+	if (!formats.includes(format)) {
+		console.error(`Invalid format: ${format}`);
+		Deno.exit(1);
+	}
+}
+
+const results = [];
+let failed = false;
+for (const format of selected) {
+	const corpus = fuzz(format, runs, size, min, rand);
+	for (const w of worst(corpus, count)) {
+		// Remeasure for longer, with the same inputs, to reduce noise.
+		const [c, signature] = measure(format, w.data, min, 100);
+		const name = hash(c.data);
+		const over = c.time > limitTime || c.alloc > limitAlloc;
+		failed ||= over;
+		if (save && !w.fixture) {
+			const dir = new URL(`../spec/fuzz/${format}/`, import.meta.url);
+			Deno.mkdirSync(dir, { recursive: true });
+			Deno.writeFileSync(new URL(`${name}.plist`, dir), c.data);
+		}
+		const r = {
+			format,
+			name,
+			bytes: c.data.length,
+			time: c.time,
+			alloc: c.alloc,
+			signature,
+			over,
+		};
+		results.push(r);
+		if (!json) {
+			console.log(
+				[
+					`${format} ${name}:`,
+					`${r.bytes}B`,
+					`${r.time.toFixed(4)}us/B`,
+					`${r.alloc.toFixed(1)}B/B`,
+					over ? 'OVER' : 'ok',
+					signature.slice(0, 60),
+				].join(' '),
+			);
+		}
+	}
+	if (!json) {
+		console.log(`${format}: corpus ${corpus.length}`);
+	}
+}
+if (json) {
+	console.log(JSON.stringify(results));
+}
+if (failed) {
+	Deno.exit(1);
+}
@@ -0,0 +1,237 @@
+// deno-lint-ignore-file no-console
+
+import { decodeBinary } from '../decode/binary.ts';
+import { decodeOpenStep } from '../decode/openstep.ts';
+import { decodeXml } from '../decode/xml.ts';
+import { encodeBinary } from '../encode/binary.ts';
+import { encodeOpenStep } from '../encode/openstep.ts';
+import { encodeXml } from '../encode/xml.ts';
+import { benchPlist, type BenchShape, benchShapes } from '../spec/bench.ts';
+import type { PLType } from '../type.ts';
+
+type Format = 'binary' | 'xml' | 'openstep';
+
+type Codec = 'decode' | 'encode';
+
+interface Sample {
+	// Encoded bytes.
+	size: number;
+	// Milliseconds per run, after the first.
+	time: number;
+	// Peak RSS growth in bytes, during the first run.
+	peak: number;
+	// Heap growth in bytes, during the first run.
+	heap: number;
+}
+
+const formats: readonly Format[] = ['binary', 'xml', 'openstep'];
+
+const codecs: readonly Codec[] = ['decode', 'encode'];
+
+const coders: {
+	[F in Format]: [(p: PLType) => Uint8Array, (e: Uint8Array) => unknown];
+} = {
+	binary: [encodeBinary, decodeBinary],
+	xml: [encodeXml, decodeXml],
+	openstep: [encodeOpenStep, decodeOpenStep],
+};
+
+// Approximate encoded bytes per unit of shape size.
+const units: { [S in BenchShape]: number } = {
+	wide: 24,
+	deep: 40,
+	strings: 16,
+	blobs: 16,
+	integers: 6,
+};
+
+const flags = [
+	'--allow-read',
+	'--allow-write=/proc/self/clear_refs',
+	'--v8-flags=--expose-gc',
+];
+
+function hwm(): number {
+	const s = Deno.readTextFileSync('/proc/self/status');
+	return +(s.match(/^VmHWM:\s*(\d+)/m)?.[1] ?? 0) * 1024;
+}
+
+function sample(
+	shape: BenchShape,
+	format: Format,
+	codec: Codec,
+	size: number,
+): Sample {
+	const [encode, decode] = coders[format];
+	let plist: PLType | null = benchPlist(shape, size, format === 'openstep');
+	const encoded = encode(plist);
+	let run: () => unknown;
+	if (codec === 'decode') {
+		plist = null;
+		run = () => decode(encoded);
+	} else {
+		const p = plist;
+		run = () => encode(p);
+	}
+	(globalThis as { gc?: () => void }).gc?.();
+	const heap = Deno.memoryUsage().heapUsed;
+	Deno.writeTextFileSync('/proc/self/clear_refs', '5');
+	const rss = Deno.memoryUsage().rss;
+	run();
+	const peak = hwm() - rss;
+	const used = Deno.memoryUsage().heapUsed - heap;
+	const start = performance.now();
+	let time = 0;
+	let i = 0;
+	while (time < 100) {
+		run();
+		time = performance.now() - start;
+		i++;
+	}
+	return {
+		size: encoded.length,
+		time: time / i,
+		peak: Math.max(peak, 0),
+		heap: Math.max(used, 0),
+	};
+}
+
+function spawn(
+	shape: BenchShape,
+	format: Format,
+	codec: Codec,
+	size: number,
+): Sample | null {
+	const { success, stdout } = new Deno.Command(Deno.execPath(), {
+		args: [
+			'run',
+			...flags,
+			import.meta.filename!,
+			'--child',
+			shape,
+			format,
+			codec,
+			`${size}`,
+		],
+		stdin: 'null',
+		stderr: 'null',
+	}).outputSync();
+	return success ? JSON.parse(new TextDecoder().decode(stdout)) : null;
+}
+
+function exponent(samples: Sample[]): number {
+	const x = samples.map((s) => Math.log(s.size));
+	const y = samples.map((s) => Math.log(s.time));
+	const n = x.length;
+	const mx = x.reduce((a, b) => a + b, 0) / n;
+	const my = y.reduce((a, b) => a + b, 0) / n;
+	let xy = 0;
+	let xx = 0;
+	for (let i = 0; i < n; i++) {
+		xy += (x[i] - mx) * (y[i] - my);
+		xx += (x[i] - mx) ** 2;
+	}
+	return xx ? xy / xx : 0;
+}
+
+function list<T extends string>(
+	name: string,
+	all: readonly T[],
+	args: Map<string, string>,
+): T[] {
+	const v = args.get(name);
+	if (v === undefined) {
+		return [...all];
+	}
+	const r = v.split(',') as T[];
+	for (const s of r) {
+		if (!all.includes(s)) {
+			console.error(`Invalid ${name}: ${s}`);
+			Deno.exit(1);
+		}
+	}
+	return r;
+}
+
+if (Deno.args[0] === '--child') {
+	const [, shape, format, codec, size] = Deno.args;
+	console.log(JSON.stringify(
+		sample(shape as BenchShape, format as Format, codec as Codec, +size),
+	));
+	Deno.exit(0);
+}
+
+const args = new Map(
+	Deno.args.map((a) => {
+		const m = a.match(/^--([^=]+)(?:=(.*))?$/);
+		if (!m) {
+			console.error(
+				'Args: [--shape=...] [--format=...] [--codec=...]' +
+					' [--min=1024] [--max=1073741824] [--factor=4]' +
+					' [--fit=65536] [--exponent=1.2] [--ratio=64] [--json]',
+			);
+			Deno.exit(1);
+		}
+		return [m[1], m[2] ?? ''];
+	}),
+);
+const num = (k: string, d: number): number => +(args.get(k) ?? d);
+const min = num('min', 1024);
+const max = num('max', 1 << 30);
+const factor = num('factor', 4);
+const fit = num('fit', 65536);
+const limit = num('exponent', 1.2);
+const ratio = num('ratio', 64);
+const json = args.has('json');
+
+const results = [];
+let failed = false;
+for (const shape of list('shape', benchShapes, args)) {
+	for (const format of list('format', formats, args)) {
+		for (const codec of list('codec', codecs, args)) {
+			const samples: Sample[] = [];
+			let error = 0;
+			for (let size = min; size <= max; size *= factor) {
+				const n = Math.max(1, Math.round(size / units[shape]));
+				const s = spawn(shape, format, codec, n);
+				if (!s) {
+					error = size;
+					break;
+				}
+				samples.push(s);
+			}
+			const large = samples.filter((s) => s.size >= fit);
+			const fitted = large.length > 1 ? large : samples;
+			const k = exponent(fitted);
+			const amp = Math.max(0, ...fitted.map((s) => s.peak / s.size));
+			const issues = [];
+			if (k > limit) {
+				issues.push(`exponent ${k.toFixed(2)} > ${limit}`);
+			}
+			if (amp > ratio) {
+				issues.push(`memory ${amp.toFixed(1)}x > ${ratio}x`);
+			}
+			if (error) {
+				issues.push(`failed at ${error} bytes`);
+			}
+			failed ||= issues.length > 0;
+			results.push({ shape, format, codec, exponent: k, amp, samples });
+			if (!json) {
+				const last = samples[samples.length - 1];
+				console.log(
+					[
+						`${shape} ${format} ${codec}:`,
+						`n^${k.toFixed(2)}`,
+						`${amp.toFixed(1)}x`,
+						last ? `${last.size}B ${last.time.toFixed(2)}ms` : '-',
+						...issues.map((s) => `! ${s}`),
+					].join(' '),
+				);
+			}
+		}
+	}
+}
+if (json) {
+	console.log(JSON.stringify(results));
+}
+Deno.exit(failed ? 1 : 0);
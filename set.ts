@@ -4,10 +4,10 @@
  * Property list set.
  */
 
+import { sets } from './pri/set.ts';
+import { mutable } from './pri/mutate.ts';
 import type { PLType } from './type.ts';
 
-const sets = new WeakMap<PLSet, Set<PLType>>();
-
 /**
  * PLSet type.
  */
@@ -60,6 +60,7 @@ export class PLSet<T extends PLType = PLType> {
 	 * @param value Value.
 	 */
 	public add(value: T): void {
+		mutable(this);
 		(sets.get(this) as Set<T>).add(value);
 	}
 
@@ -70,6 +71,7 @@ export class PLSet<T extends PLType = PLType> {
 	 * @returns Deleted.
 	 */
 	public delete(value: T): boolean {
+		mutable(this);
 		return (sets.get(this) as Set<T>).delete(value);
 	}
 
@@ -77,6 +79,7 @@ export class PLSet<T extends PLType = PLType> {
 	 * Clear set.
 	 */
 	public clear(): void {
+		mutable(this);
 		(sets.get(this) as Set<T>).clear();
 	}
 
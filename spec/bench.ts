@@ -0,0 +1,133 @@
+import { PLArray } from '../array.ts';
+import { PLData } from '../data.ts';
+import { PLDictionary } from '../dictionary.ts';
+import { PLInteger } from '../integer.ts';
+import { PLString } from '../string.ts';
+import type { PLType } from '../type.ts';
+
+export function benchFixtures(
+	format: 'binary' | 'openstep' | 'xml',
+	check: (encoded: Uint8Array) => unknown,
+): Uint8Array[] {
+	const base = new URL('fixtures/plist/', import.meta.url);
+	const r: Uint8Array[] = [];
+	for (
+		const group of [...Deno.readDirSync(base)]
+			.filter((e) => e.isDirectory)
+			.map((e) => e.name)
+			.sort()
+	) {
+		const dir = new URL(`${group}/`, base);
+		for (const file of Deno.readDirSync(dir)) {
+			if (file.name === `${format}.plist`) {
+				const d = Deno.readFileSync(new URL(file.name, dir));
+				try {
+					check(d);
+					r.push(d);
+				} catch {
+					// Invalid fixture.
+				}
+			}
+		}
+	}
+	return r;
+}
+
+export function benchFuzzed(
+	format: 'binary' | 'openstep' | 'xml',
+): [string, Uint8Array][] {
+	const dir = new URL(`fuzz/${format}/`, import.meta.url);
+	let files;
+	try {
+		files = [...Deno.readDirSync(dir)];
+	} catch {
+		return [];
+	}
+	return files
+		.filter((e) => e.isFile && e.name.endsWith('.plist'))
+		.map((e) => e.name)
+		.sort()
+		.map((name) => [
+			name.slice(0, -6),
+			Deno.readFileSync(new URL(name, dir)),
+		]);
+}
+
+export type BenchShape = 'wide' | 'deep' | 'strings' | 'blobs' | 'integers';
+
+export const benchShapes: readonly BenchShape[] = [
+	'wide',
+	'deep',
+	'strings',
+	'blobs',
+	'integers',
+];
+
+export function benchPlist(
+	shape: BenchShape,
+	size: number,
+	openstep = false,
+): PLType {
+	const int = (i: number): PLType =>
+		openstep ? new PLString(`${i}`) : new PLInteger(i);
+	switch (shape) {
+		case 'wide': {
+			const wide = new PLDictionary();
+			for (let i = 0; i < size; i++) {
+				wide.set(new PLString(`key-${i}`), int(i));
+			}
+			return wide;
+		}
+		case 'deep': {
+			let deep: PLType = int(0);
+			for (let i = 0; i < size; i++) {
+				deep = new PLArray([
+					deep,
+					new PLDictionary([[new PLString('key'), int(i)]]),
+				]);
+			}
+			return deep;
+		}
+		case 'strings': {
+			const strings = new PLArray();
+			for (let i = 0; i < 16; i++) {
+				const text = i & 1 ? 'ascii text ' : 'unicode \u00e9\u4e16 ';
+				const n = Math.ceil(size / text.length);
+				strings.push(new PLString(text.repeat(n).slice(0, size)));
+			}
+			return strings;
+		}
+		case 'blobs': {
+			const blobs = new PLArray();
+			for (let i = 0; i < 16; i++) {
+				const d = new Uint8Array(size);
+				for (let j = 0; j < size; j++) {
+					d[j] = i + j * 31;
+				}
+				blobs.push(new PLData(d.buffer));
+			}
+			return blobs;
+		}
+		case 'integers': {
+			const integers = new PLArray();
+			for (let i = 0; i < size; i++) {
+				const v = i & 1 ? i : i * 0x9e3779b1 % 0x7fffffff;
+				integers.push(int(v));
+			}
+			return integers;
+		}
+	}
+}
+
+export function benchPlists(openstep = false): [string, PLType][] {
+	return ([
+		['wide', 10000],
+		['deep', 1000],
+		['strings', 10000],
+		['blobs', 0x10000],
+		['integers', 100000],
+	] as const).map(([shape, size]) => [
+		shape,
+		benchPlist(shape, size, openstep),
+	]);
+}
@@ -36,6 +36,21 @@ export async function fixturePlist(
 	return await fixture(`plist/${group}/${name}.plist`);
 }
 
+export async function fixturePlists(): Promise<[string, string][]> {
+	const base = `${await (fixtures ??= findFixtures())}/plist`;
+	const r: [string, string][] = [];
+	for await (const group of Deno.readDir(base)) {
+		if (group.isDirectory) {
+			for await (const file of Deno.readDir(`${base}/${group.name}`)) {
+				if (file.name.endsWith('.plist')) {
+					r.push([group.name, file.name.slice(0, -6)]);
+				}
+			}
+		}
+	}
+	return r.sort();
+}
+
 export async function fixtureNextStepLatin(): Promise<Map<number, number[]>> {
 	const r = new Map<number, number[]>();
 	for (
@@ -4,6 +4,8 @@
  * Property list string.
  */
 
+import { mutable } from './pri/mutate.ts';
+import { metas } from './pri/string.ts';
 import type { PLType } from './type.ts';
 
 const values = new WeakMap<PLString, string>();
@@ -48,7 +50,9 @@ export class PLString {
 	 * @param value String value.
 	 */
 	public set value(value: string) {
+		mutable(this);
 		values.set(this, '' + value);
+		metas.delete(this);
 	}
 
 	/**
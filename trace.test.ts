@@ -0,0 +1,130 @@
+import { assertEquals, assertGreaterOrEqual } from '@std/assert';
+import { PLArray } from './array.ts';
+import { PLData } from './data.ts';
+import { decode, decodeAsync, validate } from './decode/mod.ts';
+import { decodeBinary } from './decode/binary.ts';
+import { decodeOpenStep } from './decode/openstep.ts';
+import { decodeXml } from './decode/xml.ts';
+import { PLDictionary } from './dictionary.ts';
+import { encode, encodeAsync } from './encode/mod.ts';
+import { encodeBinary } from './encode/binary.ts';
+import {
+	type Format,
+	FORMAT_BINARY_V1_0,
+	FORMAT_OPENSTEP,
+	FORMAT_XML_V1_0,
+} from './format.ts';
+import { PLString } from './string.ts';
+import type { Trace } from './trace.ts';
+import type { PLType } from './type.ts';
+
+const FORMATS: Format[] = [
+	FORMAT_BINARY_V1_0,
+	FORMAT_XML_V1_0,
+	FORMAT_OPENSTEP,
+];
+
+const PHASES = {
+	[FORMAT_BINARY_V1_0]: [['trailer', 'objects'], ['size', 'write']],
+	[FORMAT_XML_V1_0]: [['decode', 'parse'], ['size', 'write']],
+	[FORMAT_OPENSTEP]: [['decode', 'parse'], ['size', 'write']],
+} as Record<Format, [string[], string[]]>;
+
+function tree(): PLType {
+	const shared = new PLString('shared');
+	const e = new PLString('\u00e9');
+	return new PLDictionary<PLType, PLType>([
+		[new PLString('a'), new PLArray([shared, shared, e])],
+		[new PLString('b'), new PLData(new Uint8Array(5).buffer)],
+		[new PLString('c'), new PLArray([new PLArray()])],
+	]);
+}
+
+function check(
+	trace: Trace,
+	format: Format,
+	bytes: number,
+	encoded: boolean,
+): void {
+	assertEquals(trace.format, format);
+	assertEquals(trace.bytes, bytes);
+	assertEquals(
+		Object.keys(trace.phases),
+		PHASES[format][encoded ? 1 : 0],
+	);
+	for (const ms of Object.values(trace.phases)) {
+		assertGreaterOrEqual(ms, 0);
+	}
+	assertEquals(trace.objects.PLDictionary, 1);
+	assertEquals(trace.objects.PLArray, 3);
+	assertEquals(trace.objects.PLData, 1);
+	assertEquals(trace.objects.PLInteger, 0);
+	assertEquals(trace.depth, 3);
+	assertEquals(trace.data, 5);
+	if (encoded || format === FORMAT_BINARY_V1_0) {
+		assertEquals(trace.objects.PLString, 5);
+		assertEquals(trace.shared, 1);
+		assertEquals(trace.strings, 3 + 6 + 2);
+	} else {
+		assertEquals(trace.objects.PLString, 6);
+		assertEquals(trace.shared, 0);
+		assertEquals(trace.strings, 3 + 6 + 6 + 2);
+	}
+}
+
+Deno.test('trace: decode and encode', () => {
+	for (const format of FORMATS) {
+		const traces: Trace[] = [];
+		const trace = (t: Trace) => traces.push(t);
+		const encoded = encode(tree(), { format, trace });
+		assertEquals(traces.length, 1, format);
+		check(traces[0], format, encoded.length, true);
+		decode(encoded, { trace });
+		assertEquals(traces.length, 2, format);
+		check(traces[1], format, encoded.length, false);
+		validate(encoded, { trace });
+		assertEquals(traces.length, 2, format);
+	}
+});
+
+Deno.test('trace: async', async () => {
+	for (const format of FORMATS) {
+		const traces: Trace[] = [];
+		const trace = (t: Trace) => traces.push(t);
+		const encoded = await encodeAsync(tree(), { format, trace, step: 1 });
+		check(traces[0], format, encoded.length, true);
+		await decodeAsync(encoded, { trace, step: 1 });
+		check(traces[1], format, encoded.length, false);
+		assertEquals(traces.length, 2, format);
+	}
+});
+
+Deno.test('trace: per format', () => {
+	const traces: Trace[] = [];
+	const trace = (t: Trace) => traces.push(t);
+	const encoded = encodeBinary(tree());
+	decodeBinary(encoded, { trace });
+	decode(encoded, { binary: { trace } });
+	decode(encoded, { trace: () => {}, binary: { trace } });
+	assertEquals(traces.length, 3);
+	decodeXml(encode(tree(), { format: FORMAT_XML_V1_0 }), { trace });
+	decodeOpenStep(encode(tree(), { format: FORMAT_OPENSTEP }), { trace });
+	assertEquals(traces.map((t) => t.format), [
+		FORMAT_BINARY_V1_0,
+		FORMAT_BINARY_V1_0,
+		FORMAT_BINARY_V1_0,
+		FORMAT_XML_V1_0,
+		FORMAT_OPENSTEP,
+	]);
+});
+
+Deno.test('trace: failure', () => {
+	const traces: Trace[] = [];
+	const trace = (t: Trace) => traces.push(t);
+	try {
+		decodeXml(new TextEncoder().encode('<plist>'), { trace });
+	} catch {
+		// Expected.
+	}
+	assertEquals(traces.length, 0);
+});
@@ -0,0 +1,70 @@
+/**
+ * @module
+ *
+ * Trace options.
+ */
+
+import type { Format } from './format.ts';
+import type { PLTypeName } from './type.ts';
+
+/**
+ * Trace of one decode or encode, plain numbers for exporting as metrics.
+ */
+export interface Trace {
+	/**
+	 * Encoded format.
+	 */
+	format: Format;
+
+	/**
+	 * Encoded size, input when decoding, output when encoding.
+	 */
+	bytes: number;
+
+	/**
+	 * Milliseconds spent in each phase, in order.
+	 * Binary decoding has trailer and objects phases.
+	 * XML and OpenStep decoding have decode and parse phases.
+	 * Encoding has size and write phases.
+	 * Async phases include time yielded to the event loop.
+	 */
+	phases: { [phase: string]: number };
+
+	/**
+	 * Number of objects of each type, counting keys, shared objects once.
+	 */
+	objects: { [T in PLTypeName]: number };
+
+	/**
+	 * Number of references to objects already counted.
+	 * Binary encoding shares these in the offset table, unless duplicated.
+	 */
+	shared: number;
+
+	/**
+	 * Maximum depth of nested collections.
+	 */
+	depth: number;
+
+	/**
+	 * Total UTF-8 bytes of strings, shared strings once.
+	 */
+	strings: number;
+
+	/**
+	 * Total bytes of data, shared data once.
+	 */
+	data: number;
+}
+
+/**
+ * Trace options, for instrumenting decoding and encoding.
+ * Nothing is measured unless a trace callback is set.
+ */
+export interface TraceOptions {
+	/**
+	 * Optional callback, called with the trace once done.
+	 * Not called when validating, or when failing.
+	 */
+	trace?: (trace: Trace) => void;
+}
@@ -0,0 +1,27 @@
+import { decode } from './decode/mod.ts';
+import { encode } from './encode/mod.ts';
+import { FORMAT_BINARY_V1_0, FORMAT_XML_V1_0 } from './format.ts';
+import { benchPlists } from './spec/bench.ts';
+import { transcode } from './transcode.ts';
+
+const to = FORMAT_XML_V1_0;
+
+for (const [name, plist] of benchPlists()) {
+	const encoded = encode(plist, { format: FORMAT_BINARY_V1_0 });
+
+	Deno.bench(
+		`decode and encode: binary to XML: ${name}`,
+		{ group: `transcode: ${name}`, baseline: true },
+		() => {
+			encode(decode(encoded).plist, { format: to });
+		},
+	);
+
+	Deno.bench(
+		`transcode: binary to XML: ${name}`,
+		{ group: `transcode: ${name}` },
+		() => {
+			transcode(encoded, { to });
+		},
+	);
+}
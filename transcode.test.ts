@@ -0,0 +1,267 @@
+import { assertEquals, assertThrows } from '@std/assert';
+import { PLArray } from './array.ts';
+import { PLBoolean } from './boolean.ts';
+import { PLData } from './data.ts';
+import { PLDate } from './date.ts';
+import { decode, type DecodeOptions } from './decode/mod.ts';
+import { PLDictionary } from './dictionary.ts';
+import { encode } from './encode/mod.ts';
+import {
+	type Format,
+	FORMAT_BINARY_V1_0,
+	FORMAT_OPENSTEP,
+	FORMAT_XML_V0_9,
+	FORMAT_XML_V1_0,
+} from './format.ts';
+import { PLInteger } from './integer.ts';
+import { PLNull } from './null.ts';
+import { PLReal } from './real.ts';
+import { PLSet } from './set.ts';
+import { PLString } from './string.ts';
+import {
+	transcode,
+	transcodeAsync,
+	type TranscodeOptions,
+} from './transcode.ts';
+import type { PLType } from './type.ts';
+import { PLUID } from './uid.ts';
+
+const FORMATS: Format[] = [
+	FORMAT_BINARY_V1_0,
+	FORMAT_XML_V1_0,
+	FORMAT_OPENSTEP,
+];
+
+function tree(): PLType {
+	return new PLArray(
+		Array.from({ length: 100 }, (_, i) =>
+			new PLDictionary<PLType, PLType>([
+				[new PLString('name'), new PLString(`item <${i}>`)],
+				[
+					new PLString('data'),
+					new PLData(new Uint8Array(i).fill(i).buffer),
+				],
+			])),
+	);
+}
+
+Deno.test('transcode', () => {
+	const plist = tree();
+	for (const from of FORMATS) {
+		const encoded = encode(plist, { format: from });
+		for (const to of FORMATS) {
+			const r = transcode(encoded, { to });
+			assertEquals(r.from, from);
+			assertEquals(
+				r.encoded,
+				encode(decode(encoded).plist, { format: to }),
+				`${from} -> ${to}`,
+			);
+		}
+	}
+});
+
+Deno.test('transcode: options', () => {
+	const encoded = encode(tree(), { format: FORMAT_BINARY_V1_0 });
+	assertEquals(
+		transcode(encoded, {
+			to: FORMAT_XML_V0_9,
+			encode: { indent: '  ' },
+		}).encoded,
+		encode(decode(encoded).plist, {
+			format: FORMAT_XML_V0_9,
+			indent: '  ',
+		}),
+	);
+	assertThrows(
+		() =>
+			transcode(encoded, {
+				to: FORMAT_XML_V1_0,
+				decode: { maxDepth: 1 },
+			}),
+		RangeError,
+		'Exceeded maxDepth',
+	);
+	assertThrows(
+		() => transcode(encoded, { to: 'x' as Format }),
+		RangeError,
+		'Invalid format',
+	);
+});
+
+Deno.test('transcode: data passed through', () => {
+	const encoded = new TextEncoder().encode(
+		'<plist><data>AAEC\nAw==</data></plist>',
+	);
+	assertEquals(
+		new TextDecoder().decode(
+			transcode(encoded, { to: FORMAT_XML_V1_0 }).encoded,
+		).split('\n').slice(3, 6),
+		['<data>', 'AAECAw==', '</data>'],
+	);
+});
+
+function mixed(): PLType {
+	const shared = new PLDictionary<PLType, PLType>([
+		[new PLString('a & <b>'), new PLString('\u00e9\u00ff')],
+		[new PLString('\ud83d\ude00 > \u4e2d'), new PLUID(123)],
+	]);
+	return new PLDictionary<PLType, PLType>([
+		[new PLString('shared'), shared],
+		[new PLString('again'), new PLArray([shared, shared, new PLArray()])],
+		[new PLString('empty'), new PLDictionary()],
+		[new PLString('true'), new PLBoolean(true)],
+		[new PLString('false'), new PLBoolean(false)],
+		[
+			new PLString('integers'),
+			new PLArray([
+				new PLInteger(0),
+				new PLInteger(255),
+				new PLInteger(-1),
+				new PLInteger(0x7fffffffffffffffn),
+				new PLInteger(-0x80000000000000000000000000000000n, 128),
+				new PLInteger(0xffffffffffffffffn, 128),
+			]),
+		],
+		[
+			new PLString('reals'),
+			new PLArray([
+				new PLReal(0.1, 32),
+				new PLReal(-0),
+				new PLReal(1e300),
+				new PLReal(NaN),
+				new PLReal(-Infinity),
+			]),
+		],
+		[
+			new PLString('dates'),
+			new PLArray([new PLDate(0), new PLDate(-1e12), new PLDate(1e12)]),
+		],
+		[
+			new PLString('data'),
+			new PLArray(
+				[0, 1, 2, 3, 56, 57, 58, 59, 200].map((n) =>
+					new PLData(new Uint8Array(n).map((_, i) => i * 7).buffer)
+				),
+			),
+		],
+	]);
+}
+
+Deno.test('transcode: binary to XML', () => {
+	const encoded = encode(mixed(), { format: FORMAT_BINARY_V1_0 });
+	for (
+		const options of [
+			{ to: FORMAT_XML_V1_0 },
+			{ to: FORMAT_XML_V0_9 },
+			{ to: FORMAT_XML_V1_0, encode: { indent: '' } },
+			{
+				to: FORMAT_XML_V1_0,
+				encode: { indent: ' \t', unsignZero: true, min128Zero: true },
+			},
+			{ to: FORMAT_XML_V1_0, decode: { binary: { int64: true } } },
+		] as TranscodeOptions[]
+	) {
+		const r = transcode(encoded, options);
+		assertEquals(r.from, FORMAT_BINARY_V1_0);
+		assertEquals(
+			r.encoded,
+			encode(decode(encoded, options.decode).plist, {
+				...options.encode,
+				format: options.to,
+			} as never),
+		);
+	}
+});
+
+Deno.test('transcode: binary to XML fallback', () => {
+	const same = (encoded: Uint8Array, decode?: DecodeOptions): void => {
+		let expected;
+		try {
+			expected = transcode(encoded, {
+				to: FORMAT_XML_V1_0,
+				decode: { ...decode, trace: () => {} },
+			});
+		} catch (e) {
+			expected = `${e}`;
+		}
+		let actual;
+		try {
+			actual = transcode(encoded, { to: FORMAT_XML_V1_0, decode });
+		} catch (e) {
+			actual = `${e}`;
+		}
+		assertEquals(actual, expected);
+	};
+	for (
+		const plist of [
+			new PLArray([new PLNull()]),
+			new PLSet(),
+			new PLDictionary([[new PLInteger(1), new PLString('a')]]),
+		]
+	) {
+		same(encode(plist, { format: FORMAT_BINARY_V1_0 }));
+	}
+	const encoded = encode(mixed(), { format: FORMAT_BINARY_V1_0 });
+	for (
+		const decode of [
+			{ maxDepth: 2 },
+			{ maxObjects: 10 },
+			{ maxBytes: 10 },
+			{ maxLength: 2 },
+			{ maxLength: -1 },
+		]
+	) {
+		same(encoded, decode);
+	}
+
+	// Dictionary with the same key object twice, decoded as one entry.
+	const twice = encode(
+		new PLDictionary([
+			[new PLString('a'), new PLString('1')],
+			[new PLString('b'), new PLString('2')],
+		]),
+		{ format: FORMAT_BINARY_V1_0 },
+	);
+	const view = new DataView(twice.buffer);
+	const o = twice[
+		Number(view.getBigUint64(twice.length - 8)) +
+		Number(view.getBigUint64(twice.length - 16))
+	];
+	twice[o + 2] = twice[o + 1];
+	assertEquals((decode(twice).plist as PLDictionary).size, 1);
+	same(twice);
+
+	let seed = 1;
+	const rand = (n: number) => {
+		seed = seed * 1103515245 + 12345 & 0x7fffffff;
+		return seed % n;
+	};
+	for (let n = 0; n < 2000; n++) {
+		const d = encoded.slice();
+		for (let m = 1 + rand(3); m--;) {
+			d[8 + rand(d.length - 8)] = rand(256);
+		}
+		same(d);
+	}
+});
+
+Deno.test('transcodeAsync', async () => {
+	const plist = tree();
+	for (const from of FORMATS) {
+		const encoded = encode(plist, { format: from });
+		for (const to of FORMATS) {
+			let calls = 0;
+			// deno-lint-ignore no-await-in-loop
+			const r = await transcodeAsync(encoded, {
+				to,
+				step: 16,
+				progress() {
+					calls++;
+				},
+			});
+			assertEquals(r, transcode(encoded, { to }), `${from} -> ${to}`);
+			assertEquals(calls > 0, true);
+		}
+	}
+});
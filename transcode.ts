@@ -0,0 +1,554 @@
+/**
+ * @module
+ *
+ * Property list transcoding.
+ */
+
+import type { AsyncOptions } from './async.ts';
+import { PLDate } from './date.ts';
+import type { DecodeBinaryOptions } from './decode/binary.ts';
+import { decode, decodeAsync, type DecodeOptions } from './decode/mod.ts';
+import type { EncodeBinaryOptions } from './encode/binary.ts';
+import { encode, encodeAsync, type EncodeOptions } from './encode/mod.ts';
+import type { EncodeOpenStepOptions } from './encode/openstep.ts';
+import type { EncodeXmlOptions } from './encode/xml.ts';
+import {
+	type Format,
+	FORMAT_BINARY_V1_0,
+	FORMAT_XML_V0_9,
+	FORMAT_XML_V1_0,
+} from './format.ts';
+import { sliced, sync } from './pri/async.ts';
+import { getN, getU } from './pri/binary.ts';
+import { budget, budgets } from './pri/budget.ts';
+import { bytes } from './pri/data.ts';
+import { utf8Encode } from './pri/utf8.ts';
+import {
+	dataLines,
+	dataSize,
+	date,
+	escape,
+	head,
+	integer,
+	real,
+} from './pri/xml.ts';
+
+const U32_MAX = 0xffffffff;
+const I64_MAX = 0x7fffffffffffffffn;
+const U64_MAX = 0xffffffffffffffffn;
+const U128_MAX = 0xffffffffffffffffffffffffffffffffn;
+
+/**
+ * Transcoding options.
+ */
+export interface TranscodeOptions {
+	/**
+	 * Format to encode.
+	 */
+	to: Format;
+
+	/**
+	 * Decoding options, XML data is lazy unless set.
+	 */
+	decode?: DecodeOptions;
+
+	/**
+	 * Encoding options, other than format.
+	 */
+	encode?: Omit<
+		EncodeBinaryOptions & EncodeXmlOptions & EncodeOpenStepOptions,
+		'format'
+	>;
+}
+
+/**
+ * Transcode result.
+ */
+export interface TranscodeResult {
+	/**
+	 * Decoded format.
+	 */
+	from: Format;
+
+	/**
+	 * Encoded plist.
+	 */
+	encoded: Uint8Array<ArrayBuffer>;
+}
+
+/**
+ * Decoding options for transcoding.
+ *
+ * @param options Decoding options.
+ * @returns Decoding options, with lazy XML data unless set.
+ */
+function decoding(options: Readonly<DecodeOptions>): DecodeOptions {
+	// Untouched canonical XML data is passed through by the XML encoder.
+	return {
+		...options,
+		xml: { ...options.xml, lazy: options.xml?.lazy ?? true },
+	};
+}
+
+/**
+ * Arguments to transcode binary to XML directly, if possible.
+ *
+ * @param encoded Encoded plist.
+ * @param options Transcoding options.
+ * @returns Bytes, binary decoding, and XML encoding options, or null.
+ */
+function direct(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	{ to, decode = {}, encode = {} }: Readonly<TranscodeOptions>,
+): [Uint8Array, DecodeBinaryOptions, EncodeXmlOptions] | null {
+	const d = bytes(encoded);
+	const binary = { ...budgets(decode), ...decode.binary };
+	return (to === FORMAT_XML_V1_0 || to === FORMAT_XML_V0_9) &&
+			d.length >= 8 &&
+			d[0] === 98 &&
+			d[1] === 112 &&
+			d[2] === 108 &&
+			d[3] === 105 &&
+			d[4] === 115 &&
+			d[5] === 116 &&
+			d[6] === 48 &&
+			!decode.trace &&
+			!binary.trace &&
+			binary.query === undefined &&
+			!encode.trace
+		? [d, binary, { ...encode, format: to }]
+		: null;
+}
+
+/**
+ * Transcode binary to XML, writing XML while reading binary objects,
+ * with only a map of objects seen and the collections being written.
+ * Anything decoding or encoding would reject, or that decoding would
+ * change, like a key object used twice, returns null to fall back.
+ *
+ * @param d Binary plist.
+ * @param options Binary decoding options.
+ * @param xml XML encoding options.
+ * @param step Objects between yields, 0 for none.
+ * @yields Objects processed.
+ * @returns Encoded plist, or null.
+ */
+function* binaryXml(
+	d: Uint8Array,
+	options: Readonly<DecodeBinaryOptions>,
+	{
+		format = FORMAT_XML_V1_0,
+		indent = '\t',
+		unsignZero = false,
+		min128Zero = false,
+	}: Readonly<EncodeXmlOptions>,
+	step: number,
+): Generator<number, Uint8Array<ArrayBuffer> | null, void> {
+	let maxDepth, maxObjects, maxBytes, maxLength;
+	try {
+		[maxDepth, maxObjects, maxBytes, maxLength] = budget(options);
+	} catch {
+		return null;
+	}
+	const int64 = options.int64 ?? false;
+	const l = d.length;
+	if (l < 40) {
+		return null;
+	}
+	const v = new DataView(d.buffer, d.byteOffset, d.byteLength);
+	const intc = d[l - 26];
+	const refc = d[l - 25];
+	let objects: bigint | number = v.getBigUint64(l - 24);
+	let table: bigint | number = v.getBigUint64(l - 8);
+	let ref: bigint | number = v.getBigUint64(l - 16);
+	let x: bigint | number = objects * BigInt(intc);
+	if (
+		!objects ||
+		objects > I64_MAX ||
+		ref >= objects ||
+		table < 9 ||
+		table > l - 32 ||
+		!intc ||
+		!refc ||
+		x > U64_MAX ||
+		Number(table + x) + 32 !== l ||
+		(refc < 8 && (1n << BigInt(refc * 8)) <= objects) ||
+		(intc < 8 && (1n << BigInt(intc * 8)) <= table)
+	) {
+		return null;
+	}
+	table = Number(table);
+	objects = Number(objects);
+	ref = Number(ref);
+	for (let n = objects, o = table; n--; o += intc) {
+		if (getN(d, o, intc) >= table) {
+			return null;
+		}
+	}
+
+	for (x = 0; x < indent.length; x++) {
+		if (indent[x] !== '\t' && indent[x] !== ' ') {
+			return null;
+		}
+	}
+	const inl = indent.length;
+	const ind = new Uint8Array(inl);
+	for (x = inl; x--;) {
+		ind[x] = indent.charCodeAt(x);
+	}
+	const h = head(format);
+	let r = new Uint8Array(Math.max(l * 4, h.length + 9));
+	let i = utf8Encode(h, r, 0);
+
+	// Stack of collections, types, references offsets, sizes, and indexes.
+	const os: number[] = [];
+	const ts: number[] = [];
+	const is: number[] = [];
+	const cs: number[] = [];
+	const js: number[] = [];
+	const ancestors = new Set<number>();
+	const seen = new Set<number>();
+	let depth = 0;
+	let size = 0;
+	let key = false;
+	let y = step || -1;
+	let n = 0;
+	let o;
+	let m;
+	let p;
+	let c;
+	let t;
+	let s;
+
+	// Grow output for k more bytes after indenting, then indent.
+	const line = (k: number): void => {
+		if ((k += i + depth * inl) > r.length) {
+			const b = new Uint8Array(Math.max(k, r.length * 2));
+			b.set(r.subarray(0, i));
+			r = b;
+		}
+		for (let x = depth; x--; i += inl) {
+			r.set(ind, i);
+		}
+	};
+
+	for (;;) {
+		if (++n === y) {
+			y += step;
+			yield n;
+		}
+		o = getN(d, table + ref * intc, intc);
+		if (ref >= objects || o < 8 || o >= table || ancestors.has(o)) {
+			return null;
+		}
+		if (!seen.has(o)) {
+			if (seen.size >= maxObjects) {
+				return null;
+			}
+			seen.add(o);
+			t = true;
+		} else {
+			t = false;
+		}
+		m = d[o];
+		p = o + 1;
+		c = m & 15;
+		switch (key ? m >> 4 === 5 || m >> 4 === 6 ? m >> 4 : -1 : m >> 4) {
+			case 0: {
+				if (m !== 8 && m !== 9) {
+					return null;
+				}
+				line(9);
+				i = utf8Encode(m === 9 ? '<true/>' : '<false/>', r, i);
+				break;
+			}
+			case 1: {
+				if (p + (c = 1 << c) > table) {
+					return null;
+				}
+				s = integer(
+					c < 8 ? getN(d, p, c) : BigInt.asIntN(
+						c > 8 ? 128 : 64,
+						getU(d, p, c, int64 ? U64_MAX : U128_MAX),
+					),
+					min128Zero,
+				);
+				line(20 + s.length);
+				i = utf8Encode('<integer>', r, i);
+				i = utf8Encode(s, r, i);
+				i = utf8Encode('</integer>', r, i);
+				break;
+			}
+			case 2: {
+				if (c !== 2 && c !== 3 || p + (c = c === 2 ? 4 : 8) > table) {
+					return null;
+				}
+				s = real(
+					c === 4 ? v.getFloat32(p) : v.getFloat64(p),
+					unsignZero,
+				);
+				line(14 + s.length);
+				i = utf8Encode('<real>', r, i);
+				i = utf8Encode(s, r, i);
+				i = utf8Encode('</real>', r, i);
+				break;
+			}
+			case 3: {
+				if (m !== 51 || p + 8 > table) {
+					return null;
+				}
+				s = date(new PLDate(v.getFloat64(p)));
+				line(14 + s.length);
+				i = utf8Encode('<date>', r, i);
+				i = utf8Encode(s, r, i);
+				i = utf8Encode('</date>', r, i);
+				break;
+			}
+			case 4:
+			case 5:
+			case 6:
+			case 10:
+			case 13: {
+				if (c === 15) {
+					if (
+						p >= table ||
+						((x = d[p++]) & 240) !== 16 ||
+						p + (x = 1 << (x & 15)) > table
+					) {
+						return null;
+					}
+					c = getN(d, p, x);
+					p += x;
+				}
+				switch (m >> 4) {
+					case 4: {
+						if (p + c > table || (t && (size += c) > maxBytes)) {
+							return null;
+						}
+						line(dataSize(c, inl, depth) + 1);
+						i = utf8Encode('<data>', r, i);
+						r[i++] = 10;
+						i = dataLines(d.subarray(p, p + c), r, i, ind, depth);
+						for (x = depth; x--; i += inl) {
+							r.set(ind, i);
+						}
+						i = utf8Encode('</data>', r, i);
+						break;
+					}
+					case 5: {
+						if (p + c > table || (t && (size += c) > maxBytes)) {
+							return null;
+						}
+						line(18 + c * 5);
+						i = utf8Encode(key ? '<key>' : '<string>', r, i);
+						for (c += p; p < c;) {
+							switch (x = d[p++]) {
+								case 38: {
+									i = utf8Encode('&amp;', r, i);
+									break;
+								}
+								case 60: {
+									i = utf8Encode('&lt;', r, i);
+									break;
+								}
+								case 62: {
+									i = utf8Encode('&gt;', r, i);
+									break;
+								}
+								default: {
+									if (x < 128) {
+										r[i++] = x;
+									} else {
+										r[i++] = 192 | x >> 6;
+										r[i++] = 128 | x & 63;
+									}
+								}
+							}
+						}
+						i = utf8Encode(key ? '</key>' : '</string>', r, i);
+						break;
+					}
+					case 6: {
+						if (
+							p + c * 2 > table ||
+							(t && (size += c * 2) > maxBytes)
+						) {
+							return null;
+						}
+						for (s = ''; c--; p += 2) {
+							s += String.fromCharCode(v.getUint16(p));
+						}
+						s = escape(s);
+						line(18 + s.length * 3);
+						i = utf8Encode(key ? '<key>' : '<string>', r, i);
+						i = utf8Encode(s, r, i);
+						i = utf8Encode(key ? '</key>' : '</string>', r, i);
+						break;
+					}
+					default: {
+						t = m >> 4;
+						if (
+							p + c * (t === 13 ? 2 : 1) * refc > table ||
+							c > maxLength ||
+							ancestors.size >= maxDepth
+						) {
+							return null;
+						}
+						if (t === 13 && c > 1) {
+							// Same key objects decode as one entry.
+							s = new Set<number>();
+							for (x = 0; x < c; x++) {
+								m = getN(d, p + x * refc, refc);
+								if (m >= objects) {
+									return null;
+								}
+								s.add(getN(d, table + m * intc, intc));
+							}
+							if (s.size < c) {
+								return null;
+							}
+						}
+						line(9);
+						if (!c) {
+							i = utf8Encode(
+								t === 13 ? '<dict/>' : '<array/>',
+								r,
+								i,
+							);
+							break;
+						}
+						i = utf8Encode(t === 13 ? '<dict>' : '<array>', r, i);
+						r[i++] = 10;
+						ancestors.add(os[depth] = o);
+						ts[depth] = t;
+						is[depth] = p;
+						cs[depth] = t === 13 ? c + c : c;
+						js[depth++] = 0;
+						o = -1;
+					}
+				}
+				break;
+			}
+			case 8: {
+				if (p + ++c > table || (x = getU(d, p, c)) > U32_MAX) {
+					return null;
+				}
+				s = x.toString();
+				line(53 + s.length + inl * (depth + depth + 2));
+				i = utf8Encode('<dict>', r, i);
+				r[i++] = 10;
+				for (c = depth + 1; c--; i += inl) {
+					r.set(ind, i);
+				}
+				i = utf8Encode('<key>CF$UID</key>', r, i);
+				r[i++] = 10;
+				for (c = depth + 1; c--; i += inl) {
+					r.set(ind, i);
+				}
+				i = utf8Encode('<integer>', r, i);
+				i = utf8Encode(s, r, i);
+				i = utf8Encode('</integer>', r, i);
+				r[i++] = 10;
+				for (c = depth; c--; i += inl) {
+					r.set(ind, i);
+				}
+				i = utf8Encode('</dict>', r, i);
+				break;
+			}
+			default: {
+				// Null, sets, non-string keys, and invalid markers.
+				return null;
+			}
+		}
+		if (o >= 0) {
+			r[i++] = 10;
+		}
+
+		// Next reference, closing finished collections.
+		for (;;) {
+			if (!depth) {
+				line(9);
+				r[utf8Encode('</plist>', r, i)] = 10;
+				return r.subarray(0, i + 9);
+			}
+			if ((x = js[c = depth - 1]++) < cs[c]) {
+				if (ts[c] === 13) {
+					key = !(x & 1);
+					x = (x >> 1) + (key ? 0 : cs[c] >> 1);
+				} else {
+					key = false;
+				}
+				ref = getN(d, is[c] + x * refc, refc);
+				break;
+			}
+			ancestors.delete(os[--depth]);
+			line(9);
+			i = utf8Encode(ts[c] === 13 ? '</dict>' : '</array>', r, i);
+			r[i++] = 10;
+		}
+	}
+}
+
+/**
+ * Transcode plist from any format to another.
+ * Binary to XML is written while reading, without decoding a plist,
+ * unless tracing, querying, or the plist needs decoding to match.
+ * Other formats hold the decoded plist only until encoded, without decoding
+ * data that can be passed through.
+ *
+ * @param encoded Encoded plist.
+ * @param options Transcoding options.
+ * @returns Decoded format and encoded plist.
+ */
+export function transcode(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	options: Readonly<TranscodeOptions>,
+): TranscodeResult {
+	const b = direct(encoded, options);
+	const r = b && sync(binaryXml(...b, 0));
+	if (r) {
+		return { from: FORMAT_BINARY_V1_0, encoded: r };
+	}
+	const { format, plist } = decode(encoded, decoding(options.decode ?? {}));
+	return {
+		from: format,
+		encoded: encode(plist, {
+			...options.encode,
+			format: options.to,
+		} as EncodeOptions),
+	};
+}
+
+/**
+ * Transcode plist from any format to another, without blocking the event loop.
+ * Progress is reported for decoding, then encoding, or for binary to XML,
+ * objects written, starting over to decode if falling back.
+ *
+ * @param encoded Encoded plist.
+ * @param options Transcoding and async options.
+ * @returns Decoded format and encoded plist.
+ */
+export async function transcodeAsync(
+	encoded: ArrayBufferView | ArrayBufferLike,
+	options: Readonly<TranscodeOptions & AsyncOptions>,
+): Promise<TranscodeResult> {
+	const { signal, progress, step, slice } = options;
+	const a = { signal, progress, step, slice };
+	const b = direct(encoded, options);
+	const r = b && await sliced((step) => binaryXml(...b, step), a);
+	if (r) {
+		return { from: FORMAT_BINARY_V1_0, encoded: r };
+	}
+	const { format, plist } = await decodeAsync(encoded, {
+		...decoding(options.decode ?? {}),
+		...a,
+	});
+	return {
+		from: format,
+		encoded: await encodeAsync(plist, {
+			...options.encode,
+			...a,
+			format: options.to,
+		} as EncodeOptions & AsyncOptions),
+	};
+}
@@ -4,6 +4,7 @@
  * Property list UID.
  */
 
+import { mutable } from './pri/mutate.ts';
 import type { PLType } from './type.ts';
 
 const values = new WeakMap<PLUID, bigint>();
@@ -48,6 +49,7 @@ export class PLUID {
 	 * @param value UID value.
 	 */
 	public set value(value: bigint) {
+		mutable(this);
 		values.set(this, BigInt.asUintN(32, BigInt(value)));
 	}
 
@@ -0,0 +1,56 @@
+import { PLArray } from './array.ts';
+import { PLDictionary } from './dictionary.ts';
+import { PLInteger } from './integer.ts';
+import { PLSet } from './set.ts';
+import { PLString } from './string.ts';
+import type { PLType } from './type.ts';
+import { walk } from './walk.ts';
+
+const visit = { default(): void {} };
+
+let deep: PLType = new PLInteger();
+for (let i = 0; i < 10000; i++) {
+	deep = new PLArray([
+		deep,
+		new PLDictionary([[new PLString('key'), new PLInteger(i)]]),
+	]);
+}
+
+const wideDict = new PLDictionary();
+for (let i = 0; i < 100000; i++) {
+	wideDict.set(new PLString(`key-${i}`), new PLInteger(i));
+}
+
+const wideArray = new PLArray();
+for (let i = 0; i < 100000; i++) {
+	wideArray.push(new PLArray([new PLString(`${i}`), new PLInteger(i)]));
+}
+
+const wideSet = new PLSet();
+for (let i = 0; i < 100000; i++) {
+	wideSet.add(new PLInteger(i));
+}
+
+Deno.bench('walk: deep', { group: 'deep' }, () => {
+	walk(deep, visit, visit);
+});
+
+Deno.bench('walk: deep: max', { group: 'deep' }, () => {
+	walk(deep, visit, visit, { max: 5000 });
+});
+
+Deno.bench('walk: wide: dict', { group: 'wide' }, () => {
+	walk(wideDict, visit, visit);
+});
+
+Deno.bench('walk: wide: dict: keysFirst', { group: 'wide' }, () => {
+	walk(wideDict, visit, visit, { keysFirst: true });
+});
+
+Deno.bench('walk: wide: array', { group: 'wide' }, () => {
+	walk(wideArray, visit, visit);
+});
+
+Deno.bench('walk: wide: set', { group: 'wide' }, () => {
+	walk(wideSet, visit, visit);
+});
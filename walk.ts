@@ -4,104 +4,20 @@
  * Property list walker.
  */
 
-import { type PLArray, PLTYPE_ARRAY } from './array.ts';
+import type { PLArray, PLTYPE_ARRAY } from './array.ts';
 import type { PLBoolean, PLTYPE_BOOLEAN } from './boolean.ts';
 import type { PLData, PLTYPE_DATA } from './data.ts';
 import type { PLDate, PLTYPE_DATE } from './date.ts';
-import { type PLDictionary, PLTYPE_DICTIONARY } from './dictionary.ts';
+import type { PLDictionary, PLTYPE_DICTIONARY } from './dictionary.ts';
 import type { PLInteger, PLTYPE_INTEGER } from './integer.ts';
 import type { PLNull, PLTYPE_NULL } from './null.ts';
 import type { PLReal, PLTYPE_REAL } from './real.ts';
-import { type PLSet, PLTYPE_SET } from './set.ts';
+import { walker } from './pri/walk.ts';
+import type { PLSet, PLTYPE_SET } from './set.ts';
 import type { PLString, PLTYPE_STRING } from './string.ts';
 import type { PLType } from './type.ts';
 import type { PLTYPE_UID, PLUID } from './uid.ts';
 
-const noop = () => {};
-
-/**
- * Iterate root.
- *
- * @param root The root element.
- */
-function* rootValue(root: PLType): Generator<[null, PLType]> {
-	yield [null, root];
-}
-
-/**
- * Iterate dictionary in pairs.
- *
- * @param d Dictionary to iterate.
- */
-function* dictPairs(d: PLDictionary): Generator<[null | PLType, PLType]> {
-	let k, v;
-	for (k of d.keys()) {
-		yield [null, k];
-		if ((v = d.get(k))) {
-			yield [k, v];
-		}
-	}
-}
-
-/**
- * Iterate dictionary keys, then values.
- *
- * @param d Dictionary to iterate.
- */
-function* dictKeysFirst(d: PLDictionary): Generator<[null | PLType, PLType]> {
-	let k, v;
-	const keys = new Set<PLType>();
-	for (k of d.keys()) {
-		yield [null, k];
-		keys.add(k);
-	}
-	for (k of keys) {
-		if ((v = d.get(k))) {
-			yield [k, v];
-		}
-	}
-}
-
-/**
- * Linked list node type.
- */
-interface Node {
-	/**
-	 * Parent of the generator, null for root.
-	 */
-	p: PLArray | PLDictionary | PLSet | null;
-
-	/**
-	 * Key of the generator, null for root.
-	 */
-	k: PLType | number | null;
-
-	/**
-	 * Key value generator.
-	 */
-	g: {
-		/**
-		 * Next key value pair.
-		 */
-		next(): {
-			/**
-			 * Generator done flag.
-			 */
-			done?: boolean;
-
-			/**
-			 * Key value pair.
-			 */
-			value?: [PLType | number | null, PLType];
-		};
-	};
-
-	/**
-	 * Next node.
-	 */
-	n: Node | null;
-}
-
 /**
  * Walk parent.
  */
@@ -254,82 +170,7 @@ export function walk(
 	plist: PLType,
 	visit: Readonly<WalkVisit> = {},
 	leave: Readonly<WalkVisit> = {},
-	{ max = -1, min = 0, keysFirst = false }: Readonly<WalkOptions> = {},
+	options: Readonly<WalkOptions> = {},
 ): void {
-	const vd = visit.default ?? noop;
-	const ld = leave.default ?? noop;
-	const g = rootValue(plist);
-	let next;
-	let depth = 0;
-	let t;
-	let k: PLType | number | null = null;
-	let v: PLType;
-	let p: WalkParent = null;
-	let n: Node | null = {
-		p,
-		k,
-		g,
-		n: p,
-	};
-	let wv: WalkVisitor;
-	do {
-		next = n.g.next();
-		if (next.done) {
-			if (!p) {
-				return;
-			}
-			k = n.k;
-			n = n.n!;
-			if (--depth < min) {
-				p = n.p;
-			} else {
-				wv = (leave[p[Symbol.toStringTag]] ?? ld) as WalkVisitor;
-				if (wv(p, depth, k, p = n.p) === false) {
-					return;
-				}
-			}
-		} else {
-			[k, v] = next.value!;
-			t = v[Symbol.toStringTag];
-			if (!(depth < min)) {
-				wv = (visit[t] ?? vd) as WalkVisitor;
-				next = wv(v, depth, k, p);
-				if (next === false) {
-					return;
-				}
-				if (next === true) {
-					continue;
-				}
-			}
-			switch (t) {
-				case PLTYPE_DICTIONARY: {
-					n = {
-						p: p = v as PLDictionary,
-						k,
-						g: (max < 0 || depth < max)
-							? keysFirst
-								? dictKeysFirst(v as PLDictionary)
-								: dictPairs(v as PLDictionary)
-							: g,
-						n,
-					};
-					depth++;
-					break;
-				}
-				case PLTYPE_ARRAY:
-				case PLTYPE_SET: {
-					n = {
-						p: p = v as PLArray | PLSet,
-						k,
-						g: (max < 0 || depth < max)
-							? (v as PLArray | PLSet).entries()
-							: g,
-						n,
-					};
-					depth++;
-					break;
-				}
-			}
-		}
-	} while (n);
+	walker(plist, visit, leave, options, 0, 0).next();
 }